@@ -0,0 +1,100 @@
+//BFS on a synthetic power-law (R-MAT) graph with 1, 2, 4 and all hardware threads.
+//Usage: bfs_threads [scale] [edge_factor]
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+	//R-MAT edge generator with the Graph500 parameters a = 0.57, b = 0.19, c = 0.19
+	std::pair<size_t, size_t> rmat_edge(std::mt19937_64& rng, size_t scale) {
+		std::uniform_real_distribution<double> coin(0.0, 1.0);
+		size_t from = 0;
+		size_t to = 0;
+		for (size_t bit = 0; bit < scale; ++bit) {
+			double p = coin(rng);
+			from <<= 1;
+			to <<= 1;
+			if (p < 0.57) {
+			}
+			else if (p < 0.76) {
+				to |= 1;
+			}
+			else if (p < 0.95) {
+				from |= 1;
+			}
+			else {
+				from |= 1;
+				to |= 1;
+			}
+		}
+		return { from, to };
+	}
+
+	template <typename GRAPH>
+	double median_ms(const GRAPH& graph, const std::vector<size_t>& sources, const graph_library::BfsOptions& options) {
+		std::vector<double> times;
+		for (size_t source : sources) {
+			auto start = std::chrono::steady_clock::now();
+			auto result = graph_library::bfs(graph, source, options);
+			auto finish = std::chrono::steady_clock::now();
+			times.push_back(std::chrono::duration<double, std::milli>(finish - start).count());
+		}
+		std::sort(times.begin(), times.end());
+		return times[times.size() / 2];
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 18;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t amount_nodes = size_t(1) << scale;
+
+	std::mt19937_64 rng(42);
+	Graph<size_t> graph;
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		graph.addNode(i);
+	}
+	for (size_t i = 0; i < amount_nodes * edge_factor; ++i) {
+		auto [from, to] = rmat_edge(rng, scale);
+		graph.addEdge(from, to, 1);
+	}
+	auto compact = graph.freeze();
+
+	//Sources are taken from the component of the node of highest degree, the giant component of an R-MAT graph
+	size_t hub = 0;
+	for (size_t i = 1; i < amount_nodes; ++i) {
+		if (compact.degree(i) > compact.degree(hub)) {
+			hub = i;
+		}
+	}
+	auto giant = graph_library::bfs(compact, hub);
+	std::vector<size_t> sources;
+	std::uniform_int_distribution<size_t> pick(0, amount_nodes - 1);
+	while (sources.size() < 8) {
+		size_t source = pick(rng);
+		if (giant.distance[source] != graph_library::BFS_UNREACHED) {
+			sources.push_back(source);
+		}
+	}
+
+	std::printf("R-MAT scale %zu, %zu nodes, %zu edges\n", scale, amount_nodes, compact.getAmountEdge());
+	std::printf("%8s %14s %14s %14s %14s\n", "threads", "Graph ms", "Compact ms", "top-down ms", "MTEPS");
+	for (size_t threads : { size_t(1), size_t(2), size_t(4), graph_library::hardware_threads() }) {
+		graph_library::BfsOptions options;
+		options.threads = threads;
+		options.symmetric = true;
+		double graph_ms = median_ms(graph, sources, options);
+		double compact_ms = median_ms(compact, sources, options);
+		options.symmetric = false;
+		double top_down_ms = median_ms(compact, sources, options);
+		std::printf("%8zu %14.2f %14.2f %14.2f %14.1f\n", threads, graph_ms, compact_ms, top_down_ms,
+			compact.getAmountEdge() / (compact_ms * 1e3));
+	}
+	return 0;
+}
@@ -0,0 +1,96 @@
+//Connectivity queries while edges stream into a Graph: the component index against a breadth-first
+//search per query, then the same with a share of the edges removed again, where the index searches
+//from the ends of every removed edge and splits off the smaller side.
+//Usage: component_index [nodes] [edges] [queries_per_1000_edges] [removals_per_1000_edges]
+#include "graph_core/graph.hpp"
+#include "graph_io/generators.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//The query without an index: a search from the first node that stops at the second one
+	bool search_connected(const Graph<std::uint32_t, void>& graph, size_t first, size_t second, std::vector<std::uint32_t>& mark,
+		std::uint32_t stamp, std::vector<size_t>& stack)
+	{
+		stack.assign(1, first);
+		mark[first] = stamp;
+		while (!stack.empty()) {
+			size_t index = stack.back();
+			stack.pop_back();
+			if (index == second) {
+				return true;
+			}
+			for (const auto& edge : graph.outEdges(index)) {
+				if (mark[edge.get_to_index()] != stamp) {
+					mark[edge.get_to_index()] = stamp;
+					stack.push_back(edge.get_to_index());
+				}
+			}
+		}
+		return false;
+	}
+
+	struct Result {
+		double seconds = 0;
+		size_t connected = 0;
+	};
+
+	Result stream(size_t amount_nodes, const std::vector<std::pair<size_t, size_t>>& edges, size_t queries, size_t removals, bool indexed) {
+		Graph<std::uint32_t, void> graph(amount_nodes, 0);
+		if (indexed) {
+			graph.enableComponentIndex();
+		}
+		graph_library::GeneratorRandom random(3);
+		std::vector<std::uint32_t> mark(amount_nodes, 0);
+		std::vector<size_t> stack;
+		std::uint32_t stamp = 0;
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < edges.size(); ++i) {
+			graph.addEdge(edges[i].first, edges[i].second);
+			if (random.below(1000) < removals) {
+				const auto& removed = edges[random.below(i + 1)];
+				graph.removeEdge(graph.getNode(removed.first), graph.getNode(removed.second));
+			}
+			for (size_t query = random.below(1000); query < queries; query += 1000) {
+				size_t first = random.below(amount_nodes);
+				size_t second = random.below(amount_nodes);
+				bool connected = indexed ? graph.connected(first, second) : search_connected(graph, first, second, mark, ++stamp, stack);
+				result.connected += connected ? 1 : 0;
+			}
+		}
+		result.seconds = seconds_since(start);
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t amount_nodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+	size_t amount_edges = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+	size_t queries = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+	size_t removals = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 10;
+
+	graph_library::GeneratorRandom random(1);
+	std::vector<std::pair<size_t, size_t>> edges(amount_edges);
+	for (auto& edge : edges) {
+		edge = { random.below(amount_nodes), random.below(amount_nodes) };
+	}
+	std::printf("%zu nodes, %zu edges, %zu queries and up to %zu removals per 1000 edges\n", amount_nodes, amount_edges, queries, removals);
+	std::printf("%10s %10s %12s %12s\n", "removals", "method", "total ms", "connected");
+	for (size_t removal_rate : { size_t(0), removals }) {
+		for (bool indexed : { true, false }) {
+			Result result = stream(amount_nodes, edges, queries, removal_rate, indexed);
+			std::printf("%10zu %10s %12.1f %12zu\n", removal_rate, indexed ? "index" : "search", result.seconds * 1000, result.connected);
+		}
+	}
+	return 0;
+}
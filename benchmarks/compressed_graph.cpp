@@ -0,0 +1,126 @@
+//Memory and traversal speed of CompressedGraph against the uncompressed representations on one R-MAT graph,
+//weighted and unweighted: bytes per edge of Graph, CompactGraph and CompressedGraph, and the BFS throughput
+//on the two snapshots in millions of traversed edges per second. The gaps get smaller, and the compression
+//better, when the nodes are first renumbered in BFS order (see reordering.hpp), which the last rows show.
+//"stream ms" is the time of CompressedGraphBuilder over the edges sorted by source, which never holds a CompactGraph.
+//Usage: compressed_graph [scale] [edge_factor] [rounds]
+#include "harness.hpp"
+#include "graph_core/graph.hpp"
+#include "graph_core/compressed_graph.hpp"
+#include "graph_core/edge_record.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/reordering.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	template <typename WEIGHT_TYPE>
+	size_t compact_footprint(const CompactGraph<std::uint32_t, WEIGHT_TYPE>& graph) {
+		size_t result = sizeof(graph) + graph.getNodesData().capacity() * sizeof(std::uint32_t) +
+			graph.getOffsets().capacity() * sizeof(std::uint64_t) + graph.getTargets().capacity() * sizeof(std::uint32_t);
+		if constexpr (is_weighted_v<WEIGHT_TYPE>) {
+			result += graph.getWeights().capacity() * sizeof(WEIGHT_TYPE);
+		}
+		return result;
+	}
+
+	//Millions of traversed edges per second of BFS from the given sources, the edges are counted after the clock stops
+	template <typename GRAPH>
+	double bfs_throughput(const GRAPH& graph, const std::vector<size_t>& sources) {
+		size_t edges = 0;
+		double seconds = 0;
+		for (size_t source : sources) {
+			auto start = std::chrono::steady_clock::now();
+			auto result = graph_library::bfs(graph, source);
+			seconds += seconds_since(start);
+			for (size_t index = 0; index < graph.getAmountNodes(); ++index) {
+				if (result.distance[index] != graph_library::BFS_UNREACHED) {
+					edges += graph.degree(index);
+				}
+			}
+			graph_library::benchmark::doNotOptimize(result);
+		}
+		return static_cast<double>(edges) / seconds / 1e6;
+	}
+
+	template <typename WEIGHT_TYPE>
+	void run(const char* name, const CompactGraph<std::uint32_t, WEIGHT_TYPE>& compact, const std::vector<size_t>& sources, bool with_graph) {
+		const double amount_edges = static_cast<double>(compact.getAmountEdge());
+		auto start = std::chrono::steady_clock::now();
+		CompressedGraph<std::uint32_t, WEIGHT_TYPE> compressed(compact);
+		double compress_ms = seconds_since(start) * 1000;
+
+		//The edges of the snapshot come sorted by source already
+		auto edges = collectEdges(compact);
+		start = std::chrono::steady_clock::now();
+		CompressedGraphBuilder<std::uint32_t, WEIGHT_TYPE> builder(compact.getAmountNodes());
+		if constexpr (is_weighted_v<WEIGHT_TYPE>) {
+			builder = CompressedGraphBuilder<std::uint32_t, WEIGHT_TYPE>(compact.getAmountNodes(), 1, 255);
+		}
+		builder.addEdges(edges);
+		auto streamed = builder.build();
+		double stream_ms = seconds_since(start) * 1000;
+		graph_library::benchmark::doNotOptimize(streamed);
+		edges = {};
+
+		double graph_bytes = 0;
+		if (with_graph) {
+			Graph<std::uint32_t, WEIGHT_TYPE> graph(compact);
+			graph_bytes = static_cast<double>(graph.memoryFootprint()) / amount_edges;
+		}
+		double compact_bytes = static_cast<double>(compact_footprint(compact)) / amount_edges;
+		double compressed_bytes = static_cast<double>(compressed.memoryFootprint()) / amount_edges;
+		double compact_mteps = bfs_throughput(compact, sources);
+		double compressed_mteps = bfs_throughput(compressed, sources);
+		std::printf("%-20s %10.1f %10.1f %10.2f %10.2f %12.2f %8.2fx %10.1f %12.1f %8.2f %12u\n", name,
+			compress_ms, stream_ms, graph_bytes, compact_bytes, compressed_bytes, compact_bytes / compressed_bytes,
+			compact_mteps, compressed_mteps, compressed_mteps / compact_mteps, compressed.weightBits());
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t rounds = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+	rounds = rounds == 0 ? 1 : rounds;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	options.min_weight = 1;
+	options.max_weight = 255;
+	auto weighted = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+	//The same edges without their weights
+	CompactGraph<std::uint32_t, void> unweighted(weighted.getNodesData(), weighted.getOffsets(), weighted.getTargets());
+
+	graph_library::GeneratorRandom random(5);
+	std::vector<size_t> sources(rounds);
+	for (auto& source : sources) {
+		source = random.below(weighted.getAmountNodes());
+	}
+
+	std::printf("%zu nodes, %zu edges, %zu searches, weights in [1, 255]\n", weighted.getAmountNodes(), weighted.getAmountEdge(), rounds);
+	std::printf("%-20s %10s %10s %10s %10s %12s %9s %10s %12s %8s %12s\n", "graph", "build ms", "stream ms", "graph B/e", "csr B/e", "compressed B/e",
+		"ratio", "csr MTEPS", "comp. MTEPS", "speed", "weight bits");
+	run("rmat int", weighted, sources, true);
+	run("rmat unweighted", unweighted, sources, true);
+
+	graph_library::ReorderingOptions reordering;
+	reordering.ordering = graph_library::Ordering::BFS;
+	Permutation permutation = graph_library::computeOrder(weighted, reordering);
+	std::vector<size_t> permuted_sources;
+	for (size_t source : sources) {
+		permuted_sources.push_back(permutation.newIndex(source));
+	}
+	run("bfs order int", weighted.permuted(permutation), permuted_sources, false);
+	run("bfs order unweighted", unweighted.permuted(permutation), permuted_sources, false);
+	return 0;
+}
@@ -0,0 +1,182 @@
+//Throughput of ConcurrentGraph against one Graph behind a global mutex and behind a shared_mutex.
+//Readers sum the edge weights of random nodes, writers apply batches of edge changes.
+//The consistency of the versions is checked by tests/concurrent_graph_tests.cpp.
+//Usage: concurrent_graph [readers] [writers] [seconds per approach] [nodes]
+#include "graph_core/graph.hpp"
+#include "graph_core/concurrent_graph.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	//Every batch adds ADDED undirected edges and one edge 1 -> 2, adds and removes again an edge
+	//between 0 and 1 and changes one weight
+	constexpr size_t ADDED = 8;
+	constexpr size_t QUERY_NODES = 16;
+
+	struct Counters {
+		std::atomic<size_t> reads{ 0 };
+		std::atomic<size_t> writes{ 0 };
+	};
+
+	GraphUpdateBatch<int> make_batch(std::mt19937_64& rng, size_t amount_nodes) {
+		std::uniform_int_distribution<size_t> node(2, amount_nodes - 1);
+		GraphUpdateBatch<int> batch;
+		size_t first = 0;
+		size_t second = 0;
+		for (size_t i = 0; i < ADDED; ++i) {
+			first = node(rng);
+			do {
+				second = node(rng);
+			} while (second == first);
+			batch.addEdge(first, second, 1);
+		}
+		batch.addEdgeOriented(1, 2, 1);
+		batch.addEdge(0, 1, 1);
+		batch.removeEdge(0, 1);
+		batch.setEdgeWeight(first, second, static_cast<int>(rng() % 100));
+		return batch;
+	}
+
+	//Reads and writes per second of every approach
+	void report(const char* name, const Counters& counters, double seconds) {
+		std::printf("%16s %14.0f %14.0f\n", name, counters.reads / seconds, counters.writes / seconds);
+	}
+
+	template <typename READ, typename WRITE>
+	void run(const char* name, size_t readers, size_t writers, double seconds, READ read, WRITE write) {
+		Counters counters;
+		std::atomic<bool> stop{ false };
+		std::vector<std::thread> threads;
+		for (size_t r = 0; r < readers; ++r) {
+			threads.emplace_back([&, r] {
+				std::mt19937_64 rng(1000 + r);
+				while (!stop.load(std::memory_order_relaxed)) {
+					read(rng);
+					counters.reads.fetch_add(1, std::memory_order_relaxed);
+				}
+				});
+		}
+		for (size_t w = 0; w < writers; ++w) {
+			threads.emplace_back([&, w] {
+				std::mt19937_64 rng(2000 + w);
+				while (!stop.load(std::memory_order_relaxed)) {
+					write(rng);
+					counters.writes.fetch_add(1, std::memory_order_relaxed);
+				}
+				});
+		}
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		stop = true;
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		report(name, counters, seconds);
+	}
+
+	template <typename GRAPH>
+	long long query(const GRAPH& graph, std::mt19937_64& rng) {
+		std::uniform_int_distribution<size_t> node(0, graph.getAmountNodes() - 1);
+		long long sum = 0;
+		for (size_t i = 0; i < QUERY_NODES; ++i) {
+			for (const auto& edge : graph.outEdges(node(rng))) {
+				sum += edge.get_weight();
+			}
+		}
+		return sum;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t readers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+	size_t writers = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+	double seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 0.5;
+	size_t amount_nodes = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 100000;
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<size_t> node(2, amount_nodes - 1);
+	Graph<int> initial;
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		initial.addNode(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < 4 * amount_nodes; ++i) {
+		initial.addEdge(node(rng), node(rng), 1);
+	}
+
+	std::printf("%zu readers, %zu writers, %zu nodes, %zu edges\n", readers, writers, amount_nodes, initial.getAmountEdge());
+	std::printf("%16s %14s %14s\n", "approach", "reads/s", "batches/s");
+
+	{
+		ConcurrentGraph<int> graph{ CowGraph<int>(initial) };
+		std::atomic<long long> sink{ 0 };
+		run("ConcurrentGraph", readers, writers, seconds,
+			[&](std::mt19937_64& rng) {
+				auto view = graph.read();
+				sink.fetch_add(query(view.graph(), rng), std::memory_order_relaxed);
+			},
+			[&](std::mt19937_64& rng) {
+				graph.apply(make_batch(rng, amount_nodes));
+			});
+		graph.reclaim();
+		std::printf("%16s %14zu\n", "retired left", graph.retiredVersions());
+	}
+
+	//The same batches applied edge by edge to one Graph
+	auto apply_to_graph = [](Graph<int>& graph, const GraphUpdateBatch<int>& batch) {
+		for (const auto& operation : batch.getOperations()) {
+			using Kind = GraphUpdateBatch<int>::Kind;
+			if (operation.kind == Kind::ADD_EDGE) {
+				graph.addEdge(operation.first, operation.second, operation.weight);
+			}
+			else if (operation.kind == Kind::ADD_EDGE_ORIENTED) {
+				graph.addEdgeOriented(operation.first, operation.second, operation.weight);
+			}
+			else if (operation.kind == Kind::REMOVE_EDGE) {
+				graph.removeEdge(graph.getNode(operation.first), graph.getNode(operation.second));
+			}
+			else if (operation.kind == Kind::SET_EDGE_WEIGHT) {
+				graph.setEdgeWeight(graph.getNode(operation.first), graph.getNode(operation.second), operation.weight);
+			}
+		}
+	};
+
+	{
+		Graph<int> graph(initial);
+		std::mutex mutex;
+		std::atomic<long long> sink{ 0 };
+		run("mutex", readers, writers, seconds,
+			[&](std::mt19937_64& rng) {
+				std::lock_guard<std::mutex> lock(mutex);
+				sink.fetch_add(query(graph, rng), std::memory_order_relaxed);
+			},
+			[&](std::mt19937_64& rng) {
+				auto batch = make_batch(rng, amount_nodes);
+				std::lock_guard<std::mutex> lock(mutex);
+				apply_to_graph(graph, batch);
+			});
+	}
+
+	{
+		Graph<int> graph(initial);
+		std::shared_mutex mutex;
+		std::atomic<long long> sink{ 0 };
+		run("shared_mutex", readers, writers, seconds,
+			[&](std::mt19937_64& rng) {
+				std::shared_lock<std::shared_mutex> lock(mutex);
+				sink.fetch_add(query(graph, rng), std::memory_order_relaxed);
+			},
+			[&](std::mt19937_64& rng) {
+				auto batch = make_batch(rng, amount_nodes);
+				std::unique_lock<std::shared_mutex> lock(mutex);
+				apply_to_graph(graph, batch);
+			});
+	}
+	return 0;
+}
@@ -0,0 +1,91 @@
+//Construction and teardown of a large graph with the default allocator, an ArenaResource and a
+//FixedPoolResource for the nodes, with the resident memory after construction.
+//Usage: graph_allocation [nodes] [edges_per_node]
+#include "graph_core/graph.hpp"
+#include "graph_core/memory_resources.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//Resident set size in MB, 0 where /proc is not available
+	double resident_mb() {
+		std::ifstream statm("/proc/self/statm");
+		size_t pages = 0;
+		size_t resident = 0;
+		if (!(statm >> pages >> resident)) {
+			return 0;
+		}
+		return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1 << 20);
+	}
+
+	template <typename GRAPH>
+	void fill(GRAPH& graph, size_t amount_nodes, size_t edges_per_node) {
+		std::mt19937_64 rng(42);
+		std::uniform_int_distribution<size_t> node(0, amount_nodes - 1);
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			graph.addNode(static_cast<int>(i));
+		}
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			for (size_t k = 0; k < edges_per_node; ++k) {
+				graph.addEdgeOriented(i, node(rng), 1);
+			}
+		}
+	}
+
+	//make_graph returns the graph on the heap so that teardown can be timed on its own
+	template <typename MAKE_GRAPH>
+	void run(const char* name, MAKE_GRAPH make_graph, size_t amount_nodes, size_t edges_per_node) {
+		double base_mb = resident_mb();
+		auto start = std::chrono::steady_clock::now();
+		auto graph = make_graph();
+		fill(*graph, amount_nodes, edges_per_node);
+		double build_seconds = seconds_since(start);
+		double graph_mb = resident_mb() - base_mb;
+
+		start = std::chrono::steady_clock::now();
+		graph.reset();
+		double teardown_seconds = seconds_since(start);
+		std::printf("%12s %12.2f %12.2f %12.1f\n", name, build_seconds, teardown_seconds, graph_mb);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t amount_nodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+	size_t edges_per_node = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+
+	std::printf("%zu nodes, %zu edges per node\n", amount_nodes, edges_per_node);
+	std::printf("%12s %12s %12s %12s\n", "allocator", "build s", "teardown s", "RSS MB");
+
+	run("default", [] {
+		return std::make_unique<Graph<int>>();
+		}, amount_nodes, edges_per_node);
+
+	{
+		ArenaResource arena(size_t(1) << 20);
+		run("arena", [&arena] {
+			return std::make_unique<PmrGraph<int>>(&arena);
+			}, amount_nodes, edges_per_node);
+		//Teardown above only ran destructors, the memory goes back here in a few calls
+		auto start = std::chrono::steady_clock::now();
+		arena.release();
+		std::printf("%12s %12s %12.2f\n", "", "release", seconds_since(start));
+	}
+
+	{
+		//Nodes come from the pool, node table and edge lists from the upstream heap
+		FixedPoolResource pool(pmr_node_block_size<int>(), 1 << 16);
+		run("node pool", [&pool] {
+			return std::make_unique<PmrGraph<int>>(&pool);
+			}, amount_nodes, edges_per_node);
+	}
+	return 0;
+}
@@ -0,0 +1,293 @@
+//Benchmark suite of the hot paths: Graph operations, copying and every algorithm of graph_algorithms
+//on seeded Erdős–Rényi, R-MAT, grid and Barabási–Albert graphs, so that runs are comparable between machines.
+//Usage: graph_benchmarks [--scale 16] [--seed 1] [--threads 0] [--queries 65536] plus the harness options
+//(--warmup, --repetitions, --filter, --json), see harness.hpp
+#include "harness.hpp"
+#include "graph_core/graph.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/dfs.hpp"
+#include "graph_algorithms/dijkstra.hpp"
+#include "graph_algorithms/kruskal.hpp"
+#include "graph_algorithms/prim.hpp"
+#include "graph_algorithms/triangles.hpp"
+#include "graph_algorithms/common_neighbors.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using graph_library::benchmark::BenchmarkHarness;
+	using graph_library::benchmark::doNotOptimize;
+	using Compact = CompactGraph<std::uint32_t, int>;
+
+	struct NamedGraph {
+		std::string name;
+		Compact graph;
+	};
+
+	//Random pairs of nodes, half of them joined by an edge
+	std::vector<std::pair<size_t, size_t>> make_queries(const Compact& graph, size_t amount, std::uint64_t seed) {
+		graph_library::GeneratorRandom random(seed);
+		std::vector<std::pair<size_t, size_t>> queries;
+		queries.reserve(amount);
+		while (queries.size() < amount) {
+			size_t from = random.below(graph.getAmountNodes());
+			auto neighbors = graph.neighbors(from);
+			if (queries.size() % 2 == 0 && !neighbors.empty()) {
+				queries.emplace_back(from, neighbors[random.below(neighbors.size())]);
+			}
+			else {
+				queries.emplace_back(from, random.below(graph.getAmountNodes()));
+			}
+		}
+		return queries;
+	}
+
+	void graph_operations(BenchmarkHarness& harness, const Compact& source, size_t queries_amount, std::uint64_t seed) {
+		const size_t amount_nodes = source.getAmountNodes();
+		std::vector<EdgeRecord<int>> edges;
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			auto targets = source.neighbors(i);
+			auto weights = source.weights(i);
+			for (size_t k = 0; k < targets.size(); ++k) {
+				if (i < targets[k]) {
+					edges.push_back({ static_cast<std::uint32_t>(i), targets[k], weights[k] });
+				}
+			}
+		}
+		const Graph<std::uint32_t, int> graph(source);
+		auto queries = make_queries(source, queries_amount, seed);
+		std::vector<std::pair<std::shared_ptr<Node<std::uint32_t>>, std::shared_ptr<Node<std::uint32_t>>>> handles;
+		handles.reserve(queries.size());
+		for (const auto& [from, to] : queries) {
+			handles.emplace_back(graph.getNode(from), graph.getNode(to));
+		}
+
+		harness.run("graph/addNode", amount_nodes, [&] {
+			Graph<std::uint32_t, int> result;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				result.addNode(static_cast<std::uint32_t>(i));
+			}
+			doNotOptimize(result);
+			});
+		harness.run("graph/addEdge", edges.size(),
+			[&] {
+				return std::make_unique<Graph<std::uint32_t, int>>(amount_nodes, 0u);
+			},
+			[&](std::unique_ptr<Graph<std::uint32_t, int>>& result) {
+				for (const auto& edge : edges) {
+					result->addEdge(edge.from, edge.to, edge.weight);
+				}
+				doNotOptimize(*result);
+			});
+		harness.run("graph/findEdge", handles.size(), [&] {
+			size_t found = 0;
+			for (const auto& [first, second] : handles) {
+				found += graph.findEdge(first, second, 0, false).size();
+			}
+			doNotOptimize(found);
+			});
+		harness.run("graph/hasEdge", handles.size(), [&] {
+			size_t found = 0;
+			for (const auto& [first, second] : handles) {
+				found += graph.hasEdge(first, second);
+			}
+			doNotOptimize(found);
+			});
+		harness.run("graph/removeEdge", queries.size(),
+			[&] {
+				return std::make_unique<Graph<std::uint32_t, int>>(graph);
+			},
+			[&](std::unique_ptr<Graph<std::uint32_t, int>>& copy) {
+				for (const auto& [from, to] : queries) {
+					copy->removeEdge(copy->getNode(from), copy->getNode(to));
+				}
+				doNotOptimize(*copy);
+			});
+		harness.run("graph/copy", amount_nodes + graph.getAmountEdge(), [&] {
+			Graph<std::uint32_t, int> copy(graph);
+			doNotOptimize(copy);
+			});
+		harness.run("graph/freeze", amount_nodes + graph.getAmountEdge(), [&] {
+			auto frozen = graph.freeze();
+			doNotOptimize(frozen);
+			});
+		harness.run("graph/bfs", amount_nodes + graph.getAmountEdge(), [&] {
+			auto result = graph_library::bfs(graph, 0);
+			doNotOptimize(result);
+			});
+	}
+
+	//Every edge of the graph once, from the smaller to the larger node, an acyclic graph of the same shape
+	Compact make_dag(const Compact& graph, size_t threads) {
+		std::vector<EdgeRecord<int>> edges;
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			auto targets = graph.neighbors(i);
+			auto weights = graph.weights(i);
+			for (size_t k = 0; k < targets.size(); ++k) {
+				if (i < targets[k]) {
+					edges.push_back({ static_cast<std::uint32_t>(i), targets[k], weights[k] });
+				}
+			}
+		}
+		graph_library::GeneratorOptions options;
+		options.symmetric = false;
+		options.threads = threads;
+		return graph_library::buildGeneratedGraph<std::uint32_t, int>(graph.getAmountNodes(), edges, options);
+	}
+
+	//Prim on a nearly complete graph, where the array scan of the dense variant replaces the heap
+	void dense_prim(BenchmarkHarness& harness, const Compact& graph) {
+		const size_t work = graph.getAmountNodes() + graph.getAmountEdge();
+		for (auto [name, mode] : { std::pair{ "dense/prim", graph_library::PrimMode::HEAP }, std::pair{ "dense/prim_dense", graph_library::PrimMode::DENSE } }) {
+			graph_library::PrimOptions options;
+			options.mode = mode;
+			harness.run(name, work, [&] {
+				auto result = graph_library::prim(graph, options);
+				doNotOptimize(result);
+				});
+		}
+	}
+
+	void algorithms(BenchmarkHarness& harness, const NamedGraph& named, size_t threads, size_t queries_amount, std::uint64_t seed) {
+		const Compact& graph = named.graph;
+		const size_t work = graph.getAmountNodes() + graph.getAmountEdge();
+		const std::string prefix = named.name + "/";
+		//The source and target of the searches: node 0 and the node in the middle
+		const size_t target = graph.getAmountNodes() / 2;
+
+		harness.run(prefix + "bfs", work, [&] {
+			auto result = graph_library::bfs(graph, 0);
+			doNotOptimize(result);
+			});
+		if (graph_library::resolve_threads(threads) != 1) {
+			graph_library::BfsOptions options;
+			options.threads = threads;
+			options.symmetric = true;
+			harness.run(prefix + "bfs_parallel", work, [&] {
+				auto result = graph_library::bfs(graph, 0, options);
+				doNotOptimize(result);
+				});
+		}
+		harness.run(prefix + "scc", work, [&] {
+			auto result = graph_library::stronglyConnectedComponents(graph);
+			doNotOptimize(result);
+			});
+		//The symmetric graphs have a cycle at their first edge, the searches for cycles run over the whole acyclic version
+		const Compact dag = make_dag(graph, threads);
+		const size_t dag_work = dag.getAmountNodes() + dag.getAmountEdge();
+		harness.run(prefix + "topological_sort", dag_work, [&] {
+			auto result = graph_library::topologicalSort(dag);
+			doNotOptimize(result);
+			});
+		harness.run(prefix + "has_cycle", dag_work, [&] {
+			bool result = graph_library::hasCycle(dag);
+			doNotOptimize(result);
+			});
+		harness.run(prefix + "find_cycle", dag_work, [&] {
+			auto result = graph_library::findCycle(dag);
+			doNotOptimize(result);
+			});
+
+		graph_library::ShortestPathWorkspace<int> workspace;
+		const std::pair<const char*, graph_library::ShortestPathMethod> methods[] = {
+			{ "dijkstra_binary_heap", graph_library::ShortestPathMethod::BINARY_HEAP },
+			{ "dijkstra_radix_heap", graph_library::ShortestPathMethod::RADIX_HEAP },
+			{ "delta_stepping", graph_library::ShortestPathMethod::DELTA_STEPPING }
+		};
+		for (const auto& [name, method] : methods) {
+			graph_library::ShortestPathOptions options;
+			options.method = method;
+			options.threads = method == graph_library::ShortestPathMethod::DELTA_STEPPING ? threads : 1;
+			harness.run(prefix + name, work, [&] {
+				graph_library::dijkstra(graph, 0, workspace, options);
+				doNotOptimize(workspace);
+				});
+		}
+		graph_library::BidirectionalWorkspace<int> bidirectional;
+		harness.run(prefix + "bidirectional_dijkstra", work, [&] {
+			int distance = graph_library::bidirectionalDijkstra(graph, graph, 0, target, bidirectional);
+			doNotOptimize(distance);
+			});
+
+		graph_library::KruskalOptions kruskal_options;
+		kruskal_options.threads = threads;
+		kruskal_options.symmetric = true;
+		harness.run(prefix + "kruskal", work, [&] {
+			auto result = graph_library::kruskal(graph, kruskal_options);
+			doNotOptimize(result);
+			});
+		graph_library::PrimOptions prim_options;
+		prim_options.mode = graph_library::PrimMode::HEAP;
+		harness.run(prefix + "prim", work, [&] {
+			auto result = graph_library::prim(graph, prim_options);
+			doNotOptimize(result);
+			});
+
+		graph_library::IntersectionOptions intersection_options;
+		intersection_options.threads = threads;
+		const graph_library::NeighbourSets sets(graph, threads);
+		harness.run(prefix + "neighbour_sets", work, [&] {
+			graph_library::NeighbourSets result(graph, threads);
+			doNotOptimize(result);
+			});
+		harness.run(prefix + "count_triangles", work, [&] {
+			auto result = graph_library::countTriangles(sets, intersection_options);
+			doNotOptimize(result);
+			});
+		harness.run(prefix + "clustering_coefficient", work, [&] {
+			auto result = graph_library::localClusteringCoefficient(sets, intersection_options);
+			doNotOptimize(result);
+			});
+		auto pairs = make_queries(graph, queries_amount, seed);
+		harness.run(prefix + "common_neighbors", pairs.size(), [&] {
+			auto result = graph_library::commonNeighbors(sets, pairs, intersection_options);
+			doNotOptimize(result);
+			});
+	}
+}
+
+int main(int argc, char** argv) {
+	BenchmarkHarness harness(argc, argv);
+	const size_t scale = harness.getOption("scale", 16);
+	const std::uint64_t seed = harness.getOption("seed", 1);
+	const size_t threads = harness.getOption("threads", 0);
+	const size_t queries = harness.getOption("queries", size_t(1) << 16);
+	const size_t amount_nodes = size_t(1) << scale;
+	const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(amount_nodes)));
+	harness.addContext("scale", std::to_string(scale));
+	harness.addContext("seed", std::to_string(seed));
+	harness.addContext("threads", std::to_string(graph_library::resolve_threads(threads)));
+
+	graph_library::GeneratorOptions options;
+	options.seed = seed;
+	options.min_weight = 1;
+	options.max_weight = 1000;
+	options.threads = threads;
+	std::vector<NamedGraph> graphs;
+	graphs.push_back({ "erdos_renyi", graph_library::generateErdosRenyi<std::uint32_t, int>(amount_nodes, 8 * amount_nodes, options) });
+	graphs.push_back({ "rmat", graph_library::generateRmat<std::uint32_t, int>(scale, 8, options) });
+	graphs.push_back({ "grid", graph_library::generateGrid<std::uint32_t, int>(side, side, options) });
+	graphs.push_back({ "barabasi_albert", graph_library::generateBarabasiAlbert<std::uint32_t, int>(amount_nodes, 8, options) });
+	//4 * sqrt(nodes) nodes and as many random pairs as nodes squared, about 85% of all pairs
+	const size_t dense_nodes = std::max<size_t>(16, 4 * side);
+	const Compact dense = graph_library::generateErdosRenyi<std::uint32_t, int>(dense_nodes, dense_nodes * dense_nodes, options);
+	for (const auto& named : graphs) {
+		harness.addContext(named.name, std::to_string(named.graph.getAmountNodes()) + " nodes, " +
+			std::to_string(named.graph.getAmountEdge()) + " edges");
+	}
+	harness.addContext("dense", std::to_string(dense.getAmountNodes()) + " nodes, " + std::to_string(dense.getAmountEdge()) + " edges");
+
+	graph_operations(harness, graphs.front().graph, queries, seed);
+	for (const auto& named : graphs) {
+		algorithms(harness, named, threads, queries, seed);
+	}
+	dense_prim(harness, dense);
+	return harness.finish() ? 0 : 1;
+}
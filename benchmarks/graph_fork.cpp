@@ -0,0 +1,58 @@
+//Forking a graph for a what-if change: a deep Graph copy against a CowGraph copy,
+//each followed by a handful of edge edits, with the memory the fork adds.
+//Usage: graph_fork [nodes] [edges_per_node] [edits]
+#include "graph_core/graph.hpp"
+#include "graph_core/cow_graph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t amount_nodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+	size_t edges_per_node = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+	size_t edits = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 16;
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<size_t> node(0, amount_nodes - 1);
+	Graph<int> graph;
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		graph.addNode(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		for (size_t k = 0; k < edges_per_node; ++k) {
+			graph.addEdgeOriented(i, node(rng), 1);
+		}
+	}
+	CowGraph<int> base(graph);
+	std::printf("%zu nodes, %zu edges, %zu edits per fork\n", amount_nodes, graph.getAmountEdge(), edits);
+	std::printf("%12s %12s %14s\n", "copy", "ms", "added MB");
+
+	auto start = std::chrono::steady_clock::now();
+	Graph<int> copy(graph);
+	for (size_t i = 0; i < edits; ++i) {
+		copy.addEdgeOriented(node(rng), node(rng), 2);
+	}
+	double copy_ms = seconds_since(start) * 1000;
+	std::printf("%12s %12.2f %14.1f\n", "Graph", copy_ms, static_cast<double>(copy.memoryFootprint()) / (1 << 20));
+
+	start = std::chrono::steady_clock::now();
+	CowGraph<int> fork = base;
+	for (size_t i = 0; i < edits; ++i) {
+		fork.addEdgeOriented(node(rng), node(rng), 2);
+	}
+	double fork_ms = seconds_since(start) * 1000;
+	//The fork owns the table of blocks and the blocks it copied
+	size_t copied = fork.amountBlocks() - fork.sharedBlocks(base);
+	double fork_mb = static_cast<double>(fork.amountBlocks() * sizeof(void*) * 2 +
+		copied * base.memoryFootprint() / base.amountBlocks()) / (1 << 20);
+	std::printf("%12s %12.2f %14.1f\n", "CowGraph", fork_ms, fork_mb);
+	return 0;
+}
@@ -0,0 +1,72 @@
+//Footprint and traversal times of one R-MAT graph stored with the policies of Graph: weighted and
+//unweighted edges, Mixed, Directed and Undirected. Directed graphs keep one copy of every edge,
+//the others two. Unweighted graphs run dijkstra as a breadth-first search.
+//Usage: graph_policies [scale] [edge_factor]
+#include "graph_core/graph.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/dijkstra.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	template <typename GRAPH>
+	void measure(const char* name, size_t amount_nodes, const std::vector<EdgeRecord<int>>& edges) {
+		auto start = std::chrono::steady_clock::now();
+		GRAPH graph(amount_nodes, 0u);
+		for (const auto& edge : edges) {
+			if constexpr (GRAPH::weighted) {
+				graph.addEdge(edge.from, edge.to, edge.weight);
+			}
+			else {
+				graph.addEdge(edge.from, edge.to);
+			}
+		}
+		double build_ms = seconds_since(start) * 1000;
+
+		start = std::chrono::steady_clock::now();
+		auto reached = graph_library::bfs(graph, 0);
+		double bfs_ms = seconds_since(start) * 1000;
+
+		start = std::chrono::steady_clock::now();
+		auto paths = graph_library::dijkstra(graph, 0);
+		double dijkstra_ms = seconds_since(start) * 1000;
+
+		size_t edge_bytes = 0;
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			edge_bytes += out_degree(graph, i) * sizeof(out_edge_t<GRAPH>);
+		}
+		std::printf("%-24s %10zu %14zu %12zu %10.1f %10.1f %12.1f\n", name, graph.getAmountEdge(), graph.memoryFootprint(), edge_bytes,
+			build_ms, bfs_ms, dijkstra_ms);
+		if (reached.distance.size() != paths.distance.size()) {
+			std::printf("size mismatch\n");
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 18;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+
+	graph_library::GeneratorOptions options;
+	options.max_weight = 100;
+	auto edges = graph_library::rmatEdges<int>(scale, edge_factor, options);
+	size_t amount_nodes = size_t(1) << scale;
+
+	std::printf("%zu nodes, %zu generated edges\n", amount_nodes, edges.size());
+	std::printf("%-24s %10s %14s %12s %10s %10s %12s\n", "graph", "edges", "footprint B", "edge B", "build ms", "bfs ms", "dijkstra ms");
+	measure<Graph<std::uint32_t, int>>("Graph<int>", amount_nodes, edges);
+	measure<Graph<std::uint32_t, void>>("Graph<void>", amount_nodes, edges);
+	measure<UndirectedGraph<std::uint32_t, void>>("UndirectedGraph<void>", amount_nodes, edges);
+	measure<DirectedGraph<std::uint32_t, int>>("DirectedGraph<int>", amount_nodes, edges);
+	measure<DirectedGraph<std::uint32_t, void>>("DirectedGraph<void>", amount_nodes, edges);
+	return 0;
+}
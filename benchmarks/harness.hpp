@@ -0,0 +1,230 @@
+#pragma once
+//Minimal benchmark harness: warmup runs, timed repetitions, percentiles and JSON output.
+//Options on the command line of every benchmark built with it:
+//	--warmup N --repetitions N --filter SUBSTRING --json PATH
+//plus any "--name value" pairs of the benchmark itself, read with getOption
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace graph_library::benchmark {
+
+	//Keeps the compiler from dropping a computation whose result is unused
+	template <typename T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r"(&value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	struct BenchmarkResult {
+		std::string name;
+		//Operations done by one repetition, for the throughput
+		size_t items = 1;
+		std::vector<double> seconds;
+
+		//Nearest-rank percentile of the repetition times
+		double percentile(double percent) const {
+			std::vector<double> sorted = seconds;
+			std::sort(sorted.begin(), sorted.end());
+			size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+			return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+		}
+		double mean() const {
+			double sum = 0;
+			for (double time : seconds) {
+				sum += time;
+			}
+			return sum / static_cast<double>(seconds.size());
+		}
+	};
+
+	class BenchmarkHarness {
+	private:
+		size_t warmup = 1;
+		size_t repetitions = 5;
+		std::string filter;
+		std::string json_path;
+		std::map<std::string, std::string> options;
+		std::vector<std::pair<std::string, std::string>> context;
+		std::vector<BenchmarkResult> results;
+
+		static std::string escape(const std::string& text) {
+			std::string result;
+			for (char symbol : text) {
+				if (symbol == '"' || symbol == '\\') {
+					result += '\\';
+				}
+				result += symbol;
+			}
+			return result;
+		}
+		static void print_row(const BenchmarkResult& result) {
+			double median = result.percentile(50);
+			std::printf("%-40s %6zu %10.3f %10.3f %10.3f %10.3f %14.0f\n", result.name.c_str(), result.seconds.size(),
+				result.percentile(0) * 1e3, median * 1e3, result.percentile(90) * 1e3, result.percentile(99) * 1e3,
+				static_cast<double>(result.items) / median);
+		}
+	public:
+		BenchmarkHarness(int argc, char** argv) {
+			for (int i = 1; i < argc; ++i) {
+				std::string argument = argv[i];
+				if (argument.rfind("--", 0) != 0 || i + 1 >= argc) {
+					std::fprintf(stderr, "Usage: %s [--warmup N] [--repetitions N] [--filter SUBSTRING] [--json PATH] [--option value ...]\n", argv[0]);
+					std::exit(2);
+				}
+				options[argument.substr(2)] = argv[++i];
+			}
+			warmup = getOption("warmup", warmup);
+			repetitions = std::max<size_t>(1, getOption("repetitions", repetitions));
+			filter = getOption("filter", std::string());
+			json_path = getOption("json", std::string());
+			std::printf("%-40s %6s %10s %10s %10s %10s %14s\n", "benchmark", "reps", "min ms", "p50 ms", "p90 ms", "p99 ms", "items/s");
+		}
+
+		size_t getOption(const std::string& name, size_t fallback) const {
+			auto it = options.find(name);
+			return it == options.end() ? fallback : std::strtoull(it->second.c_str(), nullptr, 10);
+		}
+		std::string getOption(const std::string& name, const std::string& fallback) const {
+			auto it = options.find(name);
+			return it == options.end() ? fallback : it->second;
+		}
+		//Written to the JSON output, such as the seed and sizes the results depend on
+		void addContext(const std::string& key, const std::string& value) {
+			context.emplace_back(key, value);
+		}
+		bool selected(const std::string& name) const {
+			return filter.empty() || name.find(filter) != std::string::npos;
+		}
+
+		//setup() runs untimed before every repetition and returns the state that body(state) works on,
+		//so that benchmarks which change their input start from the same state every time
+		template <typename SETUP, typename BODY>
+		void run(const std::string& name, size_t items, SETUP setup, BODY body) {
+			if (!selected(name)) {
+				return;
+			}
+			BenchmarkResult result;
+			result.name = name;
+			result.items = std::max<size_t>(items, 1);
+			for (size_t i = 0; i < warmup + repetitions; ++i) {
+				auto state = setup();
+				auto start = std::chrono::steady_clock::now();
+				body(state);
+				auto finish = std::chrono::steady_clock::now();
+				if (i >= warmup) {
+					result.seconds.push_back(std::chrono::duration<double>(finish - start).count());
+				}
+			}
+			print_row(result);
+			results.push_back(std::move(result));
+		}
+		template <typename BODY>
+		void run(const std::string& name, size_t items, BODY body) {
+			run(name, items, [] { return 0; }, [&body](int) { body(); });
+		}
+
+		const std::vector<BenchmarkResult>& getResults() const {
+			return results;
+		}
+		//Writes the JSON file if --json was given. Returns false if it cannot be written
+		bool finish() const {
+			if (json_path.empty()) {
+				return true;
+			}
+			std::FILE* file = std::fopen(json_path.c_str(), "w");
+			if (file == nullptr) {
+				std::fprintf(stderr, "Cannot write %s\n", json_path.c_str());
+				return false;
+			}
+			std::fprintf(file, "{\n  \"context\": {\n    \"warmup\": %zu,\n    \"repetitions\": %zu", warmup, repetitions);
+			for (const auto& [key, value] : context) {
+				std::fprintf(file, ",\n    \"%s\": \"%s\"", escape(key).c_str(), escape(value).c_str());
+			}
+			std::fprintf(file, "\n  },\n  \"benchmarks\": [");
+			for (size_t i = 0; i < results.size(); ++i) {
+				const BenchmarkResult& result = results[i];
+				std::fprintf(file, "%s\n    {\"name\": \"%s\", \"items\": %zu, \"repetitions\": %zu, "
+					"\"min_ns\": %.0f, \"mean_ns\": %.0f, \"p50_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, \"max_ns\": %.0f, "
+					"\"items_per_second\": %.1f}",
+					i == 0 ? "" : ",", escape(result.name).c_str(), result.items, result.seconds.size(),
+					result.percentile(0) * 1e9, result.mean() * 1e9, result.percentile(50) * 1e9, result.percentile(90) * 1e9,
+					result.percentile(99) * 1e9, result.percentile(100) * 1e9,
+					static_cast<double>(result.items) / result.percentile(50));
+			}
+			std::fprintf(file, "\n  ]\n}\n");
+			return std::fclose(file) == 0;
+		}
+	};
+
+	//Last-level cache misses of this thread between start() and stop(), read from the Linux perf counters.
+	//available() is false on other systems and where perf_event_paranoid or a container forbids the counter
+	class CacheMissCounter {
+	private:
+		int descriptor = -1;
+	public:
+		CacheMissCounter() {
+#if defined(__linux__)
+			perf_event_attr attributes{};
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.size = sizeof(attributes);
+			attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+			attributes.disabled = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+		}
+		CacheMissCounter(const CacheMissCounter&) = delete;
+		CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+		~CacheMissCounter() {
+#if defined(__linux__)
+			if (descriptor >= 0) {
+				close(descriptor);
+			}
+#endif
+		}
+
+		bool available() const {
+			return descriptor >= 0;
+		}
+		void start() {
+#if defined(__linux__)
+			if (descriptor >= 0) {
+				ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+				ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+		//0 if the counter is not available
+		std::uint64_t stop() {
+			std::uint64_t count = 0;
+#if defined(__linux__)
+			if (descriptor >= 0) {
+				ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+				if (read(descriptor, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+					count = 0;
+				}
+			}
+#endif
+			return count;
+		}
+	};
+}
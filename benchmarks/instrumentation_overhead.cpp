@@ -0,0 +1,101 @@
+//Cost of the instrumentation on the hot paths. Built twice from this file: instrumentation_overhead
+//always without instrumentation, even when the CMake option turns it on for the library, and
+//instrumentation_overhead_enabled with GRAPH_LIBRARY_INSTRUMENTATION defined, which also prints the
+//collected statistics. The static_asserts below only show that the disabled hooks hold no state and that
+//the default allocator is std::allocator; what the empty calls cost is measured by comparing the two programs.
+//Usage: instrumentation_overhead [--scale 16] [--seed 1] [--queries 65536] plus the harness options, see harness.hpp
+#ifdef GRAPH_LIBRARY_INSTRUMENTATION_OFF
+#undef GRAPH_LIBRARY_INSTRUMENTATION
+#endif
+#include "harness.hpp"
+#include "graph_core/graph.hpp"
+#include "graph_core/instrumentation.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/dijkstra.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace instrumentation = graph_library::instrumentation;
+
+#ifndef GRAPH_LIBRARY_INSTRUMENTATION
+//The disabled hooks are stateless and the allocations go straight to std::allocator
+static_assert(std::is_empty_v<instrumentation::ScopedTimer> && std::is_empty_v<instrumentation::ScopedCounter>);
+static_assert(std::is_same_v<instrumentation::DefaultAllocator, std::allocator<std::byte>>);
+#endif
+
+int main(int argc, char** argv) {
+	using graph_library::benchmark::doNotOptimize;
+	graph_library::benchmark::BenchmarkHarness harness(argc, argv);
+	const size_t scale = harness.getOption("scale", 16);
+	const std::uint64_t seed = harness.getOption("seed", 1);
+	const size_t queries_amount = harness.getOption("queries", size_t(1) << 16);
+	harness.addContext("instrumentation", instrumentation::enabled ? "enabled" : "disabled");
+	harness.addContext("scale", std::to_string(scale));
+	harness.addContext("seed", std::to_string(seed));
+	std::printf("instrumentation %s\n", instrumentation::enabled ? "enabled" : "disabled");
+
+	graph_library::GeneratorOptions options;
+	options.seed = seed;
+	options.max_weight = 1000;
+	const Graph<std::uint32_t, int> graph(graph_library::generateErdosRenyi<std::uint32_t, int>(size_t(1) << scale, size_t(8) << scale, options));
+	const size_t amount_nodes = graph.getAmountNodes();
+
+	graph_library::GeneratorRandom random(seed);
+	std::vector<std::pair<std::shared_ptr<Node<std::uint32_t>>, std::shared_ptr<Node<std::uint32_t>>>> handles;
+	handles.reserve(queries_amount);
+	for (size_t i = 0; i < queries_amount; ++i) {
+		handles.emplace_back(graph.getNode(random.below(amount_nodes)), graph.getNode(random.below(amount_nodes)));
+	}
+	instrumentation::reset();
+
+	harness.run("graph/addNode", amount_nodes, [&] {
+		Graph<std::uint32_t, int> result;
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			result.addNode(static_cast<std::uint32_t>(i));
+		}
+		doNotOptimize(result);
+		});
+	harness.run("graph/addEdge", handles.size(),
+		[&] {
+			return std::make_unique<Graph<std::uint32_t, int>>(amount_nodes, 0u);
+		},
+		[&](std::unique_ptr<Graph<std::uint32_t, int>>& result) {
+			for (const auto& [first, second] : handles) {
+				result->addEdge(first->get_index(), second->get_index(), 1);
+			}
+			doNotOptimize(*result);
+		});
+	harness.run("graph/hasEdge", handles.size(), [&] {
+		size_t found = 0;
+		for (const auto& [first, second] : handles) {
+			found += graph.hasEdge(first, second);
+		}
+		doNotOptimize(found);
+		});
+	harness.run("graph/getEdgeWeight", handles.size(), [&] {
+		long long sum = 0;
+		for (const auto& [first, second] : handles) {
+			sum += graph.getEdgeWeightOriented(first, second);
+		}
+		doNotOptimize(sum);
+		});
+	harness.run("bfs", amount_nodes + graph.getAmountEdge(), [&] {
+		auto result = graph_library::bfs(graph, 0);
+		doNotOptimize(result);
+		});
+	graph_library::ShortestPathWorkspace<int> workspace;
+	harness.run("dijkstra", amount_nodes + graph.getAmountEdge(), [&] {
+		graph_library::dijkstra(graph, 0, workspace);
+		doNotOptimize(workspace);
+		});
+
+	if constexpr (instrumentation::enabled) {
+		std::printf("%s\n", instrumentation::snapshot().toJson().c_str());
+	}
+	return harness.finish() ? 0 : 1;
+}
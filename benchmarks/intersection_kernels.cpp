@@ -0,0 +1,83 @@
+//Triangle counting and common-neighbour queries with every intersection kernel on one R-MAT graph,
+//on one thread and on all of them. Kernels the processor lacks are skipped.
+//Usage: intersection_kernels [scale] [edge_factor] [queries]
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/triangles.hpp"
+#include "graph_algorithms/common_neighbors.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 18;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t queries = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000000;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	auto graph = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+	auto start = std::chrono::steady_clock::now();
+	graph_library::NeighbourSets sets(graph, 0);
+	std::printf("%zu nodes, %zu edges, neighbour sets built in %.1f ms, supported kernel %s\n", sets.getAmountNodes(), graph.getAmountEdge(),
+		seconds_since(start) * 1000, graph_library::intersectionKernelName(graph_library::supportedIntersectionKernel()));
+
+	graph_library::GeneratorRandom random(1);
+	std::vector<std::pair<size_t, size_t>> pairs(queries);
+	for (auto& pair : pairs) {
+		pair = { random.below(sets.getAmountNodes()), random.below(sets.getAmountNodes()) };
+	}
+
+	std::printf("%8s %8s %12s %14s %16s %12s %12s %12s\n", "kernel", "threads", "triangles", "triangles ms", "clustering ms", "common ms",
+		"average cc", "common");
+	std::vector<size_t> thread_counts{ 1 };
+	if (graph_library::hardware_threads() > 1) {
+		thread_counts.push_back(graph_library::hardware_threads());
+	}
+	const graph_library::IntersectionKernel kernels[] = {
+		graph_library::IntersectionKernel::SCALAR, graph_library::IntersectionKernel::SSE, graph_library::IntersectionKernel::AVX2
+	};
+	for (auto kernel : kernels) {
+		if (kernel > graph_library::supportedIntersectionKernel()) {
+			continue;
+		}
+		for (size_t threads : thread_counts) {
+			graph_library::IntersectionOptions intersection_options;
+			intersection_options.kernel = kernel;
+			intersection_options.threads = threads;
+
+			start = std::chrono::steady_clock::now();
+			std::uint64_t triangles = graph_library::countTriangles(sets, intersection_options);
+			double triangles_ms = seconds_since(start) * 1000;
+
+			start = std::chrono::steady_clock::now();
+			auto coefficients = graph_library::localClusteringCoefficient(sets, intersection_options);
+			double clustering_ms = seconds_since(start) * 1000;
+
+			start = std::chrono::steady_clock::now();
+			auto common = graph_library::commonNeighbors(sets, pairs, intersection_options);
+			double common_ms = seconds_since(start) * 1000;
+
+			double average_coefficient = 0;
+			for (double coefficient : coefficients) {
+				average_coefficient += coefficient / static_cast<double>(coefficients.size());
+			}
+			size_t common_total = 0;
+			for (size_t amount : common) {
+				common_total += amount;
+			}
+			std::printf("%8s %8zu %12llu %14.1f %16.1f %12.1f %12.4f %12zu\n", graph_library::intersectionKernelName(kernel), threads,
+				static_cast<unsigned long long>(triangles), triangles_ms, clustering_ms, common_ms, average_coefficient, common_total);
+		}
+	}
+	return 0;
+}
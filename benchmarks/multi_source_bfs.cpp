@@ -0,0 +1,124 @@
+//Hop distances from many sources on one R-MAT graph: one bfs per source against multiSourceBfs with every
+//batch size, with and without AVX2, and hopStatistics, which keeps aggregates instead of the distance arrays.
+//Every result is checked against the searches per source, a mismatch is printed and the program returns 1.
+//Usage: multi_source_bfs [scale] [edge_factor] [sources]
+#include "harness.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/multi_source_bfs.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//FNV-1a over the distances of one search, so the reference does not keep a distance array per source
+	std::uint64_t fingerprint(const std::vector<size_t>& distance) {
+		std::uint64_t hash = 14695981039346656037ull;
+		for (size_t value : distance) {
+			hash = (hash ^ value) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	//Aggregates of bfs per source, the same as hopStatistics computes
+	graph_library::HopStatistics statistics_of(const std::vector<size_t>& distance) {
+		graph_library::HopStatistics result;
+		for (size_t value : distance) {
+			if (value != graph_library::BFS_UNREACHED) {
+				++result.reached;
+				result.distance_sum += value;
+				result.eccentricity = std::max(result.eccentricity, value);
+			}
+		}
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t amount_sources = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1024;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	auto graph = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+	graph_library::GeneratorRandom random(4);
+	std::vector<size_t> sources(amount_sources);
+	for (auto& source : sources) {
+		source = random.below(graph.getAmountNodes());
+	}
+	std::printf("%zu nodes, %zu edges, %zu sources, supported kernel %s\n", graph.getAmountNodes(), graph.getAmountEdge(), amount_sources,
+		graph_library::intersectionKernelName(graph_library::supportedIntersectionKernel()));
+
+	//The reference is taken after the clock stops for every search
+	std::vector<std::uint64_t> expected_fingerprints;
+	std::vector<graph_library::HopStatistics> expected_statistics;
+	double single_seconds = 0;
+	for (size_t source : sources) {
+		auto start = std::chrono::steady_clock::now();
+		auto result = graph_library::bfs(graph, source);
+		single_seconds += seconds_since(start);
+		graph_library::benchmark::doNotOptimize(result);
+		expected_fingerprints.push_back(fingerprint(result.distance));
+		expected_statistics.push_back(statistics_of(result.distance));
+	}
+	bool failed = false;
+	std::printf("%-16s %6s %8s %8s %12s %10s\n", "method", "batch", "avx2", "threads", "total ms", "speedup");
+	std::printf("%-16s %6s %8s %8zu %12.1f %10.2f\n", "bfs per source", "-", "-", size_t(1), single_seconds * 1000, 1.0);
+
+	std::vector<size_t> thread_counts{ 1 };
+	if (graph_library::hardware_threads() > 1) {
+		thread_counts.push_back(graph_library::hardware_threads());
+	}
+	for (size_t threads : thread_counts) {
+		for (size_t batch : { size_t(64), size_t(128), size_t(256) }) {
+			for (bool vectorized : { false, true }) {
+				if (vectorized && (batch != 256 || graph_library::supportedIntersectionKernel() != graph_library::IntersectionKernel::AVX2)) {
+					continue;
+				}
+				graph_library::MultiSourceBfsOptions batch_options;
+				batch_options.threads = threads;
+				batch_options.batch_size = batch;
+				batch_options.vectorized = vectorized;
+
+				auto start = std::chrono::steady_clock::now();
+				auto distances = graph_library::multiSourceBfs(graph, sources, batch_options);
+				double seconds = seconds_since(start);
+				graph_library::benchmark::doNotOptimize(distances);
+				std::printf("%-16s %6zu %8s %8zu %12.1f %10.2f\n", "multiSourceBfs", batch, vectorized ? "yes" : "no", threads, seconds * 1000,
+					single_seconds / seconds);
+				for (size_t i = 0; i < sources.size(); ++i) {
+					if (fingerprint(distances[i]) != expected_fingerprints[i]) {
+						std::printf("mismatch: multiSourceBfs, batch %zu, avx2 %s, source %zu\n", batch, vectorized ? "yes" : "no", sources[i]);
+						failed = true;
+					}
+				}
+				distances = {};
+
+				start = std::chrono::steady_clock::now();
+				auto statistics = graph_library::hopStatistics(graph, sources, batch_options);
+				seconds = seconds_since(start);
+				graph_library::benchmark::doNotOptimize(statistics);
+				std::printf("%-16s %6zu %8s %8zu %12.1f %10.2f\n", "hopStatistics", batch, vectorized ? "yes" : "no", threads, seconds * 1000,
+					single_seconds / seconds);
+				for (size_t i = 0; i < sources.size(); ++i) {
+					const auto& expected = expected_statistics[i];
+					if (statistics[i].reached != expected.reached || statistics[i].distance_sum != expected.distance_sum ||
+						statistics[i].eccentricity != expected.eccentricity) {
+						std::printf("mismatch: hopStatistics, batch %zu, avx2 %s, source %zu\n", batch, vectorized ? "yes" : "no", sources[i]);
+						failed = true;
+					}
+				}
+			}
+		}
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+//Node turnover: every round removes a share of the live nodes and adds as many new ones with edges,
+//then compacts the graph. Shows that removal cost follows the degree and not the graph size.
+//Usage: node_churn [nodes] [edges_per_node] [rounds] [percent]
+#include "graph_core/graph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//Undirected edges from the node to random live nodes
+	void connect(Graph<int>& graph, size_t index, size_t amount, std::mt19937_64& rng) {
+		std::uniform_int_distribution<size_t> node(0, graph.getAmountNodes() - 1);
+		for (size_t k = 0; k < amount; ++k) {
+			size_t to = node(rng);
+			if (!graph.isNodeRemoved(to)) {
+				graph.addEdge(index, to, 1);
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t amount_nodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+	size_t edges_per_node = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+	size_t rounds = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+	size_t percent = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 5;
+
+	std::mt19937_64 rng(42);
+	Graph<int> graph;
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		graph.addNode(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < amount_nodes; ++i) {
+		connect(graph, i, edges_per_node, rng);
+	}
+
+	size_t turnover = amount_nodes * percent / 100;
+	std::printf("%zu nodes, %zu edges, %zu nodes replaced per round\n", amount_nodes, graph.getAmountEdge(), turnover);
+	std::printf("%8s %16s %12s %12s\n", "round", "us per removal", "add ms", "compact ms");
+	int next_value = static_cast<int>(amount_nodes);
+	for (size_t round = 0; round < rounds; ++round) {
+		std::uniform_int_distribution<size_t> node(0, graph.getAmountNodes() - 1);
+		auto start = std::chrono::steady_clock::now();
+		size_t removed = 0;
+		while (removed < turnover) {
+			size_t index = node(rng);
+			if (!graph.isNodeRemoved(index)) {
+				graph.removeNode(graph.getNode(index));
+				++removed;
+			}
+		}
+		double remove_us = seconds_since(start) * 1e6 / static_cast<double>(turnover);
+
+		start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < turnover; ++i) {
+			auto added = graph.addNode(next_value++);
+			connect(graph, added->get_index(), edges_per_node, rng);
+		}
+		double add_ms = seconds_since(start) * 1000;
+
+		start = std::chrono::steady_clock::now();
+		graph.compact();
+		double compact_ms = seconds_since(start) * 1000;
+		std::printf("%8zu %16.2f %12.1f %12.1f\n", round, remove_us, add_ms, compact_ms);
+	}
+	return 0;
+}
@@ -0,0 +1,86 @@
+//Node-count scaling of graph construction.
+//"handle" resolves nodes through the index carried by the node (O(1)),
+//"by value" looks up nodes of another graph by data with a linear scan (the old behaviour),
+//"value index" does the same lookups through the optional hash index.
+#include "graph_core/graph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+	constexpr size_t EDGES_PER_NODE = 4;
+	constexpr size_t MAX_SCAN_NODES = 16000;
+
+	std::vector<std::pair<size_t, size_t>> random_edges(size_t amount_nodes, unsigned seed) {
+		std::mt19937_64 rng(seed);
+		std::uniform_int_distribution<size_t> pick(0, amount_nodes - 1);
+		std::vector<std::pair<size_t, size_t>> edges(amount_nodes * EDGES_PER_NODE);
+		for (auto& edge : edges) {
+			edge = { pick(rng), pick(rng) };
+		}
+		return edges;
+	}
+
+	template <typename Function>
+	double measure_ms(Function&& function) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		auto finish = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(finish - start).count();
+	}
+
+	double build_with_handles(size_t amount_nodes, const std::vector<std::pair<size_t, size_t>>& edges) {
+		return measure_ms([&] {
+			Graph<size_t> graph;
+			std::vector<std::shared_ptr<Node<size_t>>> handles;
+			handles.reserve(amount_nodes);
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				handles.push_back(graph.addNode(i));
+			}
+			for (const auto& [from, to] : edges) {
+				graph.addEdgeOriented(handles[from], handles[to], 1);
+			}
+		});
+	}
+
+	double build_with_foreign_nodes(size_t amount_nodes, const std::vector<std::pair<size_t, size_t>>& edges, bool value_index) {
+		Graph<size_t> source;
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			source.addNode(i);
+		}
+		return measure_ms([&] {
+			Graph<size_t> graph;
+			if (value_index) {
+				graph.enableValueIndex();
+			}
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				graph.addNode(i);
+			}
+			for (const auto& [from, to] : edges) {
+				graph.addEdgeOriented(source.getNode(from), source.getNode(to), 1);
+			}
+		});
+	}
+}
+
+int main() {
+	std::printf("%10s %10s %14s %14s %14s %14s\n", "nodes", "edges", "handle ms", "ns/edge", "by value ms", "value index ms");
+	for (size_t amount_nodes = 1000; amount_nodes <= 1024000; amount_nodes *= 2) {
+		auto edges = random_edges(amount_nodes, 42);
+		double handle_ms = build_with_handles(amount_nodes, edges);
+		double index_ms = build_with_foreign_nodes(amount_nodes, edges, true);
+		double scan_ms = amount_nodes <= MAX_SCAN_NODES ? build_with_foreign_nodes(amount_nodes, edges, false) : -1.0;
+
+		std::printf("%10zu %10zu %14.2f %14.1f ", amount_nodes, edges.size(), handle_ms, handle_ms * 1e6 / edges.size());
+		if (scan_ms >= 0) {
+			std::printf("%14.2f ", scan_ms);
+		}
+		else {
+			std::printf("%14s ", "-");
+		}
+		std::printf("%14.2f\n", index_ms);
+	}
+	return 0;
+}
@@ -0,0 +1,102 @@
+//PageRank, personalized PageRank, Katz centrality and label propagation on one directed R-MAT graph:
+//the time to build the in-edges once, then the iterations in double and in float precision on one
+//thread and on all of them. Label propagation runs on the symmetric graph of the same edges.
+//Usage: pagerank [scale] [edge_factor] [iterations]
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/pagerank.hpp"
+#include "graph_algorithms/katz.hpp"
+#include "graph_algorithms/label_propagation.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	template <typename VALUE>
+	void run_pagerank(const char* precision, graph_library::PageRank<VALUE>& engine, const std::vector<size_t>& sources,
+		size_t iterations, size_t threads)
+	{
+		graph_library::PageRankOptions options;
+		options.threads = threads;
+		//A fixed amount of iterations, so that both precisions do the same work
+		options.tolerance = 0;
+		options.max_iterations = iterations;
+
+		auto start = std::chrono::steady_clock::now();
+		auto result = engine.run(options);
+		double pagerank_ms = seconds_since(start) * 1000;
+
+		start = std::chrono::steady_clock::now();
+		auto personalized = engine.runPersonalized(sources, options);
+		double personalized_ms = seconds_since(start) * 1000;
+
+		VALUE top = 0;
+		for (VALUE value : result.values) {
+			top = value > top ? value : top;
+		}
+		std::printf("%10s %8zu %14.2f %16.2f %14.3e %12.3e\n", precision, threads, pagerank_ms / static_cast<double>(result.iterations),
+			personalized_ms / static_cast<double>(personalized.iterations), static_cast<double>(top), result.residual);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 20;
+	iterations = iterations == 0 ? 1 : iterations;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	options.symmetric = false;
+	auto graph = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+
+	auto start = std::chrono::steady_clock::now();
+	graph_library::PageRank<double> double_engine(graph);
+	double build_ms = seconds_since(start) * 1000;
+	graph_library::PageRank<float> float_engine(graph);
+	std::printf("%zu nodes, %zu edges, in-edges built in %.1f ms, %.1f MB\n", graph.getAmountNodes(), graph.getAmountEdge(), build_ms,
+		static_cast<double>(double_engine.getReverseAdjacency().memoryFootprint()) / (1 << 20));
+
+	graph_library::GeneratorRandom random(1);
+	std::vector<size_t> sources(16);
+	for (auto& source : sources) {
+		source = random.below(graph.getAmountNodes());
+	}
+
+	std::vector<size_t> thread_counts{ 1 };
+	if (graph_library::hardware_threads() > 1) {
+		thread_counts.push_back(graph_library::hardware_threads());
+	}
+	std::printf("%10s %8s %14s %16s %14s %12s\n", "precision", "threads", "iteration ms", "personalized ms", "top rank", "residual");
+	for (size_t threads : thread_counts) {
+		run_pagerank("double", double_engine, sources, iterations, threads);
+		run_pagerank("float", float_engine, sources, iterations, threads);
+	}
+
+	options.symmetric = true;
+	auto symmetric = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+	std::printf("\n%12s %8s %12s %12s %12s\n", "analytics", "threads", "total ms", "iterations", "converged");
+	for (size_t threads : thread_counts) {
+		graph_library::KatzOptions katz_options;
+		katz_options.threads = threads;
+		katz_options.alpha = 0.01;
+		katz_options.max_iterations = iterations;
+		start = std::chrono::steady_clock::now();
+		auto katz = graph_library::katzCentrality(graph, katz_options);
+		std::printf("%12s %8zu %12.1f %12zu %12s\n", "katz", threads, seconds_since(start) * 1000, katz.iterations, katz.converged ? "yes" : "no");
+
+		graph_library::LabelPropagationOptions label_options;
+		label_options.threads = threads;
+		start = std::chrono::steady_clock::now();
+		auto labels = graph_library::labelPropagation(symmetric, label_options);
+		std::printf("%12s %8zu %12.1f %12zu %12s\n", "labels", threads, seconds_since(start) * 1000, labels.iterations,
+			labels.converged ? "yes" : "no");
+	}
+	return 0;
+}
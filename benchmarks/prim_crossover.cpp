@@ -0,0 +1,49 @@
+//Times both Prim variants over a range of densities E / V^2 to find the crossover.
+//tests/mst_tests.cpp checks them against a brute-force minimum spanning forest.
+//Usage: prim_crossover [nodes]
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/prim.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+	Graph<size_t> random_graph(size_t amount_nodes, size_t amount_edges, std::mt19937_64& rng) {
+		Graph<size_t> graph;
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			graph.addNode(i);
+		}
+		std::uniform_int_distribution<size_t> pick(0, amount_nodes - 1);
+		std::uniform_int_distribution<int> weight(1, 1000);
+		for (size_t i = 0; i < amount_edges; ++i) {
+			graph.addEdge(pick(rng), pick(rng), weight(rng));
+		}
+		return graph;
+	}
+
+	double time_ms(const CompactGraph<size_t>& graph, graph_library::PrimMode mode) {
+		graph_library::PrimOptions options;
+		options.mode = mode;
+		auto start = std::chrono::steady_clock::now();
+		auto result = graph_library::prim(graph, options);
+		auto finish = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(finish - start).count();
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t amount_nodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+	std::mt19937_64 rng(7);
+
+	std::printf("%10s %12s %12s %12s\n", "E/V^2", "edges", "heap ms", "dense ms");
+	for (double density : { 0.001, 0.01, 0.05, 0.1, 0.2, 0.4, 0.6, 0.8, 1.0 }) {
+		size_t amount_edges = static_cast<size_t>(density * amount_nodes * amount_nodes / 2);
+		auto graph = random_graph(amount_nodes, amount_edges, rng).freeze();
+		std::printf("%10.3f %12zu %12.2f %12.2f\n", density, graph.getAmountEdge(),
+			time_ms(graph, graph_library::PrimMode::HEAP), time_ms(graph, graph_library::PrimMode::DENSE));
+	}
+	return 0;
+}
@@ -0,0 +1,146 @@
+//Locality gained by the node orderings of reordering.hpp on power-law graphs (R-MAT and Barabási–Albert)
+//whose node indices were shuffled first, as an arbitrary insertion order leaves them. For every ordering:
+//the time to compute it, and the time and last-level cache misses of BFS and of PageRank iterations
+//on the renumbered CSR graph, with the speedup over the shuffled graph. Cache misses need Linux perf
+//counters and are shown as n/a without them.
+//Usage: reordering [scale] [edge_factor] [rounds]
+#include "harness.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/reordering.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using Compact = CompactGraph<std::uint32_t, int>;
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//Pull iterations of PageRank: every node sums the shares of its neighbours, the access pattern reordering helps
+	std::vector<double> pagerank_iterations(const Compact& graph, size_t iterations) {
+		const size_t amount_nodes = graph.getAmountNodes();
+		std::vector<double> rank(amount_nodes, 1.0 / static_cast<double>(amount_nodes));
+		std::vector<double> share(amount_nodes);
+		for (size_t iteration = 0; iteration < iterations; ++iteration) {
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				size_t degree = graph.degree(index);
+				share[index] = degree == 0 ? 0.0 : rank[index] / static_cast<double>(degree);
+			}
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				double sum = 0;
+				for (auto to : graph.neighbors(index)) {
+					sum += share[to];
+				}
+				rank[index] = 0.15 / static_cast<double>(amount_nodes) + 0.85 * sum;
+			}
+		}
+		return rank;
+	}
+
+	struct Measurement {
+		double bfs_seconds = 0;
+		double pagerank_seconds = 0;
+		std::uint64_t bfs_misses = 0;
+		std::uint64_t pagerank_misses = 0;
+	};
+
+	//sources are original indices, the searches start from the same nodes in every ordering
+	Measurement measure(const Compact& graph, const Permutation& permutation, const std::vector<size_t>& sources,
+		graph_library::benchmark::CacheMissCounter& misses)
+	{
+		Measurement result;
+		for (size_t source : sources) {
+			misses.start();
+			auto start = std::chrono::steady_clock::now();
+			auto reached = graph_library::bfs(graph, permutation.newIndex(source));
+			result.bfs_seconds += seconds_since(start);
+			result.bfs_misses += misses.stop();
+			graph_library::benchmark::doNotOptimize(reached);
+		}
+		misses.start();
+		auto start = std::chrono::steady_clock::now();
+		auto rank = pagerank_iterations(graph, 10);
+		result.pagerank_seconds = seconds_since(start);
+		result.pagerank_misses = misses.stop();
+		graph_library::benchmark::doNotOptimize(rank);
+		return result;
+	}
+
+	std::string format_misses(std::uint64_t misses, bool available) {
+		if (!available) {
+			return "n/a";
+		}
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.2fM", static_cast<double>(misses) / 1e6);
+		return buffer;
+	}
+
+	void run(const std::string& name, const Compact& generated, size_t rounds) {
+		const size_t amount_nodes = generated.getAmountNodes();
+		graph_library::GeneratorRandom random(7);
+		std::vector<std::uint32_t> order(amount_nodes);
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			order[i] = static_cast<std::uint32_t>(i);
+		}
+		for (size_t i = amount_nodes; i > 1; --i) {
+			std::swap(order[i - 1], order[random.below(i)]);
+		}
+		const Compact shuffled = generated.permuted(Permutation(std::move(order)));
+		std::vector<size_t> sources(rounds);
+		for (auto& source : sources) {
+			source = random.below(amount_nodes);
+		}
+
+		graph_library::benchmark::CacheMissCounter misses;
+		std::printf("\n%s: %zu nodes, %zu edges\n", name.c_str(), amount_nodes, shuffled.getAmountEdge());
+		std::printf("%-10s %12s %10s %10s %12s %12s %10s %12s\n", "ordering", "compute ms", "bfs ms", "speedup", "bfs misses",
+			"pagerank ms", "speedup", "pr misses");
+
+		const Permutation identity = Permutation::identity(amount_nodes);
+		const Measurement baseline = measure(shuffled, identity, sources, misses);
+		auto print = [&](const char* ordering, double compute_seconds, const Measurement& measurement) {
+			std::printf("%-10s %12.1f %10.2f %10.2f %12s %12.1f %10.2f %12s\n", ordering, compute_seconds * 1000,
+				measurement.bfs_seconds * 1000 / static_cast<double>(rounds), baseline.bfs_seconds / measurement.bfs_seconds,
+				format_misses(measurement.bfs_misses / rounds, misses.available()).c_str(), measurement.pagerank_seconds * 1000,
+				baseline.pagerank_seconds / measurement.pagerank_seconds, format_misses(measurement.pagerank_misses, misses.available()).c_str());
+		};
+		print("shuffled", 0, baseline);
+
+		const std::pair<const char*, graph_library::Ordering> orderings[] = {
+			{ "degree", graph_library::Ordering::DEGREE },
+			{ "bfs", graph_library::Ordering::BFS },
+			{ "rcm", graph_library::Ordering::REVERSE_CUTHILL_MCKEE },
+			{ "gorder", graph_library::Ordering::GORDER }
+		};
+		for (const auto& [ordering_name, ordering] : orderings) {
+			graph_library::ReorderingOptions options;
+			options.ordering = ordering;
+			auto start = std::chrono::steady_clock::now();
+			Permutation permutation = graph_library::computeOrder(shuffled, options);
+			double compute_seconds = seconds_since(start);
+			const Compact reordered = shuffled.permuted(permutation);
+			print(ordering_name, compute_seconds, measure(reordered, permutation, sources, misses));
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 18;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t rounds = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+	rounds = rounds == 0 ? 1 : rounds;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	run("rmat", graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options), rounds);
+	run("barabasi_albert", graph_library::generateBarabasiAlbert<std::uint32_t, int>(size_t(1) << scale, edge_factor / 2, options), rounds);
+	return 0;
+}
@@ -0,0 +1,91 @@
+//Parsing speed of readTextGraph on a generated weighted edge list, compared with an iostream loop.
+//Usage: text_parse [megabytes] [path]
+#include "graph_io/file_reader.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+	//Writes random "from to weight" lines until the file has the requested size
+	void generate(const std::string& path, size_t megabytes, size_t amount_nodes) {
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (file == nullptr) {
+			std::fprintf(stderr, "Cannot create %s\n", path.c_str());
+			std::exit(1);
+		}
+		std::mt19937_64 rng(42);
+		std::uniform_int_distribution<size_t> node(0, amount_nodes - 1);
+		std::uniform_int_distribution<int> weight(1, 1000000);
+		std::vector<char> buffer(1 << 20);
+		size_t written = 0;
+		size_t target = megabytes << 20;
+		while (written < target) {
+			size_t used = 0;
+			while (used + 64 < buffer.size()) {
+				char* position = buffer.data() + used;
+				char* end = buffer.data() + buffer.size();
+				position = std::to_chars(position, end, node(rng)).ptr;
+				*position++ = ' ';
+				position = std::to_chars(position, end, node(rng)).ptr;
+				*position++ = ' ';
+				position = std::to_chars(position, end, weight(rng)).ptr;
+				*position++ = '\n';
+				used = static_cast<size_t>(position - buffer.data());
+			}
+			std::fwrite(buffer.data(), 1, used, file);
+			written += used;
+		}
+		std::fclose(file);
+	}
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+	std::string path = argc > 2 ? argv[2] : "graph_library_edges.txt";
+	size_t amount_nodes = 1 << 24;
+
+	std::printf("Generating %zu MB edge list in %s\n", megabytes, path.c_str());
+	generate(path, megabytes, amount_nodes);
+	double size_mb = static_cast<double>(graph_library::MappedFile(path).size()) / (1 << 20);
+
+	std::printf("%12s %12s %12s %14s\n", "threads", "seconds", "MB/s", "edges");
+	std::vector<size_t> thread_counts{ 1, 2, 4, graph_library::hardware_threads() };
+	std::sort(thread_counts.begin(), thread_counts.end());
+	thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+	for (size_t threads : thread_counts) {
+		graph_library::TextReadOptions options;
+		options.format = graph_library::TextGraphFormat::EDGE_LIST;
+		options.threads = threads;
+		auto start = std::chrono::steady_clock::now();
+		auto graph = graph_library::readTextGraph<std::uint32_t, int>(path, options);
+		double seconds = seconds_since(start);
+		std::printf("%12zu %12.2f %12.1f %14zu\n", threads, seconds, size_mb / seconds, graph.getAmountEdge());
+	}
+
+	//Baseline: extraction operators into a flat array, without building a graph
+	auto start = std::chrono::steady_clock::now();
+	std::ifstream input(path);
+	std::vector<EdgeRecord<int>> edges;
+	size_t from = 0;
+	size_t to = 0;
+	int weight = 0;
+	while (input >> from >> to >> weight) {
+		edges.push_back({ static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight });
+	}
+	double seconds = seconds_since(start);
+	std::printf("%12s %12.2f %12.1f %14zu\n", "iostream", seconds, size_mb / seconds, edges.size());
+
+	std::remove(path.c_str());
+	return 0;
+}
@@ -0,0 +1,91 @@
+//"First node within k hops whose data matches" on one R-MAT graph: a full BFS that fills the distance
+//arrays and then scans them, against bfsRange, dfsRange and bestFirstRange that stop at the first match.
+//A share of the nodes matches, the rarer the match the more of the graph the lazy searches explore.
+//Usage: traversal_ranges [scale] [edge_factor] [queries] [match_one_in]
+#include "harness.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/traversal_ranges.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+	size_t edge_factor = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+	size_t queries = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+	size_t match_one_in = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1000;
+	match_one_in = match_one_in == 0 ? 1 : match_one_in;
+
+	graph_library::GeneratorOptions options;
+	options.threads = 0;
+	options.max_weight = 100;
+	auto graph = graph_library::generateRmat<std::uint32_t, int>(scale, edge_factor, options);
+	const size_t amount_nodes = graph.getAmountNodes();
+	graph_library::GeneratorRandom random(9);
+	std::vector<bool> matches(amount_nodes);
+	for (size_t index = 0; index < amount_nodes; ++index) {
+		matches[index] = random.below(match_one_in) == 0;
+	}
+	std::vector<size_t> sources(queries);
+	for (auto& source : sources) {
+		source = random.below(amount_nodes);
+	}
+	const size_t max_depth = 3;
+	graph_library::TraversalOptions traversal;
+	traversal.max_depth = max_depth;
+
+	std::printf("%zu nodes, %zu edges, %zu queries, one node in %zu matches, within %zu hops\n", amount_nodes, graph.getAmountEdge(),
+		queries, match_one_in, max_depth);
+	std::printf("%16s %12s %10s %14s\n", "search", "query us", "found", "nodes produced");
+	auto print = [&](const char* name, double seconds, size_t found, size_t produced) {
+		std::printf("%16s %12.1f %10zu %14.1f\n", name, seconds * 1e6 / static_cast<double>(queries), found,
+			static_cast<double>(produced) / static_cast<double>(queries));
+	};
+
+	size_t found = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t source : sources) {
+		graph_library::BfsOptions bfs_options;
+		auto result = graph_library::bfs(graph, source, bfs_options);
+		size_t best = graph_library::BFS_UNREACHED;
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			if (matches[index] && result.distance[index] <= max_depth && (best == graph_library::BFS_UNREACHED ||
+				result.distance[index] < result.distance[best])) {
+				best = index;
+			}
+		}
+		found += best != graph_library::BFS_UNREACHED ? 1 : 0;
+		graph_library::benchmark::doNotOptimize(result);
+	}
+	print("full bfs", seconds_since(start), found, amount_nodes * queries);
+
+	auto lazy = [&](const char* name, auto&& make_range) {
+		size_t lazy_found = 0;
+		size_t produced = 0;
+		auto lazy_start = std::chrono::steady_clock::now();
+		for (size_t source : sources) {
+			for (const auto& step : make_range(source)) {
+				++produced;
+				if (matches[step.node]) {
+					++lazy_found;
+					break;
+				}
+			}
+		}
+		print(name, seconds_since(lazy_start), lazy_found, produced);
+	};
+	lazy("bfsRange", [&](size_t source) { return graph_library::bfsRange(graph, source, traversal); });
+	lazy("dfsRange", [&](size_t source) { return graph_library::dfsRange(graph, source, traversal); });
+	lazy("bestFirstRange", [&](size_t source) { return graph_library::bestFirstRange(graph, source); });
+	return 0;
+}
@@ -37,11 +37,23 @@ namespace graph_library {
         FileReadException(const std::string& message) : GraphException(message) {}
     };
 
+    // Exception for when a file cannot be written
+    class FileWriteException : public GraphException {
+    public:
+        FileWriteException(const std::string& message) : GraphException(message) {}
+    };
+
     // Exception for parsing errors
     class ParseException : public GraphException {
     public:
         ParseException(const std::string& message) : GraphException(message) {}
     };
+
+    // The algorithm requires a graph without cycles
+    class GraphHasCycleException : public GraphException {
+    public:
+        GraphHasCycleException(const std::string& message = "The graph has a cycle") : GraphException(message) {}
+    };
 }
 
 #endif
@@ -1 +1,233 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../exceptions.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
 
+namespace graph_library {
+
+	//Distance and parent of nodes that were not reached
+	inline constexpr size_t BFS_UNREACHED = std::numeric_limits<size_t>::max();
+
+	//Result of a breadth-first search, indexed by node index. The source is its own parent
+	struct BfsResult {
+		std::vector<size_t> distance;
+		std::vector<size_t> parent;
+	};
+
+	struct BfsOptions {
+		//1 - serial queue based search, 0 - all hardware threads
+		size_t threads = 1;
+		//Stop once target is reached. Nodes farther than target may be left unreached
+		size_t target = BFS_UNREACHED;
+		//Every edge has an opposite edge (the graph is built with addEdge), implied for SymmetricGraph.
+		//Only then the parallel search may switch to bottom-up steps, which scan the edges of unvisited nodes
+		bool symmetric = false;
+		//Switch to bottom-up when the frontier has more than 1/alpha of the unexplored edges,
+		//and back to top-down when it has fewer than 1/beta of the nodes
+		size_t alpha = 15;
+		size_t beta = 18;
+	};
+
+	namespace detail {
+
+		template <AdjacencyGraph GRAPH>
+		void bfs_serial(const GRAPH& graph, size_t source, size_t target, BfsResult& result) {
+			std::vector<size_t> queue;
+			queue.reserve(graph.getAmountNodes());
+			queue.push_back(source);
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+
+			for (size_t head = 0; head < queue.size(); ++head) {
+				if (target != BFS_UNREACHED && result.parent[target] != BFS_UNREACHED) {
+					return;
+				}
+				size_t index = queue[head];
+				for (const auto& edge : graph.outEdges(index)) {
+					visited.add();
+					size_t to_index = edge.get_to_index();
+					if (result.parent[to_index] == BFS_UNREACHED) {
+						result.parent[to_index] = index;
+						result.distance[to_index] = result.distance[index] + 1;
+						queue.push_back(to_index);
+					}
+				}
+			}
+		}
+
+		//Level-synchronous search: top-down steps expand a queue frontier and claim nodes with CAS,
+		//bottom-up steps let every unvisited node look for a parent in a bitmap frontier (Beamer et al.)
+		template <AdjacencyGraph GRAPH>
+		void bfs_parallel(const GRAPH& graph, size_t source, const BfsOptions& options, BfsResult& result) {
+			const size_t amount_nodes = graph.getAmountNodes();
+			const size_t threads = resolve_threads(options.threads);
+			const size_t words = (amount_nodes + 63) / 64;
+
+			std::vector<std::atomic<size_t>> parent(amount_nodes);
+			parallel_for(threads, amount_nodes, [&parent](size_t, size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					parent[i].store(BFS_UNREACHED, std::memory_order_relaxed);
+				}
+				});
+			parent[source].store(source, std::memory_order_relaxed);
+
+			std::vector<size_t> frontier{ source };
+			std::vector<std::vector<size_t>> next_parts(threads);
+			std::vector<std::uint64_t> frontier_bits;
+			std::vector<std::uint64_t> next_bits;
+			std::vector<size_t> thread_nodes(threads);
+			std::vector<size_t> thread_edges(threads);
+			std::atomic<bool> target_found(source == options.target);
+
+			size_t unexplored_edges = 0;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				unexplored_edges += out_degree(graph, i);
+			}
+			size_t frontier_nodes = 1;
+			size_t frontier_edges = out_degree(graph, source);
+			size_t alpha = options.alpha == 0 ? 1 : options.alpha;
+			size_t beta = options.beta == 0 ? 1 : options.beta;
+			bool bottom_up = false;
+			const bool symmetric = options.symmetric || SymmetricGraph<GRAPH>;
+
+			for (size_t level = 1; frontier_nodes > 0 && !target_found.load(std::memory_order_relaxed); ++level) {
+				unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+
+				//Choose the direction of this step
+				if (symmetric && !bottom_up && frontier_edges > unexplored_edges / alpha) {
+					bottom_up = true;
+					frontier_bits.assign(words, 0);
+					next_bits.assign(words, 0);
+					for (size_t index : frontier) {
+						frontier_bits[index / 64] |= std::uint64_t(1) << (index % 64);
+					}
+				}
+				else if (bottom_up && frontier_nodes < amount_nodes / beta) {
+					bottom_up = false;
+					frontier.clear();
+					for (size_t i = 0; i < amount_nodes; ++i) {
+						if (frontier_bits[i / 64] & (std::uint64_t(1) << (i % 64))) {
+							frontier.push_back(i);
+						}
+					}
+				}
+
+				std::fill(thread_nodes.begin(), thread_nodes.end(), 0);
+				std::fill(thread_edges.begin(), thread_edges.end(), 0);
+
+				if (bottom_up) {
+					parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+						size_t found_nodes = 0;
+						size_t found_edges = 0;
+						instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+						for (size_t i = begin / 64; i < (end + 63) / 64; ++i) {
+							next_bits[i] = 0;
+						}
+						for (size_t index = begin; index < end; ++index) {
+							if (parent[index].load(std::memory_order_relaxed) != BFS_UNREACHED) {
+								continue;
+							}
+							for (const auto& edge : graph.outEdges(index)) {
+								visited.add();
+								size_t from = edge.get_to_index();
+								if (frontier_bits[from / 64] & (std::uint64_t(1) << (from % 64))) {
+									parent[index].store(from, std::memory_order_relaxed);
+									result.distance[index] = level;
+									next_bits[index / 64] |= std::uint64_t(1) << (index % 64);
+									++found_nodes;
+									found_edges += out_degree(graph, index);
+									if (index == options.target) {
+										target_found.store(true, std::memory_order_relaxed);
+									}
+									break;
+								}
+							}
+						}
+						thread_nodes[thread_id] = found_nodes;
+						thread_edges[thread_id] = found_edges;
+						}, 64);
+					frontier_bits.swap(next_bits);
+				}
+				else {
+					parallel_for(threads, frontier.size(), [&](size_t thread_id, size_t begin, size_t end) {
+						auto& next = next_parts[thread_id];
+						next.clear();
+						size_t found_edges = 0;
+						instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+						for (size_t i = begin; i < end; ++i) {
+							size_t index = frontier[i];
+							for (const auto& edge : graph.outEdges(index)) {
+								visited.add();
+								size_t to_index = edge.get_to_index();
+								size_t expected = BFS_UNREACHED;
+								if (parent[to_index].load(std::memory_order_relaxed) == BFS_UNREACHED &&
+									parent[to_index].compare_exchange_strong(expected, index, std::memory_order_relaxed)) {
+									result.distance[to_index] = level;
+									next.push_back(to_index);
+									found_edges += out_degree(graph, to_index);
+									if (to_index == options.target) {
+										target_found.store(true, std::memory_order_relaxed);
+									}
+								}
+							}
+						}
+						thread_nodes[thread_id] = next.size();
+						thread_edges[thread_id] = found_edges;
+						});
+
+					frontier.clear();
+					for (auto& next : next_parts) {
+						frontier.insert(frontier.end(), next.begin(), next.end());
+						next.clear();
+					}
+				}
+
+				frontier_nodes = 0;
+				frontier_edges = 0;
+				for (size_t t = 0; t < threads; ++t) {
+					frontier_nodes += thread_nodes[t];
+					frontier_edges += thread_edges[t];
+				}
+			}
+
+			parallel_for(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					result.parent[i] = parent[i].load(std::memory_order_relaxed);
+				}
+				});
+		}
+	}
+
+	//Breadth-first search from the node with index source. Works on any AdjacencyGraph
+	//(Graph, CompactGraph, ...). Distances are counted in edges
+	template <AdjacencyGraph GRAPH>
+	BfsResult bfs(const GRAPH& graph, size_t source, const BfsOptions& options = BfsOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::BFS);
+		size_t amount_nodes = graph.getAmountNodes();
+		if (source >= amount_nodes) {
+			throw InvalidIndexException();
+		}
+		if (options.target != BFS_UNREACHED && options.target >= amount_nodes) {
+			throw InvalidIndexException();
+		}
+
+		BfsResult result;
+		result.distance.assign(amount_nodes, BFS_UNREACHED);
+		result.parent.assign(amount_nodes, BFS_UNREACHED);
+		result.distance[source] = 0;
+		result.parent[source] = source;
+
+		if (options.threads == 1) {
+			detail::bfs_serial(graph, source, options.target, result);
+		}
+		else {
+			detail::bfs_parallel(graph, source, options, result);
+		}
+		return result;
+	}
+}
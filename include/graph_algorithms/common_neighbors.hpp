@@ -0,0 +1,75 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "intersection.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace graph_library {
+
+	namespace detail {
+
+		template <typename Function>
+		void for_each_pair(const NeighbourSets& sets, const std::vector<std::pair<size_t, size_t>>& pairs, const IntersectionOptions& options,
+			Function&& function)
+		{
+			for (const auto& [first, second] : pairs) {
+				if (first >= sets.getAmountNodes() || second >= sets.getAmountNodes()) {
+					throw InvalidIndexException();
+				}
+			}
+			const IntersectionKernel kernel = resolve_kernel(options.kernel);
+			parallel_for_dynamic(options.threads, pairs.size(), [&](size_t, size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					auto first = sets.neighbors(pairs[i].first);
+					auto second = sets.neighbors(pairs[i].second);
+					function(i, first.size(), second.size(), intersection_size(first.data(), first.size(), second.data(), second.size(), kernel));
+				}
+				});
+		}
+	}
+
+	//Amount of common neighbours of every pair of nodes, in the order of pairs
+	inline std::vector<size_t> commonNeighbors(const NeighbourSets& sets, const std::vector<std::pair<size_t, size_t>>& pairs,
+		const IntersectionOptions& options = IntersectionOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COMMON_NEIGHBORS);
+		std::vector<size_t> result(pairs.size());
+		detail::for_each_pair(sets, pairs, options, [&result](size_t i, size_t, size_t, size_t common) {
+			result[i] = common;
+			});
+		return result;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	std::vector<size_t> commonNeighbors(const GRAPH& graph, const std::vector<std::pair<size_t, size_t>>& pairs,
+		const IntersectionOptions& options = IntersectionOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COMMON_NEIGHBORS);
+		return commonNeighbors(NeighbourSets(graph, options.threads), pairs, options);
+	}
+
+	//Common neighbours divided by the neighbours of either node (Jaccard index), 0 for two isolated nodes
+	inline std::vector<double> jaccardSimilarity(const NeighbourSets& sets, const std::vector<std::pair<size_t, size_t>>& pairs,
+		const IntersectionOptions& options = IntersectionOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COMMON_NEIGHBORS);
+		std::vector<double> result(pairs.size());
+		detail::for_each_pair(sets, pairs, options, [&result](size_t i, size_t degree_first, size_t degree_second, size_t common) {
+			size_t united = degree_first + degree_second - common;
+			result[i] = united == 0 ? 0.0 : static_cast<double>(common) / static_cast<double>(united);
+			});
+		return result;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	std::vector<double> jaccardSimilarity(const GRAPH& graph, const std::vector<std::pair<size_t, size_t>>& pairs,
+		const IntersectionOptions& options = IntersectionOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COMMON_NEIGHBORS);
+		return jaccardSimilarity(NeighbourSets(graph, options.threads), pairs, options);
+	}
+}
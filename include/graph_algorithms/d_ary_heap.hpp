@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Min-heap of elements 0 .. capacity-1 with a key per element and a position index,
+	//so decrease-key is O(log_D n) without stale entries
+	template <typename KEY, size_t D = 4>
+	class IndexedDAryHeap {
+		static_assert(D >= 2, "Heap arity must be at least 2");
+	private:
+		static constexpr std::uint32_t ABSENT = std::numeric_limits<std::uint32_t>::max();
+
+		std::vector<std::uint32_t> heap;
+		std::vector<std::uint32_t> position;
+		std::vector<KEY> keys;
+
+		void place(size_t slot, std::uint32_t element) {
+			heap[slot] = element;
+			position[element] = static_cast<std::uint32_t>(slot);
+		}
+		void sift_up(size_t slot) {
+			std::uint32_t element = heap[slot];
+			while (slot > 0) {
+				size_t parent = (slot - 1) / D;
+				if (!(keys[element] < keys[heap[parent]])) {
+					break;
+				}
+				place(slot, heap[parent]);
+				slot = parent;
+			}
+			place(slot, element);
+		}
+		void sift_down(size_t slot) {
+			std::uint32_t element = heap[slot];
+			while (true) {
+				size_t first_child = slot * D + 1;
+				if (first_child >= heap.size()) {
+					break;
+				}
+				size_t last_child = std::min(first_child + D, heap.size());
+				size_t best = first_child;
+				for (size_t child = first_child + 1; child < last_child; ++child) {
+					if (keys[heap[child]] < keys[heap[best]]) {
+						best = child;
+					}
+				}
+				if (!(keys[heap[best]] < keys[element])) {
+					break;
+				}
+				place(slot, heap[best]);
+				slot = best;
+			}
+			place(slot, element);
+		}
+	public:
+		explicit IndexedDAryHeap(size_t capacity = 0) : position(capacity, ABSENT), keys(capacity) {}
+
+		//Makes the heap empty and able to hold elements 0 .. capacity-1, keeps allocated memory
+		void reset(size_t capacity) {
+			for (std::uint32_t element : heap) {
+				position[element] = ABSENT;
+			}
+			heap.clear();
+			if (position.size() != capacity) {
+				position.assign(capacity, ABSENT);
+				keys.resize(capacity);
+			}
+		}
+
+		bool empty() const {
+			return heap.empty();
+		}
+		size_t size() const {
+			return heap.size();
+		}
+		bool contains(size_t element) const {
+			return position[element] != ABSENT;
+		}
+		const KEY& key(size_t element) const {
+			return keys[element];
+		}
+		size_t top() const {
+			return heap.front();
+		}
+		const KEY& topKey() const {
+			return keys[heap.front()];
+		}
+
+		void push(size_t element, const KEY& key) {
+			keys[element] = key;
+			heap.push_back(static_cast<std::uint32_t>(element));
+			position[element] = static_cast<std::uint32_t>(heap.size() - 1);
+			sift_up(heap.size() - 1);
+		}
+		//The new key must not be larger than the current one
+		void decrease(size_t element, const KEY& key) {
+			keys[element] = key;
+			sift_up(position[element]);
+		}
+		//Inserts the element or lowers its key. Returns true if the heap changed
+		bool pushOrDecrease(size_t element, const KEY& key) {
+			if (!contains(element)) {
+				push(element, key);
+				return true;
+			}
+			if (key < keys[element]) {
+				decrease(element, key);
+				return true;
+			}
+			return false;
+		}
+		size_t pop() {
+			std::uint32_t result = heap.front();
+			position[result] = ABSENT;
+			std::uint32_t last = heap.back();
+			heap.pop_back();
+			if (!heap.empty()) {
+				place(0, last);
+				sift_down(0);
+			}
+			return result;
+		}
+	};
+}
@@ -1 +1,273 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../exceptions.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
 
+namespace graph_library {
+
+	//Events of a depth-first search. Derive from this struct and hide the events you need:
+	//the engine is a template over the visitor type, so every event is a direct (usually inlined) call
+	struct DfsVisitor {
+		//A new search tree starts at root
+		void start_node(size_t) {}
+		//Pre-order: the node is entered
+		void discover_node(size_t) {}
+		//Post-order: all edges of the node are processed
+		void finish_node(size_t) {}
+		//from -> to leads to an undiscovered node
+		void tree_edge(size_t, size_t) {}
+		//from -> to leads to a node on the current path
+		void back_edge(size_t, size_t) {}
+		//from -> to leads to an already finished node
+		void forward_or_cross_edge(size_t, size_t) {}
+		//The subtree reached by the tree edge from -> to is finished
+		void finish_edge(size_t, size_t) {}
+	};
+
+	//Depth-first search with an explicit stack, so deep graphs can not overflow the call stack.
+	//All memory (colors and a stack of at most V frames) is allocated once in the constructor
+	template <AdjacencyGraph GRAPH>
+	class DepthFirstSearch {
+	private:
+		using edge_range = out_edges_t<GRAPH>;
+		using edge_iterator = std::ranges::iterator_t<edge_range>;
+		using edge_sentinel = std::ranges::sentinel_t<edge_range>;
+
+		enum Color : std::uint8_t { WHITE, GRAY, BLACK };
+
+		struct Frame {
+			size_t index;
+			edge_iterator current;
+			edge_sentinel end;
+		};
+
+		const GRAPH& graph;
+		std::vector<std::uint8_t> colors;
+		std::vector<Frame> stack;
+
+		template <typename VISITOR>
+		void discover(size_t index, VISITOR& visitor) {
+			colors[index] = GRAY;
+			visitor.discover_node(index);
+			//Edge iterators refer to the storage of the graph, not to the temporary range object
+			auto&& edges = graph.outEdges(index);
+			stack.push_back(Frame{ index, std::ranges::begin(edges), std::ranges::end(edges) });
+		}
+	public:
+		explicit DepthFirstSearch(const GRAPH& _graph) : graph(_graph), colors(_graph.getAmountNodes(), WHITE) {
+			stack.reserve(colors.size());
+		}
+
+		//Visits every node reachable from root that was not visited before
+		template <typename VISITOR>
+		void run(size_t root, VISITOR& visitor) {
+			if (root >= colors.size()) {
+				throw InvalidIndexException();
+			}
+			if (colors[root] != WHITE) {
+				return;
+			}
+
+			visitor.start_node(root);
+			discover(root, visitor);
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			while (!stack.empty()) {
+				Frame& frame = stack.back();
+				if (frame.current != frame.end) {
+					size_t from = frame.index;
+					size_t to = (*frame.current).get_to_index();
+					++frame.current;
+					visited.add();
+					if (colors[to] == WHITE) {
+						visitor.tree_edge(from, to);
+						discover(to, visitor);
+					}
+					else if (colors[to] == GRAY) {
+						visitor.back_edge(from, to);
+					}
+					else {
+						visitor.forward_or_cross_edge(from, to);
+					}
+				}
+				else {
+					size_t index = frame.index;
+					colors[index] = BLACK;
+					stack.pop_back();
+					visitor.finish_node(index);
+					if (!stack.empty()) {
+						visitor.finish_edge(stack.back().index, index);
+					}
+				}
+			}
+		}
+		//Visits all nodes, starting new trees in index order. Removed nodes of a Graph are skipped
+		template <typename VISITOR>
+		void runAll(VISITOR& visitor) {
+			for (size_t i = 0; i < colors.size(); ++i) {
+				if (is_node_alive(graph, i)) {
+					run(i, visitor);
+				}
+			}
+		}
+
+		bool visited(size_t index) const {
+			return colors[index] != WHITE;
+		}
+		void reset() {
+			std::fill(colors.begin(), colors.end(), WHITE);
+		}
+	};
+
+	template <AdjacencyGraph GRAPH, typename VISITOR>
+	void dfs(const GRAPH& graph, size_t root, VISITOR& visitor) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::DFS);
+		DepthFirstSearch<GRAPH> search(graph);
+		search.run(root, visitor);
+	}
+	template <AdjacencyGraph GRAPH, typename VISITOR>
+	void dfsAll(const GRAPH& graph, VISITOR& visitor) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::DFS);
+		DepthFirstSearch<GRAPH> search(graph);
+		search.runAll(visitor);
+	}
+
+
+	namespace detail {
+
+		struct PostOrderVisitor : DfsVisitor {
+			std::vector<size_t>& order;
+			bool has_cycle = false;
+
+			explicit PostOrderVisitor(std::vector<size_t>& _order) : order(_order) {}
+			void finish_node(size_t index) {
+				order.push_back(index);
+			}
+			void back_edge(size_t, size_t) {
+				has_cycle = true;
+			}
+		};
+
+		struct CycleVisitor : DfsVisitor {
+			std::vector<size_t> parent;
+			std::vector<size_t> cycle;
+
+			explicit CycleVisitor(size_t amount_nodes) : parent(amount_nodes, std::numeric_limits<size_t>::max()) {}
+			void tree_edge(size_t from, size_t to) {
+				parent[to] = from;
+			}
+			void back_edge(size_t from, size_t to) {
+				if (!cycle.empty()) {
+					return;
+				}
+				for (size_t index = from; index != to; index = parent[index]) {
+					cycle.push_back(index);
+				}
+				cycle.push_back(to);
+				std::reverse(cycle.begin(), cycle.end());
+			}
+		};
+
+		//Tarjan's algorithm on top of the DFS engine
+		struct TarjanVisitor : DfsVisitor {
+			static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+			std::vector<size_t> order;
+			std::vector<size_t> low;
+			std::vector<size_t>& component;
+			std::vector<size_t> stack;
+			size_t counter = 0;
+			size_t amount_components = 0;
+
+			TarjanVisitor(size_t amount_nodes, std::vector<size_t>& _component)
+				: order(amount_nodes, NONE), low(amount_nodes, NONE), component(_component) {
+				stack.reserve(amount_nodes);
+			}
+			void discover_node(size_t index) {
+				order[index] = low[index] = counter++;
+				stack.push_back(index);
+			}
+			void update_low(size_t from, size_t to) {
+				//Only nodes without a component are still on the stack
+				if (component[to] == NONE) {
+					low[from] = std::min(low[from], order[to]);
+				}
+			}
+			void back_edge(size_t from, size_t to) {
+				update_low(from, to);
+			}
+			void forward_or_cross_edge(size_t from, size_t to) {
+				update_low(from, to);
+			}
+			void finish_edge(size_t from, size_t to) {
+				low[from] = std::min(low[from], low[to]);
+			}
+			void finish_node(size_t index) {
+				if (low[index] != order[index]) {
+					return;
+				}
+				size_t member;
+				do {
+					member = stack.back();
+					stack.pop_back();
+					component[member] = amount_components;
+				} while (member != index);
+				++amount_components;
+			}
+		};
+	}
+
+	//Strongly connected components. Components are numbered in reverse topological order
+	//of the condensation: edges between components go from larger to smaller numbers.
+	//Removed nodes of a Graph belong to no component and keep the largest size_t
+	struct SccResult {
+		std::vector<size_t> component;
+		size_t amount = 0;
+	};
+
+	template <AdjacencyGraph GRAPH>
+	SccResult stronglyConnectedComponents(const GRAPH& graph) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::STRONGLY_CONNECTED_COMPONENTS);
+		SccResult result;
+		result.component.assign(graph.getAmountNodes(), detail::TarjanVisitor::NONE);
+		detail::TarjanVisitor visitor(graph.getAmountNodes(), result.component);
+		dfsAll(graph, visitor);
+		result.amount = visitor.amount_components;
+		return result;
+	}
+
+	//Order of nodes in which every edge goes forward, without removed nodes. Throws GraphHasCycleException
+	template <AdjacencyGraph GRAPH>
+	std::vector<size_t> topologicalSort(const GRAPH& graph) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::TOPOLOGICAL_SORT);
+		std::vector<size_t> order;
+		order.reserve(graph.getAmountNodes());
+		detail::PostOrderVisitor visitor(order);
+		dfsAll(graph, visitor);
+		if (visitor.has_cycle) {
+			throw GraphHasCycleException();
+		}
+		std::reverse(order.begin(), order.end());
+		return order;
+	}
+
+	//Nodes of some directed cycle in path order, or an empty vector if the graph is acyclic.
+	//A self-loop is a cycle of one node
+	template <AdjacencyGraph GRAPH>
+	std::vector<size_t> findCycle(const GRAPH& graph) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::FIND_CYCLE);
+		detail::CycleVisitor visitor(graph.getAmountNodes());
+		dfsAll(graph, visitor);
+		return visitor.cycle;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	bool hasCycle(const GRAPH& graph) {
+		return !findCycle(graph).empty();
+	}
+}
@@ -0,0 +1,672 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../exceptions.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "d_ary_heap.hpp"
+#include "radix_heap.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <map>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Parent of the source and of unreached nodes, also "no target" in ShortestPathOptions
+	inline constexpr size_t NO_NODE = std::numeric_limits<size_t>::max();
+
+	//Distance of unreached nodes
+	template <typename WEIGHT_TYPE>
+	constexpr WEIGHT_TYPE unreachable_distance() {
+		if constexpr (std::numeric_limits<WEIGHT_TYPE>::has_infinity) {
+			return std::numeric_limits<WEIGHT_TYPE>::infinity();
+		}
+		else {
+			return std::numeric_limits<WEIGHT_TYPE>::max();
+		}
+	}
+
+	enum class ShortestPathMethod {
+		//DELTA_STEPPING when more than one thread is requested, otherwise
+		//RADIX_HEAP for integer weights and BINARY_HEAP for the rest
+		AUTO,
+		BINARY_HEAP,
+		//Integer weights only, other weight types fall back to BINARY_HEAP
+		RADIX_HEAP,
+		//Parallel bucket-based relaxation (Meyer, Sanders)
+		DELTA_STEPPING
+	};
+	//Unweighted graphs (UnweightedGraph) ignore the method: every edge weighs 1, so a breadth-first
+	//search gives the shortest paths
+
+	struct ShortestPathOptions {
+		ShortestPathMethod method = ShortestPathMethod::AUTO;
+		//Stop as soon as the distance to target is final
+		size_t target = NO_NODE;
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+		//Bucket width of delta-stepping, 0 - average edge weight. At least 1 for integer weights
+		double delta = 0;
+		//Scan all edge weights for negative ones before the search starts, O(E). Without it a negative weight
+		//is reported when the search reaches it, which lets early-exit queries on graphs known to have
+		//non-negative weights skip the scan
+		bool check_weights = true;
+	};
+
+	namespace detail {
+		struct ShortestPathAlgorithms;
+
+		//distance + weight, saturated to unreachable_distance for integer weights instead of overflowing,
+		//so that a path too long for the weight type never improves a distance
+		template <typename WEIGHT_TYPE>
+		constexpr WEIGHT_TYPE add_distance(WEIGHT_TYPE distance, WEIGHT_TYPE weight) {
+			if constexpr (std::is_integral_v<WEIGHT_TYPE>) {
+				if (weight > unreachable_distance<WEIGHT_TYPE>() - distance) {
+					return unreachable_distance<WEIGHT_TYPE>();
+				}
+			}
+			return distance + weight;
+		}
+	}
+
+	//Distances, parents and queues of single-source searches. Reusing one workspace for many
+	//queries on graphs of the same size avoids reallocation: only the entries touched by the
+	//previous query are reset
+	template <typename WEIGHT_TYPE>
+	class ShortestPathWorkspace {
+	private:
+		static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+		std::vector<WEIGHT_TYPE> distances;
+		std::vector<std::uint32_t> parents;
+		std::vector<std::uint32_t> touched;
+		size_t source = NO_NODE;
+
+		IndexedDAryHeap<WEIGHT_TYPE, 2> binary_heap;
+		RadixHeap<std::uint32_t> radix_heap;
+
+		//Delta-stepping state
+		std::unique_ptr<std::atomic<WEIGHT_TYPE>[]> atomic_distances;
+		std::unique_ptr<std::atomic<std::uint32_t>[]> atomic_parents;
+		std::vector<std::uint32_t> stamps;
+		std::uint32_t epoch = 0;
+		size_t atomic_size = 0;
+
+		friend struct detail::ShortestPathAlgorithms;
+
+		void prepare(size_t amount_nodes, size_t _source) {
+			if (distances.size() != amount_nodes) {
+				distances.assign(amount_nodes, unreachable_distance<WEIGHT_TYPE>());
+				parents.assign(amount_nodes, NONE);
+				touched.clear();
+			}
+			for (std::uint32_t index : touched) {
+				distances[index] = unreachable_distance<WEIGHT_TYPE>();
+				parents[index] = NONE;
+			}
+			touched.clear();
+			source = _source;
+			set(_source, WEIGHT_TYPE(), NONE);
+		}
+		void set(size_t index, WEIGHT_TYPE distance, std::uint32_t parent) {
+			if (distances[index] == unreachable_distance<WEIGHT_TYPE>()) {
+				touched.push_back(static_cast<std::uint32_t>(index));
+			}
+			distances[index] = distance;
+			parents[index] = parent;
+		}
+	public:
+		//State of a workspace before any query, left by a query that throws
+		void clear() {
+			for (std::uint32_t index : touched) {
+				distances[index] = unreachable_distance<WEIGHT_TYPE>();
+				parents[index] = NONE;
+			}
+			touched.clear();
+			source = NO_NODE;
+		}
+		size_t getAmountNodes() const {
+			return distances.size();
+		}
+		size_t getSource() const {
+			return source;
+		}
+		bool reached(size_t index) const {
+			return distances[index] != unreachable_distance<WEIGHT_TYPE>();
+		}
+		WEIGHT_TYPE distance(size_t index) const {
+			return distances[index];
+		}
+		size_t parent(size_t index) const {
+			return parents[index] == NONE ? NO_NODE : parents[index];
+		}
+		//Nodes reached by the last query
+		const std::vector<std::uint32_t>& reachedNodes() const {
+			return touched;
+		}
+		//Nodes from the source to target, empty if target was not reached
+		std::vector<size_t> path(size_t target) const {
+			std::vector<size_t> result;
+			if (!reached(target)) {
+				return result;
+			}
+			for (size_t index = target; index != NO_NODE; index = parent(index)) {
+				result.push_back(index);
+			}
+			std::reverse(result.begin(), result.end());
+			return result;
+		}
+	};
+
+	//Workspace of bidirectional searches: a forward search from the source and a backward
+	//search from the target on the reversed graph
+	template <typename WEIGHT_TYPE>
+	class BidirectionalWorkspace {
+	private:
+		ShortestPathWorkspace<WEIGHT_TYPE> forward;
+		ShortestPathWorkspace<WEIGHT_TYPE> backward;
+		size_t meeting = NO_NODE;
+		WEIGHT_TYPE best = unreachable_distance<WEIGHT_TYPE>();
+
+		friend struct detail::ShortestPathAlgorithms;
+	public:
+		void clear() {
+			forward.clear();
+			backward.clear();
+			meeting = NO_NODE;
+			best = unreachable_distance<WEIGHT_TYPE>();
+		}
+		WEIGHT_TYPE distance() const {
+			return best;
+		}
+		//Nodes of a shortest path from the source to the target, empty if there is none
+		std::vector<size_t> path() const {
+			std::vector<size_t> result;
+			if (meeting == NO_NODE) {
+				return result;
+			}
+			result = forward.path(meeting);
+			for (size_t index = backward.parent(meeting); index != NO_NODE; index = backward.parent(index)) {
+				result.push_back(index);
+			}
+			return result;
+		}
+	};
+
+	namespace detail {
+
+		struct ShortestPathAlgorithms {
+			template <typename WEIGHT_TYPE>
+			static void check_weight(WEIGHT_TYPE weight) {
+				if (weight < WEIGHT_TYPE()) {
+					throw GraphException("Shortest path search requires non-negative edge weights");
+				}
+			}
+
+			//Throws before the search if any edge has a negative weight
+			template <AdjacencyGraph GRAPH>
+			static void check_weights(const GRAPH& graph, size_t threads) {
+				using weight_t = edge_weight_t<GRAPH>;
+				if constexpr (std::numeric_limits<weight_t>::is_signed) {
+					std::atomic<bool> negative(false);
+					parallel_for(threads, graph.getAmountNodes(), [&](size_t, size_t begin, size_t end) {
+						for (size_t i = begin; i < end && !negative.load(std::memory_order_relaxed); ++i) {
+							for (const auto& edge : graph.outEdges(i)) {
+								if (edge.get_weight() < weight_t()) {
+									negative.store(true, std::memory_order_relaxed);
+									break;
+								}
+							}
+						}
+						});
+					if (negative.load(std::memory_order_relaxed)) {
+						throw GraphException("Shortest path search requires non-negative edge weights");
+					}
+				}
+			}
+
+			template <AdjacencyGraph GRAPH>
+			static void binary_heap(const GRAPH& graph, size_t source, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace, size_t target) {
+				using weight_t = edge_weight_t<GRAPH>;
+				auto& heap = workspace.binary_heap;
+				heap.reset(graph.getAmountNodes());
+				heap.push(source, weight_t());
+				instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+
+				while (!heap.empty()) {
+					size_t index = heap.pop();
+					if (index == target) {
+						return;
+					}
+					weight_t distance = workspace.distances[index];
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						check_weight(edge.get_weight());
+						size_t to = edge.get_to_index();
+						weight_t candidate = add_distance<weight_t>(distance, edge.get_weight());
+						if (candidate < workspace.distances[to]) {
+							workspace.set(to, candidate, static_cast<std::uint32_t>(index));
+							heap.pushOrDecrease(to, candidate);
+						}
+					}
+				}
+			}
+
+			template <AdjacencyGraph GRAPH>
+			static void radix_heap(const GRAPH& graph, size_t source, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace, size_t target) {
+				using weight_t = edge_weight_t<GRAPH>;
+				auto& heap = workspace.radix_heap;
+				heap.clear();
+				heap.push(0, static_cast<std::uint32_t>(source));
+				instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+
+				while (!heap.empty()) {
+					auto [key, index] = heap.pop();
+					weight_t distance = workspace.distances[index];
+					//Stale entry of a node that was reached again with a smaller distance
+					if (key != static_cast<std::uint64_t>(distance)) {
+						continue;
+					}
+					if (index == target) {
+						return;
+					}
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						check_weight(edge.get_weight());
+						size_t to = edge.get_to_index();
+						weight_t candidate = add_distance<weight_t>(distance, edge.get_weight());
+						if (candidate < workspace.distances[to]) {
+							workspace.set(to, candidate, index);
+							heap.push(static_cast<std::uint64_t>(candidate), static_cast<std::uint32_t>(to));
+						}
+					}
+				}
+			}
+
+			//Breadth-first search for unit weights. The nodes are reached in the order of their distances,
+			//so the touched list of the workspace doubles as the queue
+			template <UnweightedGraph GRAPH>
+			static void unit_weights(const GRAPH& graph, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace, size_t target) {
+				instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+				for (size_t head = 0; head < workspace.touched.size(); ++head) {
+					size_t index = workspace.touched[head];
+					if (index == target) {
+						return;
+					}
+					auto distance = workspace.distances[index] + 1;
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						size_t to = edge.get_to_index();
+						if (!workspace.reached(to)) {
+							workspace.set(to, distance, static_cast<std::uint32_t>(index));
+						}
+					}
+				}
+			}
+
+			template <AdjacencyGraph GRAPH>
+			static edge_weight_t<GRAPH> average_weight(const GRAPH& graph) {
+				using weight_t = edge_weight_t<GRAPH>;
+				constexpr size_t SAMPLE = 4096;
+				double sum = 0;
+				size_t amount = 0;
+				for (size_t i = 0; i < graph.getAmountNodes() && amount < SAMPLE; ++i) {
+					for (const auto& edge : graph.outEdges(i)) {
+						sum += static_cast<double>(edge.get_weight());
+						++amount;
+					}
+				}
+				double average = amount == 0 ? 1.0 : sum / amount;
+				if constexpr (std::is_integral_v<weight_t>) {
+					return std::max<weight_t>(1, static_cast<weight_t>(average));
+				}
+				else {
+					return average > 0 ? static_cast<weight_t>(average) : weight_t(1);
+				}
+			}
+
+			//A width below 1 would make the buckets of integer distances divide by zero
+			template <AdjacencyGraph GRAPH>
+			static edge_weight_t<GRAPH> bucket_width(const GRAPH& graph, const ShortestPathOptions& options) {
+				using weight_t = edge_weight_t<GRAPH>;
+				if (!(options.delta > 0)) {
+					return average_weight(graph);
+				}
+				if constexpr (std::is_integral_v<weight_t>) {
+					if (options.delta >= static_cast<double>(std::numeric_limits<weight_t>::max())) {
+						return std::numeric_limits<weight_t>::max();
+					}
+					return std::max<weight_t>(1, static_cast<weight_t>(options.delta));
+				}
+				else {
+					return static_cast<weight_t>(options.delta);
+				}
+			}
+
+			template <AdjacencyGraph GRAPH>
+			static void delta_stepping(const GRAPH& graph, size_t source, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace, const ShortestPathOptions& options) {
+				using weight_t = edge_weight_t<GRAPH>;
+				constexpr weight_t INF = unreachable_distance<weight_t>();
+				constexpr std::uint32_t NONE = ShortestPathWorkspace<weight_t>::NONE;
+				const size_t amount_nodes = graph.getAmountNodes();
+				const size_t threads = resolve_threads(options.threads);
+				const weight_t delta = bucket_width(graph, options);
+
+				if (workspace.atomic_size != amount_nodes) {
+					workspace.atomic_distances.reset(new std::atomic<weight_t>[amount_nodes]);
+					workspace.atomic_parents.reset(new std::atomic<std::uint32_t>[amount_nodes]);
+					workspace.stamps.assign(amount_nodes, 0);
+					workspace.atomic_size = amount_nodes;
+				}
+				auto* distance = workspace.atomic_distances.get();
+				auto* parent = workspace.atomic_parents.get();
+				auto& stamps = workspace.stamps;
+				parallel_for(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i) {
+						distance[i].store(INF, std::memory_order_relaxed);
+						parent[i].store(NONE, std::memory_order_relaxed);
+					}
+					});
+				distance[source].store(weight_t(), std::memory_order_relaxed);
+
+				auto bucket_of = [delta](weight_t value) {
+					return static_cast<size_t>(value / delta);
+				};
+
+				std::map<size_t, std::vector<std::uint32_t>> buckets;
+				buckets[0].push_back(static_cast<std::uint32_t>(source));
+				std::vector<std::vector<std::uint32_t>> improved(threads);
+				std::vector<std::uint32_t> frontier;
+				std::vector<std::uint32_t> settled;
+				//Epochs keep growing across queries, so stamps never have to be cleared until the counter wraps
+				std::uint32_t& epoch = workspace.epoch;
+				auto next_epoch = [&stamps, &epoch]() {
+					if (++epoch == 0) {
+						std::fill(stamps.begin(), stamps.end(), 0);
+						epoch = 1;
+					}
+				};
+
+				//Relaxes light (weight <= delta) or heavy edges of the nodes and files improved nodes into buckets
+				auto relax = [&](const std::vector<std::uint32_t>& nodes, bool light) {
+					parallel_for(threads, nodes.size(), [&](size_t thread_id, size_t begin, size_t end) {
+						auto& local = improved[thread_id];
+						instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+						for (size_t i = begin; i < end; ++i) {
+							size_t index = nodes[i];
+							weight_t base = distance[index].load(std::memory_order_relaxed);
+							for (const auto& edge : graph.outEdges(index)) {
+								visited.add();
+								weight_t weight = edge.get_weight();
+								if (weight < weight_t()) {
+									continue;
+								}
+								if ((weight <= delta) != light) {
+									continue;
+								}
+								size_t to = edge.get_to_index();
+								weight_t candidate = add_distance(base, weight);
+								weight_t current = distance[to].load(std::memory_order_relaxed);
+								while (candidate < current) {
+									if (distance[to].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+										local.push_back(static_cast<std::uint32_t>(to));
+										break;
+									}
+								}
+							}
+						}
+						});
+					for (auto& local : improved) {
+						for (std::uint32_t index : local) {
+							buckets[bucket_of(distance[index].load(std::memory_order_relaxed))].push_back(index);
+						}
+						local.clear();
+					}
+				};
+
+				while (!buckets.empty()) {
+					auto current = buckets.begin();
+					size_t current_index = current->first;
+					if (options.target != NO_NODE) {
+						weight_t target_distance = distance[options.target].load(std::memory_order_relaxed);
+						if (target_distance != INF && bucket_of(target_distance) < current_index) {
+							break;
+						}
+					}
+
+					settled.clear();
+					while (!current->second.empty()) {
+						next_epoch();
+						frontier.clear();
+						for (std::uint32_t index : current->second) {
+							//Skip duplicates and nodes that have moved to an earlier bucket
+							if (stamps[index] != epoch && bucket_of(distance[index].load(std::memory_order_relaxed)) == current_index) {
+								stamps[index] = epoch;
+								frontier.push_back(index);
+							}
+						}
+						current->second.clear();
+						settled.insert(settled.end(), frontier.begin(), frontier.end());
+						relax(frontier, true);
+					}
+					buckets.erase(current);
+
+					next_epoch();
+					std::erase_if(settled, [&stamps, epoch](std::uint32_t index) {
+						if (stamps[index] == epoch) {
+							return true;
+						}
+						stamps[index] = epoch;
+						return false;
+						});
+					relax(settled, false);
+				}
+
+				//Parents are restored by a traversal of the edges on shortest paths starting at the source.
+				//Taking any such edge would be enough without zero weights, but zero-weight cycles would then become parent cycles
+				std::vector<std::uint32_t> level{ static_cast<std::uint32_t>(source) };
+				std::vector<std::vector<std::uint32_t>> next_parts(threads);
+				std::atomic<bool> negative(false);
+				while (!level.empty()) {
+					for (std::uint32_t index : level) {
+						workspace.set(index, distance[index].load(std::memory_order_relaxed), parent[index].load(std::memory_order_relaxed));
+					}
+					parallel_for(threads, level.size(), [&](size_t thread_id, size_t begin, size_t end) {
+						auto& next = next_parts[thread_id];
+						instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+						for (size_t i = begin; i < end; ++i) {
+							size_t index = level[i];
+							weight_t base = distance[index].load(std::memory_order_relaxed);
+							for (const auto& edge : graph.outEdges(index)) {
+								visited.add();
+								if (edge.get_weight() < weight_t()) {
+									negative.store(true, std::memory_order_relaxed);
+									continue;
+								}
+								size_t to = edge.get_to_index();
+								std::uint32_t expected = NONE;
+								weight_t reached = distance[to].load(std::memory_order_relaxed);
+								if (to != source && reached != INF && add_distance<weight_t>(base, edge.get_weight()) == reached &&
+									parent[to].load(std::memory_order_relaxed) == NONE &&
+									parent[to].compare_exchange_strong(expected, static_cast<std::uint32_t>(index), std::memory_order_relaxed)) {
+									next.push_back(static_cast<std::uint32_t>(to));
+								}
+							}
+						}
+						});
+					level.clear();
+					for (auto& next : next_parts) {
+						level.insert(level.end(), next.begin(), next.end());
+						next.clear();
+					}
+				}
+				if (negative.load(std::memory_order_relaxed)) {
+					throw GraphException("Shortest path search requires non-negative edge weights");
+				}
+			}
+
+			template <AdjacencyGraph GRAPH>
+			static void run(const GRAPH& graph, size_t source, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace, const ShortestPathOptions& options) {
+				using weight_t = edge_weight_t<GRAPH>;
+				workspace.prepare(graph.getAmountNodes(), source);
+				if constexpr (UnweightedGraph<GRAPH>) {
+					unit_weights(graph, workspace, options.target);
+					return;
+				}
+
+				ShortestPathMethod method = options.method;
+				if (method == ShortestPathMethod::AUTO) {
+					if (options.threads != 1) {
+						method = ShortestPathMethod::DELTA_STEPPING;
+					}
+					else {
+						method = std::is_integral_v<weight_t> ? ShortestPathMethod::RADIX_HEAP : ShortestPathMethod::BINARY_HEAP;
+					}
+				}
+
+				if (method == ShortestPathMethod::DELTA_STEPPING) {
+					delta_stepping(graph, source, workspace, options);
+				}
+				else if constexpr (std::is_integral_v<weight_t>) {
+					if (method == ShortestPathMethod::RADIX_HEAP) {
+						radix_heap(graph, source, workspace, options.target);
+					}
+					else {
+						binary_heap(graph, source, workspace, options.target);
+					}
+				}
+				else {
+					binary_heap(graph, source, workspace, options.target);
+				}
+			}
+
+			template <AdjacencyGraph FORWARD, AdjacencyGraph BACKWARD>
+			static void bidirectional(const FORWARD& graph, const BACKWARD& reverse_graph, size_t source, size_t target,
+				BidirectionalWorkspace<edge_weight_t<FORWARD>>& workspace) {
+				using weight_t = edge_weight_t<FORWARD>;
+				constexpr weight_t INF = unreachable_distance<weight_t>();
+				size_t amount_nodes = graph.getAmountNodes();
+
+				auto& forward = workspace.forward;
+				auto& backward = workspace.backward;
+				forward.prepare(amount_nodes, source);
+				backward.prepare(amount_nodes, target);
+				forward.binary_heap.reset(amount_nodes);
+				backward.binary_heap.reset(amount_nodes);
+				forward.binary_heap.push(source, weight_t());
+				backward.binary_heap.push(target, weight_t());
+				workspace.best = source == target ? weight_t() : INF;
+				workspace.meeting = source == target ? source : NO_NODE;
+
+				//Settles one node of the side and updates the best known path through its edges
+				instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+				auto step = [&workspace, &visited](const auto& side_graph, ShortestPathWorkspace<weight_t>& side, const ShortestPathWorkspace<weight_t>& other) {
+					size_t index = side.binary_heap.pop();
+					weight_t distance = side.distances[index];
+					for (const auto& edge : side_graph.outEdges(index)) {
+						visited.add();
+						check_weight(edge.get_weight());
+						size_t to = edge.get_to_index();
+						weight_t candidate = add_distance<weight_t>(distance, edge.get_weight());
+						if (candidate < side.distances[to]) {
+							side.set(to, candidate, static_cast<std::uint32_t>(index));
+							side.binary_heap.pushOrDecrease(to, candidate);
+						}
+						if (side.reached(to) && other.reached(to)) {
+							weight_t through = add_distance(side.distances[to], other.distances[to]);
+							if (through < workspace.best) {
+								workspace.best = through;
+								workspace.meeting = to;
+							}
+						}
+					}
+				};
+
+				while (!forward.binary_heap.empty() && !backward.binary_heap.empty()) {
+					if (workspace.best != INF && !(add_distance(forward.binary_heap.topKey(), backward.binary_heap.topKey()) < workspace.best)) {
+						break;
+					}
+					if (forward.binary_heap.size() <= backward.binary_heap.size()) {
+						step(graph, forward, backward);
+					}
+					else {
+						step(reverse_graph, backward, forward);
+					}
+				}
+			}
+		};
+	}
+
+	//Single-source shortest paths from source (Dijkstra or delta-stepping, see ShortestPathOptions).
+	//Results are read from the workspace, which can be reused for the next query.
+	//Negative edge weights throw GraphException and leave the workspace without results
+	template <AdjacencyGraph GRAPH>
+	void dijkstra(const GRAPH& graph, size_t source, ShortestPathWorkspace<edge_weight_t<GRAPH>>& workspace,
+		const ShortestPathOptions& options = ShortestPathOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::DIJKSTRA);
+		if (source >= graph.getAmountNodes() || (options.target != NO_NODE && options.target >= graph.getAmountNodes())) {
+			throw InvalidIndexException();
+		}
+		try {
+			if constexpr (!UnweightedGraph<GRAPH>) {
+				if (options.check_weights) {
+					detail::ShortestPathAlgorithms::check_weights(graph, options.threads);
+				}
+			}
+			detail::ShortestPathAlgorithms::run(graph, source, workspace, options);
+		}
+		catch (...) {
+			workspace.clear();
+			throw;
+		}
+	}
+
+	//Distances and parents indexed by node index
+	template <typename WEIGHT_TYPE>
+	struct ShortestPaths {
+		std::vector<WEIGHT_TYPE> distance;
+		std::vector<size_t> parent;
+	};
+
+	template <AdjacencyGraph GRAPH>
+	ShortestPaths<edge_weight_t<GRAPH>> dijkstra(const GRAPH& graph, size_t source, const ShortestPathOptions& options = ShortestPathOptions()) {
+		ShortestPathWorkspace<edge_weight_t<GRAPH>> workspace;
+		dijkstra(graph, source, workspace, options);
+
+		ShortestPaths<edge_weight_t<GRAPH>> result;
+		result.distance.resize(graph.getAmountNodes());
+		result.parent.resize(graph.getAmountNodes());
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			result.distance[i] = workspace.distance(i);
+			result.parent[i] = workspace.parent(i);
+		}
+		return result;
+	}
+
+	//Point-to-point search from both ends. reverse_graph must contain every edge of graph reversed
+	//(CompactGraph::transposed); for graphs built with addEdge pass the graph itself.
+	//Returns the distance, the path is available from the workspace. The weights are not scanned in advance,
+	//a negative weight reached by the search throws GraphException and leaves the workspace without results
+	template <AdjacencyGraph FORWARD, AdjacencyGraph BACKWARD>
+	edge_weight_t<FORWARD> bidirectionalDijkstra(const FORWARD& graph, const BACKWARD& reverse_graph, size_t source, size_t target,
+		BidirectionalWorkspace<edge_weight_t<FORWARD>>& workspace) {
+		static_assert(std::is_same_v<edge_weight_t<FORWARD>, edge_weight_t<BACKWARD>>, "Both graphs must have the same weight type");
+		instrumentation::ScopedTimer timer(instrumentation::Operation::BIDIRECTIONAL_DIJKSTRA);
+		if (source >= graph.getAmountNodes() || target >= graph.getAmountNodes() || reverse_graph.getAmountNodes() != graph.getAmountNodes()) {
+			throw InvalidIndexException();
+		}
+		try {
+			detail::ShortestPathAlgorithms::bidirectional(graph, reverse_graph, source, target, workspace);
+		}
+		catch (...) {
+			workspace.clear();
+			throw;
+		}
+		return workspace.distance();
+	}
+}
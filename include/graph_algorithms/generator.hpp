@@ -0,0 +1,112 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Lazy sequence produced by a coroutine with co_yield, the part of std::generator (C++23) the traversals need.
+	//The coroutine starts when the range is iterated and runs only until its next value: breaking out of the loop
+	//(destroying the generator) destroys the coroutine with all its state, no further work is done.
+	//Iterate it once, it is an input range
+	template <typename VALUE>
+	class Generator {
+	public:
+		struct promise_type {
+			//The yielded value lives in the coroutine frame while the coroutine is suspended
+			const VALUE* current = nullptr;
+			std::exception_ptr exception;
+
+			Generator get_return_object() {
+				return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			std::suspend_always initial_suspend() noexcept {
+				return {};
+			}
+			std::suspend_always final_suspend() noexcept {
+				return {};
+			}
+			std::suspend_always yield_value(const VALUE& value) noexcept {
+				current = std::addressof(value);
+				return {};
+			}
+			void return_void() {}
+			void unhandled_exception() {
+				exception = std::current_exception();
+			}
+			//Generators only yield
+			template <typename AWAITABLE>
+			void await_transform(AWAITABLE&&) = delete;
+		};
+
+		class iterator {
+		private:
+			std::coroutine_handle<promise_type> handle = nullptr;
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = VALUE;
+			using difference_type = std::ptrdiff_t;
+			using reference = const VALUE&;
+
+			iterator() = default;
+			explicit iterator(std::coroutine_handle<promise_type> _handle) : handle(_handle) {}
+
+			const VALUE& operator*() const {
+				return *handle.promise().current;
+			}
+			const VALUE* operator->() const {
+				return handle.promise().current;
+			}
+			//Runs the coroutine to its next value, exceptions of the coroutine are thrown here
+			iterator& operator++() {
+				handle.resume();
+				if (handle.done() && handle.promise().exception) {
+					std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+				}
+				return *this;
+			}
+			void operator++(int) {
+				++*this;
+			}
+			bool operator==(std::default_sentinel_t) const {
+				return !handle || handle.done();
+			}
+		};
+
+		Generator(const Generator&) = delete;
+		Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+		~Generator() {
+			if (handle) {
+				handle.destroy();
+			}
+		}
+
+		Generator& operator=(const Generator&) = delete;
+		Generator& operator=(Generator&& other) noexcept {
+			if (&other != this) {
+				if (handle) {
+					handle.destroy();
+				}
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+
+		//Starts the coroutine, call once
+		iterator begin() {
+			iterator result(handle);
+			++result;
+			return result;
+		}
+		std::default_sentinel_t end() const {
+			return std::default_sentinel;
+		}
+	private:
+		std::coroutine_handle<promise_type> handle;
+
+		explicit Generator(std::coroutine_handle<promise_type> _handle) : handle(_handle) {}
+	};
+}
@@ -0,0 +1,313 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GRAPH_LIBRARY_X86_INTERSECTION
+#include <immintrin.h>
+#endif
+
+namespace graph_library {
+
+	//Kernels that count the common elements of two sorted arrays without duplicates. AUTO picks the widest
+	//one the processor supports at run time, a kernel the processor lacks falls back to the widest available
+	enum class IntersectionKernel {
+		AUTO,
+		//Branchless merge
+		SCALAR,
+		//4 x 4 block comparisons (SSE4.2)
+		SSE,
+		//8 x 8 block comparisons (AVX2)
+		AVX2
+	};
+
+	struct IntersectionOptions {
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+		IntersectionKernel kernel = IntersectionKernel::AUTO;
+	};
+
+	namespace detail {
+
+		//With one array this many times longer than the other, every element of the short one
+		//is looked up in the long one by exponential search instead of merging
+		inline constexpr size_t GALLOPING_RATIO = 32;
+
+		inline size_t intersect_scalar(const std::uint32_t* first, size_t amount_first, const std::uint32_t* second, size_t amount_second) {
+			size_t i = 0;
+			size_t j = 0;
+			size_t count = 0;
+			while (i < amount_first && j < amount_second) {
+				std::uint32_t a = first[i];
+				std::uint32_t b = second[j];
+				count += a == b;
+				i += a <= b;
+				j += b <= a;
+			}
+			return count;
+		}
+
+		inline size_t intersect_galloping(const std::uint32_t* small, size_t amount_small, const std::uint32_t* large, size_t amount_large) {
+			size_t count = 0;
+			size_t low = 0;
+			for (size_t i = 0; i < amount_small && low < amount_large; ++i) {
+				std::uint32_t value = small[i];
+				size_t probe = low;
+				for (size_t step = 1; probe < amount_large && large[probe] < value; step *= 2) {
+					low = probe + 1;
+					probe += step;
+				}
+				low = static_cast<size_t>(std::lower_bound(large + low, large + std::min(probe + 1, amount_large), value) - large);
+				if (low < amount_large && large[low] == value) {
+					++count;
+					++low;
+				}
+			}
+			return count;
+		}
+
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+		//Compares a block of each array with every rotation of the other block and advances the block
+		//with the smaller last element, both on a tie. The rest is merged by the scalar kernel
+		__attribute__((target("sse4.2")))
+		inline size_t intersect_sse(const std::uint32_t* first, size_t amount_first, const std::uint32_t* second, size_t amount_second) {
+			size_t i = 0;
+			size_t j = 0;
+			size_t count = 0;
+			const size_t blocks_first = amount_first & ~size_t(3);
+			const size_t blocks_second = amount_second & ~size_t(3);
+			while (i < blocks_first && j < blocks_second) {
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + j));
+				__m128i equal = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))),
+					_mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)))));
+				count += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)))));
+				std::uint32_t last_first = first[i + 3];
+				std::uint32_t last_second = second[j + 3];
+				i += last_first <= last_second ? 4 : 0;
+				j += last_second <= last_first ? 4 : 0;
+			}
+			return count + intersect_scalar(first + i, amount_first - i, second + j, amount_second - j);
+		}
+
+		__attribute__((target("avx2")))
+		inline size_t intersect_avx2(const std::uint32_t* first, size_t amount_first, const std::uint32_t* second, size_t amount_second) {
+			size_t i = 0;
+			size_t j = 0;
+			size_t count = 0;
+			const size_t blocks_first = amount_first & ~size_t(7);
+			const size_t blocks_second = amount_second & ~size_t(7);
+			const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+			while (i < blocks_first && j < blocks_second) {
+				__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+				__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + j));
+				__m256i equal = _mm256_cmpeq_epi32(a, b);
+				for (int k = 1; k < 8; ++k) {
+					b = _mm256_permutevar8x32_epi32(b, rotate);
+					equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(a, b));
+				}
+				count += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)))));
+				std::uint32_t last_first = first[i + 7];
+				std::uint32_t last_second = second[j + 7];
+				i += last_first <= last_second ? 8 : 0;
+				j += last_second <= last_first ? 8 : 0;
+			}
+			return count + intersect_sse(first + i, amount_first - i, second + j, amount_second - j);
+		}
+#endif
+
+		//Widest kernel of this processor, detected once
+		inline IntersectionKernel supported_kernel() {
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+			static const IntersectionKernel kernel = [] {
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx2")) {
+					return IntersectionKernel::AVX2;
+				}
+				if (__builtin_cpu_supports("sse4.2")) {
+					return IntersectionKernel::SSE;
+				}
+				return IntersectionKernel::SCALAR;
+			}();
+			return kernel;
+#else
+			return IntersectionKernel::SCALAR;
+#endif
+		}
+
+		inline IntersectionKernel resolve_kernel(IntersectionKernel kernel) {
+			IntersectionKernel supported = supported_kernel();
+			return kernel == IntersectionKernel::AUTO || kernel > supported ? supported : kernel;
+		}
+
+		//kernel must be resolved
+		inline size_t intersection_size(const std::uint32_t* first, size_t amount_first, const std::uint32_t* second, size_t amount_second,
+			IntersectionKernel kernel)
+		{
+			if (amount_first > amount_second) {
+				std::swap(first, second);
+				std::swap(amount_first, amount_second);
+			}
+			if (amount_first == 0 || first[amount_first - 1] < second[0] || second[amount_second - 1] < first[0]) {
+				return 0;
+			}
+			if (amount_second / amount_first >= GALLOPING_RATIO) {
+				return intersect_galloping(first, amount_first, second, amount_second);
+			}
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+			if (kernel == IntersectionKernel::AVX2) {
+				return intersect_avx2(first, amount_first, second, amount_second);
+			}
+			if (kernel == IntersectionKernel::SSE) {
+				return intersect_sse(first, amount_first, second, amount_second);
+			}
+#endif
+			return intersect_scalar(first, amount_first, second, amount_second);
+		}
+	}
+
+	//Kernel that AUTO stands for on this processor
+	inline IntersectionKernel supportedIntersectionKernel() {
+		return detail::supported_kernel();
+	}
+
+	inline const char* intersectionKernelName(IntersectionKernel kernel) {
+		switch (kernel) {
+		case IntersectionKernel::SCALAR:
+			return "scalar";
+		case IntersectionKernel::SSE:
+			return "sse4.2";
+		case IntersectionKernel::AVX2:
+			return "avx2";
+		default:
+			return "auto";
+		}
+	}
+
+	//Amount of common elements of two sorted arrays without duplicates
+	inline size_t intersectionSize(std::span<const std::uint32_t> first, std::span<const std::uint32_t> second,
+		IntersectionKernel kernel = IntersectionKernel::AUTO)
+	{
+		return detail::intersection_size(first.data(), first.size(), second.data(), second.size(), detail::resolve_kernel(kernel));
+	}
+
+	//Neighbours of every node as sorted arrays without duplicates and self-loops, stored back to back.
+	//Built from outEdges, so an undirected graph has to store every edge in both directions (addEdge)
+	class NeighbourSets {
+	private:
+		std::vector<std::uint64_t> offsets;
+		std::vector<std::uint32_t> targets;
+
+		NeighbourSets(std::vector<std::uint64_t> _offsets, std::vector<std::uint32_t> _targets)
+			: offsets(std::move(_offsets)), targets(std::move(_targets)) {}
+
+		//Sorts the arrays of the nodes, drops duplicates and self-loops and closes the gaps
+		void normalize(size_t threads) {
+			const size_t amount_nodes = offsets.size() - 1;
+			std::vector<std::uint64_t> sizes(amount_nodes);
+			parallel_for_dynamic(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+				for (size_t index = begin; index < end; ++index) {
+					auto first = targets.begin() + static_cast<std::ptrdiff_t>(offsets[index]);
+					auto last = targets.begin() + static_cast<std::ptrdiff_t>(offsets[index + 1]);
+					std::sort(first, last);
+					last = std::unique(first, last);
+					last = std::remove(first, last, static_cast<std::uint32_t>(index));
+					sizes[index] = static_cast<std::uint64_t>(last - first);
+				}
+				});
+
+			std::uint64_t position = 0;
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				auto first = targets.begin() + static_cast<std::ptrdiff_t>(offsets[index]);
+				if (offsets[index] != position) {
+					std::copy(first, first + static_cast<std::ptrdiff_t>(sizes[index]), targets.begin() + static_cast<std::ptrdiff_t>(position));
+				}
+				offsets[index] = position;
+				position += sizes[index];
+			}
+			offsets[amount_nodes] = position;
+			targets.resize(position);
+			targets.shrink_to_fit();
+		}
+	public:
+		NeighbourSets() : offsets(1, 0) {}
+		template <AdjacencyGraph GRAPH>
+		explicit NeighbourSets(const GRAPH& graph, size_t threads = 1) : offsets(graph.getAmountNodes() + 1, 0) {
+			const size_t amount_nodes = graph.getAmountNodes();
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				offsets[index + 1] = offsets[index] + out_degree(graph, index);
+			}
+			targets.resize(offsets[amount_nodes]);
+			parallel_for_dynamic(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+				for (size_t index = begin; index < end; ++index) {
+					std::uint64_t position = offsets[index];
+					for (const auto& edge : graph.outEdges(index)) {
+						targets[position++] = static_cast<std::uint32_t>(edge.get_to_index());
+					}
+				}
+				});
+			normalize(threads);
+		}
+
+		size_t getAmountNodes() const {
+			return offsets.size() - 1;
+		}
+		//Amount of neighbour entries, twice the amount of undirected edges
+		size_t getAmountEntries() const {
+			return targets.size();
+		}
+		size_t degree(size_t index) const {
+			return static_cast<size_t>(offsets[index + 1] - offsets[index]);
+		}
+		std::span<const std::uint32_t> neighbors(size_t index) const {
+			return std::span<const std::uint32_t>(targets.data() + offsets[index], degree(index));
+		}
+
+		//For every node only the neighbours that come later in the order by degree and then index,
+		//so every undirected edge is kept once, at its end of lower degree. Triangle counting over these
+		//sets finds every triangle once and keeps the sets of high-degree nodes short
+		NeighbourSets degreeOriented(size_t threads = 1) const {
+			const size_t amount_nodes = getAmountNodes();
+			auto before = [this](size_t first, size_t second) {
+				size_t degree_first = degree(first);
+				size_t degree_second = degree(second);
+				return degree_first < degree_second || (degree_first == degree_second && first < second);
+			};
+
+			std::vector<std::uint64_t> result_offsets(amount_nodes + 1, 0);
+			parallel_for_dynamic(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+				for (size_t index = begin; index < end; ++index) {
+					for (std::uint32_t to : neighbors(index)) {
+						result_offsets[index + 1] += before(index, to);
+					}
+				}
+				});
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				result_offsets[index + 1] += result_offsets[index];
+			}
+			std::vector<std::uint32_t> result_targets(result_offsets[amount_nodes]);
+			parallel_for_dynamic(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+				for (size_t index = begin; index < end; ++index) {
+					std::uint64_t position = result_offsets[index];
+					for (std::uint32_t to : neighbors(index)) {
+						if (before(index, to)) {
+							result_targets[position++] = to;
+						}
+					}
+				}
+				});
+			return NeighbourSets(std::move(result_offsets), std::move(result_targets));
+		}
+
+		size_t memoryFootprint() const {
+			return offsets.capacity() * sizeof(std::uint64_t) + targets.capacity() * sizeof(std::uint32_t);
+		}
+	};
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "spmv.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstddef>
+
+namespace graph_library {
+
+	struct KatzOptions {
+		//Attenuation of longer walks, has to be below 1 / (largest eigenvalue of the adjacency matrix)
+		double alpha = 0.1;
+		//Base score of every node
+		double beta = 1.0;
+		//Stop once the scores change by less than this in total (L1 norm)
+		double tolerance = 1e-8;
+		size_t max_iterations = 1000;
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+	};
+
+	//Katz centrality: x[v] = beta + alpha * sum of x[u] over the edges u -> v, iterated from x = beta
+	//with pull steps over the in-edges. Every edge counts once, the weights are not used. Removed nodes of a Graph score 0.
+	//Throws when the scores diverge because alpha is too large
+	template <AdjacencyGraph GRAPH>
+	IterativeResult<double> katzCentrality(const GRAPH& graph, const KatzOptions& options = KatzOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::KATZ_CENTRALITY);
+		const ReverseAdjacency<void> reverse(graph);
+		const size_t amount_nodes = reverse.getAmountNodes();
+		const size_t threads = resolve_threads(options.threads);
+
+		//Base score of every node, 0 for removed nodes
+		std::vector<double> base(amount_nodes, options.beta);
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			if (!is_node_alive(graph, index)) {
+				base[index] = 0;
+			}
+		}
+
+		IterativeResult<double> result;
+		result.values = base;
+		std::vector<double> next(amount_nodes);
+		std::vector<double> partial(threads);
+		while (result.iterations < options.max_iterations) {
+			spmv(reverse, std::span<const double>(result.values), std::span<double>(next), PlusSecond<double>(), threads);
+			std::fill(partial.begin(), partial.end(), 0.0);
+			parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+				double change = 0;
+				for (size_t index = begin; index < end; ++index) {
+					next[index] = base[index] + options.alpha * next[index];
+					change += std::abs(next[index] - result.values[index]);
+				}
+				partial[thread_id] = change;
+				});
+			result.values.swap(next);
+			++result.iterations;
+
+			result.residual = 0;
+			for (double change : partial) {
+				result.residual += change;
+			}
+			if (!std::isfinite(result.residual)) {
+				throw GraphException("Katz centrality diverges, alpha has to be below 1 / (largest eigenvalue of the adjacency matrix)");
+			}
+			if (result.residual < options.tolerance) {
+				result.converged = true;
+				break;
+			}
+		}
+		result.converged = result.converged || amount_nodes == 0;
+		return result;
+	}
+}
@@ -1 +1,176 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/edge_record.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "mst_result.hpp"
+#include "parallel.hpp"
+#include "union_find.hpp"
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cstddef>
 
+namespace graph_library {
+
+	struct KruskalOptions {
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+		//Every edge is stored in both directions with the same weight (the graph is built with addEdge), implied for
+		//SymmetricGraph. Then only edges from a smaller to a larger index are taken. Otherwise every edge is taken
+		//as undirected, of edges between the same two nodes the lightest is the one that can join the tree
+		bool symmetric = false;
+		//Edge arrays of at most this size are sorted and scanned directly
+		size_t base_case = 1 << 14;
+	};
+
+	namespace detail {
+
+		template <typename WEIGHT_TYPE, typename SETS>
+		class FilterKruskal {
+		private:
+			using edge_span = std::span<EdgeRecord<WEIGHT_TYPE>>;
+
+			SETS sets;
+			MstResult<WEIGHT_TYPE>& result;
+			size_t amount_nodes;
+			size_t threads;
+			size_t base_case;
+
+			static bool lighter(const EdgeRecord<WEIGHT_TYPE>& first, const EdgeRecord<WEIGHT_TYPE>& second) {
+				return first.weight < second.weight;
+			}
+
+			bool complete() const {
+				return amount_nodes == 0 || result.edges.size() == amount_nodes - 1;
+			}
+
+			void kruskal(edge_span edges) {
+				parallel_sort(edges.begin(), edges.end(), lighter, threads);
+				for (const auto& edge : edges) {
+					if (sets.unite(edge.from, edge.to)) {
+						result.edges.push_back(edge);
+						if (complete()) {
+							return;
+						}
+					}
+				}
+			}
+
+			//Median weight of a small sample
+			WEIGHT_TYPE pick_pivot(edge_span edges) const {
+				constexpr size_t SAMPLE = 31;
+				std::vector<WEIGHT_TYPE> sample;
+				sample.reserve(SAMPLE);
+				for (size_t i = 0; i < SAMPLE; ++i) {
+					sample.push_back(edges[(edges.size() - 1) * i / (SAMPLE - 1)].weight);
+				}
+				std::nth_element(sample.begin(), sample.begin() + SAMPLE / 2, sample.end());
+				return sample[SAMPLE / 2];
+			}
+
+			//Removes edges inside one component, every thread compacts its own block. Returns the new size
+			size_t filter(edge_span edges) {
+				size_t blocks = std::max<size_t>(1, std::min(resolve_threads(threads), edges.size() / 4096));
+				std::vector<size_t> kept(blocks, 0);
+				parallel_for(blocks, blocks, [&](size_t, size_t begin, size_t end) {
+					for (size_t block = begin; block < end; ++block) {
+						size_t from = edges.size() * block / blocks;
+						size_t to = edges.size() * (block + 1) / blocks;
+						size_t write = from;
+						for (size_t read = from; read < to; ++read) {
+							if (!sets.connected(edges[read].from, edges[read].to)) {
+								edges[write++] = edges[read];
+							}
+						}
+						kept[block] = write - from;
+					}
+					});
+
+				size_t write = kept[0];
+				for (size_t block = 1; block < blocks; ++block) {
+					size_t from = edges.size() * block / blocks;
+					std::move(edges.begin() + from, edges.begin() + from + kept[block], edges.begin() + write);
+					write += kept[block];
+				}
+				return write;
+			}
+		public:
+			FilterKruskal(size_t _amount_nodes, MstResult<WEIGHT_TYPE>& _result, size_t _threads, size_t _base_case)
+				: sets(_amount_nodes), result(_result), amount_nodes(_amount_nodes), threads(_threads), base_case(std::max<size_t>(_base_case, 32)) {}
+
+			void run(edge_span edges) {
+				if (complete() || edges.empty()) {
+					return;
+				}
+				if (edges.size() <= base_case) {
+					kruskal(edges);
+					return;
+				}
+
+				WEIGHT_TYPE pivot = pick_pivot(edges);
+				auto middle = std::partition(edges.begin(), edges.end(), [&pivot](const EdgeRecord<WEIGHT_TYPE>& edge) {
+					return !(pivot < edge.weight);
+					});
+				if (middle == edges.end()) {
+					middle = std::partition(edges.begin(), edges.end(), [&pivot](const EdgeRecord<WEIGHT_TYPE>& edge) {
+						return edge.weight < pivot;
+						});
+					//All weights are equal
+					if (middle == edges.begin()) {
+						kruskal(edges);
+						return;
+					}
+				}
+
+				size_t light = static_cast<size_t>(middle - edges.begin());
+				run(edges.first(light));
+				if (complete()) {
+					return;
+				}
+				edge_span heavy = edges.subspan(light);
+				run(heavy.first(filter(heavy)));
+			}
+		};
+	}
+
+	//Filter-Kruskal (Osipov, Sanders, Singler) over a flat edge array. The edge array is reordered.
+	//With more than one thread the base cases use a parallel sort and the filtering steps
+	//use the lock-free ConcurrentUnionFind
+	template <typename WEIGHT_TYPE>
+	MstResult<WEIGHT_TYPE> kruskal(size_t amount_nodes, std::vector<EdgeRecord<WEIGHT_TYPE>>& edges, const KruskalOptions& options = KruskalOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::KRUSKAL);
+		MstResult<WEIGHT_TYPE> result;
+		result.edges.reserve(amount_nodes == 0 ? 0 : amount_nodes - 1);
+
+		size_t threads = resolve_threads(options.threads);
+		if (threads == 1) {
+			detail::FilterKruskal<WEIGHT_TYPE, UnionFind> algorithm(amount_nodes, result, threads, options.base_case);
+			algorithm.run(edges);
+		}
+		else {
+			detail::FilterKruskal<WEIGHT_TYPE, ConcurrentUnionFind> algorithm(amount_nodes, result, threads, options.base_case);
+			algorithm.run(edges);
+		}
+
+		for (const auto& edge : result.edges) {
+			result.total_weight += edge.weight;
+		}
+		result.amount_trees = amount_nodes - result.edges.size();
+		return result;
+	}
+
+	//Minimum spanning forest of the graph, edges are taken as undirected. Self-loops are ignored
+	template <AdjacencyGraph GRAPH>
+	MstResult<edge_weight_t<GRAPH>> kruskal(const GRAPH& graph, const KruskalOptions& options = KruskalOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::KRUSKAL);
+		const bool symmetric = options.symmetric || SymmetricGraph<GRAPH>;
+		auto edges = collectEdges(graph, symmetric);
+		if (!symmetric) {
+			std::erase_if(edges, [](const auto& edge) { return edge.from == edge.to; });
+		}
+		auto result = kruskal(graph.getAmountNodes(), edges, options);
+		//Slots of removed nodes have no edges and would each count as a tree
+		result.amount_trees -= graph.getAmountNodes() - amount_live_nodes(graph);
+		return result;
+	}
+}
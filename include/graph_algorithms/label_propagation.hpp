@@ -0,0 +1,77 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "spmv.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Label of the slot of a removed node, larger than every label so that no node takes it
+	inline constexpr std::uint32_t NO_LABEL = std::numeric_limits<std::uint32_t>::max();
+
+	struct LabelPropagationOptions {
+		//0 - until no label changes
+		size_t max_iterations = 0;
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+	};
+
+	//Every node starts with its index as label and then takes the smallest label among itself and the
+	//targets of its edges until no label changes, one spmv over the (min, second) semiring per iteration.
+	//The labels of an undirected graph (every edge in both directions) are then its connected components,
+	//named by their smallest node; in a directed graph a node ends with the smallest node it can reach.
+	//Removed nodes of a Graph get the label NO_LABEL. residual is the amount of labels changed by the last iteration
+	template <AdjacencyGraph GRAPH>
+	IterativeResult<std::uint32_t> labelPropagation(const GRAPH& graph, const LabelPropagationOptions& options = LabelPropagationOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::LABEL_PROPAGATION);
+		const size_t amount_nodes = graph.getAmountNodes();
+		if (amount_nodes >= std::numeric_limits<std::uint32_t>::max()) {
+			throw GraphException("Too many nodes for label propagation");
+		}
+		const size_t threads = resolve_threads(options.threads);
+
+		IterativeResult<std::uint32_t> result;
+		result.values.resize(amount_nodes);
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			result.values[index] = is_node_alive(graph, index) ? static_cast<std::uint32_t>(index) : NO_LABEL;
+		}
+		std::vector<std::uint32_t> next(amount_nodes);
+		std::vector<size_t> partial(threads);
+		while (options.max_iterations == 0 || result.iterations < options.max_iterations) {
+			spmv(graph, std::span<const std::uint32_t>(result.values), std::span<std::uint32_t>(next), MinSecond<std::uint32_t>(), threads);
+			std::fill(partial.begin(), partial.end(), 0);
+			parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+				size_t changed = 0;
+				for (size_t index = begin; index < end; ++index) {
+					if (next[index] < result.values[index]) {
+						++changed;
+					}
+					else {
+						next[index] = result.values[index];
+					}
+				}
+				partial[thread_id] = changed;
+				});
+			result.values.swap(next);
+			++result.iterations;
+
+			size_t changed = 0;
+			for (size_t amount : partial) {
+				changed += amount;
+			}
+			result.residual = static_cast<double>(changed);
+			if (changed == 0) {
+				result.converged = true;
+				break;
+			}
+		}
+		result.converged = result.converged || amount_nodes == 0;
+		return result;
+	}
+}
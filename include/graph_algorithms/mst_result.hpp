@@ -0,0 +1,16 @@
+#pragma once
+#include "../graph_core/edge_record.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Minimum spanning forest: one minimum spanning tree per connected component
+	template <typename WEIGHT_TYPE>
+	struct MstResult {
+		std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+		WEIGHT_TYPE total_weight = WEIGHT_TYPE();
+		//Trees of the forest, an isolated node is a tree of its own and removed nodes of a Graph are not counted
+		size_t amount_trees = 0;
+	};
+}
@@ -0,0 +1,264 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "bfs.hpp"
+#include "intersection.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	struct MultiSourceBfsOptions {
+		//1 - single thread, 0 - all hardware threads. Every thread runs whole batches
+		size_t threads = 1;
+		//Sources searched together in one pass over the edges: 64, 128 or 256
+		size_t batch_size = 64;
+		//Use AVX2 for batches of 256 when the processor supports it
+		bool vectorized = true;
+	};
+
+	//Aggregates of the hop distances from one source
+	struct HopStatistics {
+		//Nodes reachable from the source, the source included
+		size_t reached = 0;
+		size_t distance_sum = 0;
+		//Largest distance to a reachable node
+		size_t eccentricity = 0;
+		//(reached - 1) / distance_sum, the closeness within the reachable part; 0 if nothing else is reachable
+		double closeness = 0;
+	};
+
+	namespace detail {
+
+		//One bit per source of a batch
+		template <size_t WORDS>
+		struct SourceBits {
+			std::uint64_t words[WORDS];
+		};
+
+		template <size_t WORDS>
+		struct MultiSourceBfsWorkspace {
+			//Sources that reached the node, sources that reached it in the last level, sources reaching it in the next level
+			std::vector<SourceBits<WORDS>> seen;
+			std::vector<SourceBits<WORDS>> visit;
+			std::vector<SourceBits<WORDS>> next;
+
+			void reset(size_t amount_nodes) {
+				seen.assign(amount_nodes, SourceBits<WORDS>{});
+				visit.assign(amount_nodes, SourceBits<WORDS>{});
+				next.assign(amount_nodes, SourceBits<WORDS>{});
+			}
+		};
+
+		//Calls report(slot) for every set bit
+		template <size_t WORDS, typename REPORT>
+		void for_each_source(const SourceBits<WORDS>& bits, REPORT&& report) {
+			for (size_t word = 0; word < WORDS; ++word) {
+				for (std::uint64_t rest = bits.words[word]; rest != 0; rest &= rest - 1) {
+					report(word * 64 + static_cast<size_t>(std::countr_zero(rest)));
+				}
+			}
+		}
+
+		//One level of all searches of the batch: the frontier of every node is pushed along its edges into next,
+		//then the bits a node has not seen before become its frontier. report(node, bits) gets the new bits.
+		//Returns false once no search reached a new node
+		template <size_t WORDS, AdjacencyGraph GRAPH, typename REPORT>
+		bool ms_bfs_level(const GRAPH& graph, MultiSourceBfsWorkspace<WORDS>& workspace, REPORT& report) {
+			const size_t amount_nodes = graph.getAmountNodes();
+			auto& seen = workspace.seen;
+			auto& visit = workspace.visit;
+			auto& next = workspace.next;
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				std::uint64_t any = 0;
+				for (size_t word = 0; word < WORDS; ++word) {
+					any |= visit[index].words[word];
+				}
+				if (any == 0) {
+					continue;
+				}
+				for (const auto& edge : graph.outEdges(index)) {
+					visited.add();
+					auto& target = next[edge.get_to_index()];
+					for (size_t word = 0; word < WORDS; ++word) {
+						target.words[word] |= visit[index].words[word];
+					}
+				}
+			}
+
+			bool reached = false;
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				std::uint64_t any = 0;
+				for (size_t word = 0; word < WORDS; ++word) {
+					std::uint64_t fresh = next[index].words[word] & ~seen[index].words[word];
+					seen[index].words[word] |= fresh;
+					visit[index].words[word] = fresh;
+					next[index].words[word] = 0;
+					any |= fresh;
+				}
+				if (any != 0) {
+					reached = true;
+					report(index, visit[index]);
+				}
+			}
+			return reached;
+		}
+
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+		//ms_bfs_level for batches of 256 with one AVX2 register per node
+		template <AdjacencyGraph GRAPH, typename REPORT>
+		__attribute__((target("avx2")))
+		bool ms_bfs_level_avx2(const GRAPH& graph, MultiSourceBfsWorkspace<4>& workspace, REPORT& report) {
+			const size_t amount_nodes = graph.getAmountNodes();
+			auto* seen = reinterpret_cast<__m256i*>(workspace.seen.data());
+			auto* visit = reinterpret_cast<__m256i*>(workspace.visit.data());
+			auto* next = reinterpret_cast<__m256i*>(workspace.next.data());
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				__m256i frontier = _mm256_loadu_si256(visit + index);
+				if (_mm256_testz_si256(frontier, frontier)) {
+					continue;
+				}
+				for (const auto& edge : graph.outEdges(index)) {
+					visited.add();
+					__m256i* target = next + edge.get_to_index();
+					_mm256_storeu_si256(target, _mm256_or_si256(_mm256_loadu_si256(target), frontier));
+				}
+			}
+
+			bool reached = false;
+			const __m256i zero = _mm256_setzero_si256();
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				__m256i old_seen = _mm256_loadu_si256(seen + index);
+				__m256i fresh = _mm256_andnot_si256(old_seen, _mm256_loadu_si256(next + index));
+				_mm256_storeu_si256(seen + index, _mm256_or_si256(old_seen, fresh));
+				_mm256_storeu_si256(visit + index, fresh);
+				_mm256_storeu_si256(next + index, zero);
+				if (!_mm256_testz_si256(fresh, fresh)) {
+					reached = true;
+					report(index, workspace.visit[index]);
+				}
+			}
+			return reached;
+		}
+#endif
+
+		//Runs the searches from sources in batches of 64 * WORDS and calls report(source_position, node, depth)
+		//once for every node reachable from every source. Batches go to the threads in turn
+		template <size_t WORDS, AdjacencyGraph GRAPH, typename REPORT>
+		void multi_source_bfs_batches(const GRAPH& graph, const std::vector<size_t>& sources, const MultiSourceBfsOptions& options, REPORT& report) {
+			constexpr size_t BATCH = 64 * WORDS;
+			const size_t amount_nodes = graph.getAmountNodes();
+			const size_t amount_batches = (sources.size() + BATCH - 1) / BATCH;
+			bool avx2 = false;
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+			avx2 = WORDS == 4 && options.vectorized && supported_kernel() == IntersectionKernel::AVX2;
+#endif
+			std::vector<MultiSourceBfsWorkspace<WORDS>> workspaces(resolve_threads(options.threads));
+			parallel_for_dynamic(options.threads, amount_batches, [&](size_t thread_id, size_t begin, size_t end) {
+				auto& workspace = workspaces[thread_id];
+				for (size_t batch = begin; batch < end; ++batch) {
+					const size_t first = batch * BATCH;
+					const size_t amount = std::min(BATCH, sources.size() - first);
+					workspace.reset(amount_nodes);
+					for (size_t slot = 0; slot < amount; ++slot) {
+						size_t source = sources[first + slot];
+						workspace.seen[source].words[slot / 64] |= std::uint64_t(1) << (slot % 64);
+						workspace.visit[source].words[slot / 64] |= std::uint64_t(1) << (slot % 64);
+						report(first + slot, source, size_t(0));
+					}
+
+					size_t depth = 1;
+					auto report_level = [&](size_t index, const SourceBits<WORDS>& fresh) {
+						for_each_source(fresh, [&](size_t slot) {
+							report(first + slot, index, depth);
+							});
+					};
+					while (true) {
+						bool reached;
+#ifdef GRAPH_LIBRARY_X86_INTERSECTION
+						if constexpr (WORDS == 4) {
+							reached = avx2 ? ms_bfs_level_avx2(graph, workspace, report_level) : ms_bfs_level(graph, workspace, report_level);
+						}
+						else {
+							reached = ms_bfs_level(graph, workspace, report_level);
+						}
+#else
+						reached = ms_bfs_level(graph, workspace, report_level);
+#endif
+						if (!reached) {
+							break;
+						}
+						++depth;
+					}
+				}
+				}, 1);
+		}
+
+		template <AdjacencyGraph GRAPH, typename REPORT>
+		void multi_source_bfs(const GRAPH& graph, const std::vector<size_t>& sources, const MultiSourceBfsOptions& options, REPORT& report) {
+			for (size_t source : sources) {
+				if (source >= graph.getAmountNodes()) {
+					throw InvalidIndexException();
+				}
+			}
+			switch (options.batch_size) {
+			case 64:
+				multi_source_bfs_batches<1>(graph, sources, options, report);
+				break;
+			case 128:
+				multi_source_bfs_batches<2>(graph, sources, options, report);
+				break;
+			case 256:
+				multi_source_bfs_batches<4>(graph, sources, options, report);
+				break;
+			default:
+				throw GraphException("Multi-source BFS batches hold 64, 128 or 256 sources");
+			}
+		}
+	}
+
+	//Hop distances from many sources at once (MS-BFS): the searches of a batch share every scan of the edges,
+	//each node keeps one bit per search of the batch. Returns the distances from sources[i] in result[i],
+	//BFS_UNREACHED for unreachable nodes, the same as bfs(graph, sources[i]).distance
+	template <AdjacencyGraph GRAPH>
+	std::vector<std::vector<size_t>> multiSourceBfs(const GRAPH& graph, const std::vector<size_t>& sources,
+		const MultiSourceBfsOptions& options = MultiSourceBfsOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::MULTI_SOURCE_BFS);
+		std::vector<std::vector<size_t>> result(sources.size(), std::vector<size_t>(graph.getAmountNodes(), BFS_UNREACHED));
+		auto report = [&result](size_t position, size_t index, size_t depth) {
+			result[position][index] = depth;
+		};
+		detail::multi_source_bfs(graph, sources, options, report);
+		return result;
+	}
+
+	//Closeness and eccentricity of the sources from batched searches, without the memory of the distance arrays
+	template <AdjacencyGraph GRAPH>
+	std::vector<HopStatistics> hopStatistics(const GRAPH& graph, const std::vector<size_t>& sources,
+		const MultiSourceBfsOptions& options = MultiSourceBfsOptions())
+	{
+		instrumentation::ScopedTimer timer(instrumentation::Operation::MULTI_SOURCE_BFS);
+		std::vector<HopStatistics> result(sources.size());
+		auto report = [&result](size_t position, size_t, size_t depth) {
+			HopStatistics& statistics = result[position];
+			++statistics.reached;
+			statistics.distance_sum += depth;
+			statistics.eccentricity = std::max(statistics.eccentricity, depth);
+		};
+		detail::multi_source_bfs(graph, sources, options, report);
+		for (auto& statistics : result) {
+			if (statistics.distance_sum != 0) {
+				statistics.closeness = static_cast<double>(statistics.reached - 1) / static_cast<double>(statistics.distance_sum);
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "spmv.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	struct PageRankOptions {
+		//Probability of following an edge instead of teleporting
+		double damping = 0.85;
+		//Stop once the ranks change by less than this in total (L1 norm)
+		double tolerance = 1e-8;
+		size_t max_iterations = 100;
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+	};
+
+	//PageRank by pull iterations: the in-edges are built once, every iteration spreads the shares
+	//rank / out-degree with spmv into a second buffer and the two buffers are swapped. The rank of nodes
+	//without out-edges (dangling nodes) is handed out like the teleports, uniformly or to the sources of a
+	//personalized run. Removed nodes of a Graph get neither teleports nor rank. VALUE = float halves the memory
+	//traffic of the iterations, with ranks precise to about 1e-7 of their size. The engine can be run many times, the buffers are reused
+	template <typename VALUE = double>
+	class PageRank {
+	private:
+		ReverseAdjacency<void> reverse;
+		std::vector<VALUE> rank;
+		std::vector<VALUE> next;
+		std::vector<VALUE> shares;
+		//Teleport probability of every node for a personalized run
+		std::vector<VALUE> teleport;
+		//Flags the slots of removed nodes, empty if the graph has none
+		std::vector<std::uint8_t> removed;
+		size_t amount_live = 0;
+
+		IterativeResult<VALUE> iterate(const PageRankOptions& options, bool personalized) {
+			const size_t amount_nodes = reverse.getAmountNodes();
+			const size_t threads = resolve_threads(options.threads);
+			const double damping = options.damping;
+			const VALUE uniform = static_cast<VALUE>(1.0 / static_cast<double>(amount_live));
+			auto teleport_of = [&](size_t index) {
+				if (personalized) {
+					return teleport[index];
+				}
+				return removed.empty() || !removed[index] ? uniform : VALUE();
+			};
+
+			IterativeResult<VALUE> result;
+			std::vector<double> partial(threads);
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				rank[index] = teleport_of(index);
+			}
+			while (result.iterations < options.max_iterations) {
+				std::fill(partial.begin(), partial.end(), 0.0);
+				parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+					double dangling = 0;
+					for (size_t index = begin; index < end; ++index) {
+						size_t degree = reverse.outDegree(index);
+						if (degree == 0) {
+							dangling += static_cast<double>(rank[index]);
+							shares[index] = VALUE();
+						}
+						else {
+							shares[index] = rank[index] / static_cast<VALUE>(degree);
+						}
+					}
+					partial[thread_id] = dangling;
+					});
+				double dangling = 0;
+				for (double sum : partial) {
+					dangling += sum;
+				}
+
+				spmv(reverse, std::span<const VALUE>(shares), std::span<VALUE>(next), PlusSecond<VALUE>(), threads);
+
+				std::fill(partial.begin(), partial.end(), 0.0);
+				parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+					double change = 0;
+					for (size_t index = begin; index < end; ++index) {
+						double jump = static_cast<double>(teleport_of(index));
+						VALUE value = static_cast<VALUE>((1.0 - damping) * jump + damping * (static_cast<double>(next[index]) + dangling * jump));
+						change += std::abs(static_cast<double>(value) - static_cast<double>(rank[index]));
+						next[index] = value;
+					}
+					partial[thread_id] = change;
+					});
+				rank.swap(next);
+				++result.iterations;
+
+				result.residual = 0;
+				for (double change : partial) {
+					result.residual += change;
+				}
+				if (result.residual < options.tolerance) {
+					result.converged = true;
+					break;
+				}
+			}
+			result.values = rank;
+			return result;
+		}
+
+		void check_options(const PageRankOptions& options) const {
+			if (!(options.damping >= 0 && options.damping < 1)) {
+				throw GraphException("PageRank damping has to be in [0, 1)");
+			}
+		}
+	public:
+		template <AdjacencyGraph GRAPH>
+		explicit PageRank(const GRAPH& graph)
+			: reverse(graph), rank(graph.getAmountNodes()), next(graph.getAmountNodes()), shares(graph.getAmountNodes()), amount_live(amount_live_nodes(graph))
+		{
+			if (amount_live != graph.getAmountNodes()) {
+				removed.resize(graph.getAmountNodes());
+				for (size_t index = 0; index < graph.getAmountNodes(); ++index) {
+					removed[index] = !is_node_alive(graph, index);
+				}
+			}
+		}
+
+		size_t getAmountNodes() const {
+			return reverse.getAmountNodes();
+		}
+		const ReverseAdjacency<void>& getReverseAdjacency() const {
+			return reverse;
+		}
+
+		IterativeResult<VALUE> run(const PageRankOptions& options = PageRankOptions()) {
+			instrumentation::ScopedTimer timer(instrumentation::Operation::PAGERANK);
+			check_options(options);
+			if (amount_live == 0) {
+				IterativeResult<VALUE> result;
+				result.values.assign(getAmountNodes(), VALUE());
+				result.converged = true;
+				return result;
+			}
+			return iterate(options, false);
+		}
+		//Personalized PageRank: teleports and the rank of dangling nodes go to the sources only,
+		//a source given several times gets a larger share. A removed node is not a valid source
+		IterativeResult<VALUE> runPersonalized(const std::vector<size_t>& sources, const PageRankOptions& options = PageRankOptions()) {
+			instrumentation::ScopedTimer timer(instrumentation::Operation::PAGERANK);
+			check_options(options);
+			if (sources.empty()) {
+				throw GraphException("Personalized PageRank needs at least one source");
+			}
+			teleport.assign(getAmountNodes(), VALUE());
+			for (size_t source : sources) {
+				if (source >= getAmountNodes() || (!removed.empty() && removed[source])) {
+					throw InvalidIndexException();
+				}
+				teleport[source] += static_cast<VALUE>(1.0 / static_cast<double>(sources.size()));
+			}
+			return iterate(options, true);
+		}
+	};
+
+	//One PageRank run, see PageRank for repeated runs on the same graph
+	template <typename VALUE = double, AdjacencyGraph GRAPH>
+	IterativeResult<VALUE> pageRank(const GRAPH& graph, const PageRankOptions& options = PageRankOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::PAGERANK);
+		PageRank<VALUE> engine(graph);
+		return engine.run(options);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Number of threads used when an algorithm is asked for 0 threads
+	inline size_t hardware_threads() {
+		size_t amount = std::thread::hardware_concurrency();
+		return amount == 0 ? 1 : amount;
+	}
+
+	inline size_t resolve_threads(size_t threads) {
+		return threads == 0 ? hardware_threads() : threads;
+	}
+
+	//Splits [0, amount) into one contiguous block per thread and calls function(thread_id, begin, end).
+	//Block boundaries are multiples of alignment, so blocks of a bitmap never share a word.
+	//The calling thread runs the first block itself
+	template <typename Function>
+	void parallel_for(size_t threads, size_t amount, Function&& function, size_t alignment = 1) {
+		threads = std::max<size_t>(1, std::min(resolve_threads(threads), (amount + alignment - 1) / alignment));
+		if (threads == 1) {
+			function(size_t(0), size_t(0), amount);
+			return;
+		}
+
+		size_t blocks = (amount + alignment - 1) / alignment;
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		for (size_t t = 1; t < threads; ++t) {
+			size_t begin = std::min(amount, blocks * t / threads * alignment);
+			size_t end = std::min(amount, blocks * (t + 1) / threads * alignment);
+			workers.emplace_back([&function, t, begin, end] { function(t, begin, end); });
+		}
+		function(size_t(0), size_t(0), std::min(amount, blocks / threads * alignment));
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+
+	//Like parallel_for, but the threads take chunks of [0, amount) from a shared counter until none are left.
+	//For loops whose iterations differ a lot in cost, such as per-node work on graphs with skewed degrees
+	template <typename Function>
+	void parallel_for_dynamic(size_t threads, size_t amount, Function&& function, size_t chunk = 64) {
+		chunk = std::max<size_t>(1, chunk);
+		threads = std::max<size_t>(1, std::min(resolve_threads(threads), (amount + chunk - 1) / chunk));
+		if (threads == 1) {
+			function(size_t(0), size_t(0), amount);
+			return;
+		}
+
+		std::atomic<size_t> next(0);
+		parallel_for(threads, threads, [&](size_t thread_id, size_t, size_t) {
+			for (size_t begin = next.fetch_add(chunk, std::memory_order_relaxed); begin < amount;
+				begin = next.fetch_add(chunk, std::memory_order_relaxed)) {
+				function(thread_id, begin, std::min(amount, begin + chunk));
+			}
+			});
+	}
+
+	//Sorts the range with one std::sort per thread followed by rounds of parallel pairwise merges
+	template <typename Iterator, typename Compare>
+	void parallel_sort(Iterator first, Iterator last, Compare compare, size_t threads = 0) {
+		size_t amount = static_cast<size_t>(std::distance(first, last));
+		threads = std::min(resolve_threads(threads), std::max<size_t>(1, amount / 4096));
+		if (threads <= 1) {
+			std::sort(first, last, compare);
+			return;
+		}
+
+		std::vector<size_t> bounds(threads + 1);
+		for (size_t t = 0; t <= threads; ++t) {
+			bounds[t] = amount * t / threads;
+		}
+		parallel_for(threads, threads, [&](size_t, size_t begin, size_t end) {
+			for (size_t t = begin; t < end; ++t) {
+				std::sort(first + bounds[t], first + bounds[t + 1], compare);
+			}
+			});
+
+		for (size_t width = 1; width < threads; width *= 2) {
+			size_t merges = (threads + 2 * width - 1) / (2 * width);
+			parallel_for(merges, merges, [&](size_t, size_t begin, size_t end) {
+				for (size_t m = begin; m < end; ++m) {
+					size_t left = m * 2 * width;
+					size_t middle = std::min(left + width, threads);
+					size_t right = std::min(left + 2 * width, threads);
+					if (middle < right) {
+						std::inplace_merge(first + bounds[left], first + bounds[middle], first + bounds[right], compare);
+					}
+				}
+				});
+		}
+	}
+}
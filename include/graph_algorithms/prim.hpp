@@ -1 +1,208 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/edge_record.hpp"
+#include "mst_result.hpp"
+#include "d_ary_heap.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
 
+namespace graph_library {
+
+	enum class PrimMode {
+		//Dense when E / V^2 is above PrimOptions::dense_threshold, heap otherwise
+		AUTO,
+		//Indexed d-ary heap with decrease-key, O(E log V)
+		HEAP,
+		//Array scan for the closest node, O(V^2 + E)
+		DENSE
+	};
+
+	struct PrimOptions {
+		PrimMode mode = PrimMode::AUTO;
+		//E counts both directions of every edge. With random weights the heap variant does few
+		//decrease-keys and the array scan only wins on nearly complete graphs (benchmarks/prim_crossover.cpp)
+		double dense_threshold = 0.9;
+	};
+
+	namespace detail {
+
+		//Closest tree node and the weight of the edge to it, for every node outside the tree
+		template <typename WEIGHT_TYPE>
+		struct PrimState {
+			static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+			std::vector<std::uint8_t> in_tree;
+			std::vector<std::uint32_t> parent;
+			std::vector<WEIGHT_TYPE> best;
+
+			explicit PrimState(size_t amount_nodes) : in_tree(amount_nodes, 0), parent(amount_nodes, NONE), best(amount_nodes) {}
+
+			void add(size_t index, MstResult<WEIGHT_TYPE>& result) {
+				in_tree[index] = 1;
+				if (parent[index] != NONE) {
+					result.edges.push_back({ parent[index], static_cast<std::uint32_t>(index), best[index] });
+					result.total_weight += best[index];
+				}
+				else {
+					++result.amount_trees;
+				}
+			}
+		};
+
+		template <AdjacencyGraph GRAPH, size_t D = 4>
+		void prim_heap(const GRAPH& graph, MstResult<edge_weight_t<GRAPH>>& result) {
+			using weight_t = edge_weight_t<GRAPH>;
+			size_t amount_nodes = graph.getAmountNodes();
+			PrimState<weight_t> state(amount_nodes);
+			IndexedDAryHeap<weight_t, D> heap(amount_nodes);
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+
+			for (size_t root = 0; root < amount_nodes; ++root) {
+				if (state.in_tree[root] || !is_node_alive(graph, root)) {
+					continue;
+				}
+				heap.push(root, weight_t());
+				while (!heap.empty()) {
+					size_t index = heap.pop();
+					state.add(index, result);
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						size_t to = edge.get_to_index();
+						if (!state.in_tree[to] && heap.pushOrDecrease(to, edge.get_weight())) {
+							state.parent[to] = static_cast<std::uint32_t>(index);
+							state.best[to] = edge.get_weight();
+						}
+					}
+				}
+			}
+		}
+
+		template <AdjacencyGraph GRAPH>
+		void prim_dense(const GRAPH& graph, MstResult<edge_weight_t<GRAPH>>& result) {
+			using weight_t = edge_weight_t<GRAPH>;
+			constexpr weight_t UNTOUCHED = std::numeric_limits<weight_t>::has_infinity ?
+				std::numeric_limits<weight_t>::infinity() : std::numeric_limits<weight_t>::max();
+			size_t amount_nodes = graph.getAmountNodes();
+			PrimState<weight_t> state(amount_nodes);
+
+			//Nodes outside the tree and their keys in one contiguous array, so that finding the
+			//closest node is a linear scan. The chosen node is swapped with the last one and dropped.
+			//Removed nodes have no edges and are never part of it
+			std::vector<std::uint32_t> remaining;
+			remaining.reserve(amount_nodes);
+			std::vector<weight_t> keys(amount_nodes, UNTOUCHED);
+			std::vector<std::uint32_t> position(amount_nodes);
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				if (is_node_alive(graph, i)) {
+					position[i] = static_cast<std::uint32_t>(remaining.size());
+					remaining.push_back(static_cast<std::uint32_t>(i));
+				}
+			}
+
+			while (!remaining.empty()) {
+				//Closest node to the tree. If no node has a tree neighbour, any node starts a new tree
+				size_t chosen = 0;
+				for (size_t i = 1; i < remaining.size(); ++i) {
+					if (keys[i] < keys[chosen]) {
+						chosen = i;
+					}
+				}
+				if (state.parent[remaining[chosen]] == PrimState<weight_t>::NONE) {
+					for (size_t i = 0; i < remaining.size(); ++i) {
+						if (state.parent[remaining[i]] != PrimState<weight_t>::NONE) {
+							chosen = i;
+							break;
+						}
+					}
+				}
+
+				size_t next = remaining[chosen];
+				remaining[chosen] = remaining.back();
+				keys[chosen] = keys[remaining.size() - 1];
+				position[remaining[chosen]] = static_cast<std::uint32_t>(chosen);
+				remaining.pop_back();
+
+				state.add(next, result);
+				for (const auto& edge : graph.outEdges(next)) {
+					visited.add();
+					size_t to = edge.get_to_index();
+					if (!state.in_tree[to] && (state.parent[to] == PrimState<weight_t>::NONE || edge.get_weight() < state.best[to])) {
+						state.parent[to] = static_cast<std::uint32_t>(next);
+						state.best[to] = edge.get_weight();
+						keys[position[to]] = edge.get_weight();
+					}
+				}
+			}
+		}
+
+		//With unit weights every spanning forest is minimal, a breadth-first forest is built without a heap
+		template <UnweightedGraph GRAPH>
+		void prim_unit(const GRAPH& graph, MstResult<edge_weight_t<GRAPH>>& result) {
+			using weight_t = edge_weight_t<GRAPH>;
+			size_t amount_nodes = graph.getAmountNodes();
+			PrimState<weight_t> state(amount_nodes);
+			std::vector<std::uint32_t> queue;
+			queue.reserve(amount_nodes);
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+
+			for (size_t root = 0; root < amount_nodes; ++root) {
+				if (state.in_tree[root] || !is_node_alive(graph, root)) {
+					continue;
+				}
+				queue.clear();
+				queue.push_back(static_cast<std::uint32_t>(root));
+				state.add(root, result);
+				for (size_t head = 0; head < queue.size(); ++head) {
+					size_t index = queue[head];
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						size_t to = edge.get_to_index();
+						if (!state.in_tree[to]) {
+							state.parent[to] = static_cast<std::uint32_t>(index);
+							state.best[to] = edge.get_weight();
+							state.add(to, result);
+							queue.push_back(static_cast<std::uint32_t>(to));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	//Minimum spanning forest by Prim's algorithm. The graph must store every edge in both
+	//directions (built with addEdge). The dense variant is picked automatically for graphs
+	//with more than dense_threshold * V^2 edges. Unweighted graphs ignore the mode and get a breadth-first forest
+	template <AdjacencyGraph GRAPH>
+	MstResult<edge_weight_t<GRAPH>> prim(const GRAPH& graph, const PrimOptions& options = PrimOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::PRIM);
+		MstResult<edge_weight_t<GRAPH>> result;
+		size_t amount_nodes = graph.getAmountNodes();
+		result.edges.reserve(amount_nodes == 0 ? 0 : amount_nodes - 1);
+		if constexpr (UnweightedGraph<GRAPH>) {
+			detail::prim_unit(graph, result);
+			return result;
+		}
+
+		PrimMode mode = options.mode;
+		if (mode == PrimMode::AUTO) {
+			size_t amount_edges = 0;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				amount_edges += out_degree(graph, i);
+			}
+			double density = amount_nodes == 0 ? 0.0 : double(amount_edges) / (double(amount_nodes) * double(amount_nodes));
+			mode = density > options.dense_threshold ? PrimMode::DENSE : PrimMode::HEAP;
+		}
+
+		if (mode == PrimMode::DENSE) {
+			detail::prim_dense(graph, result);
+		}
+		else {
+			detail::prim_heap(graph, result);
+		}
+		return result;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <bit>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Monotone priority queue for unsigned integer keys (Ahuja, Mehlhorn, Orlin, Tarjan).
+	//Pushed keys must not be smaller than the last popped key. Bucket i holds keys whose highest
+	//bit differing from the last popped key is bit i - 1, so every element moves at most 64 times
+	template <typename VALUE>
+	class RadixHeap {
+	private:
+		using entry = std::pair<std::uint64_t, VALUE>;
+
+		std::array<std::vector<entry>, 65> buckets;
+		std::uint64_t last = 0;
+		size_t amount = 0;
+
+		static size_t bucket_of(std::uint64_t key, std::uint64_t last_key) {
+			return key == last_key ? 0 : static_cast<size_t>(64 - std::countl_zero(key ^ last_key));
+		}
+		void refill() {
+			size_t i = 1;
+			while (buckets[i].empty()) {
+				++i;
+			}
+			std::uint64_t minimum = std::numeric_limits<std::uint64_t>::max();
+			for (const auto& item : buckets[i]) {
+				minimum = std::min(minimum, item.first);
+			}
+			last = minimum;
+			for (const auto& item : buckets[i]) {
+				buckets[bucket_of(item.first, last)].push_back(item);
+			}
+			buckets[i].clear();
+		}
+	public:
+		bool empty() const {
+			return amount == 0;
+		}
+		size_t size() const {
+			return amount;
+		}
+		//Keeps the memory of the buckets
+		void clear() {
+			for (auto& bucket : buckets) {
+				bucket.clear();
+			}
+			last = 0;
+			amount = 0;
+		}
+
+		void push(std::uint64_t key, const VALUE& value) {
+			buckets[bucket_of(key, last)].emplace_back(key, value);
+			++amount;
+		}
+		std::uint64_t topKey() {
+			if (buckets[0].empty()) {
+				refill();
+			}
+			return last;
+		}
+		//Removes an element with the smallest key and returns it
+		entry pop() {
+			if (buckets[0].empty()) {
+				refill();
+			}
+			entry result = buckets[0].back();
+			buckets[0].pop_back();
+			--amount;
+			return result;
+		}
+	};
+}
@@ -0,0 +1,346 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/permutation.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Node orderings that put nodes used together next to each other in memory. The permutations are
+	//applied with Graph::permute or CompactGraph::permuted. All of them follow outEdges, so an undirected
+	//graph should store every edge in both directions (addEdge)
+	enum class Ordering {
+		//Descending degree, hubs first
+		DEGREE,
+		//Order in which a breadth-first search reaches the nodes
+		BFS,
+		//Reverse Cuthill–McKee, small bandwidth of the adjacency matrix
+		REVERSE_CUTHILL_MCKEE,
+		//Greedy Gorder (Wei et al.): every next node shares the most neighbours with the last window nodes
+		GORDER
+	};
+
+	struct ReorderingOptions {
+		Ordering ordering = Ordering::REVERSE_CUTHILL_MCKEE;
+		//First node of the BFS ordering, the other components follow in index order
+		size_t source = 0;
+		//Amount of the last placed nodes Gorder scores the candidates against
+		size_t window = 5;
+	};
+
+	namespace detail {
+
+		inline constexpr std::uint32_t NO_ORDER_NODE = std::numeric_limits<std::uint32_t>::max();
+
+		template <AdjacencyGraph GRAPH>
+		std::vector<std::uint32_t> degrees_of(const GRAPH& graph) {
+			std::vector<std::uint32_t> degrees(graph.getAmountNodes());
+			for (size_t i = 0; i < degrees.size(); ++i) {
+				degrees[i] = static_cast<std::uint32_t>(out_degree(graph, i));
+			}
+			return degrees;
+		}
+
+		template <AdjacencyGraph GRAPH>
+		void check_reorder_size(const GRAPH& graph) {
+			if (graph.getAmountNodes() >= NO_ORDER_NODE) {
+				throw GraphException("Too many nodes to reorder");
+			}
+		}
+
+		struct ComponentLevels {
+			//Index in the order where the last level starts
+			size_t last_level = 0;
+			size_t depth = 0;
+		};
+
+		//Breadth-first search from source over the unvisited nodes, appending them to order.
+		//With degrees the unvisited neighbours of a node are appended by ascending degree
+		template <AdjacencyGraph GRAPH>
+		ComponentLevels order_component(const GRAPH& graph, size_t source, std::vector<std::uint8_t>& visited, std::vector<std::uint32_t>& order,
+			const std::vector<std::uint32_t>* degrees)
+		{
+			size_t head = order.size();
+			ComponentLevels levels;
+			levels.last_level = head;
+			size_t level_end = head + 1;
+			order.push_back(static_cast<std::uint32_t>(source));
+			visited[source] = 1;
+			for (; head < order.size(); ++head) {
+				if (head == level_end) {
+					levels.last_level = head;
+					++levels.depth;
+					level_end = order.size();
+				}
+				size_t first_new = order.size();
+				for (const auto& edge : graph.outEdges(order[head])) {
+					size_t to = edge.get_to_index();
+					if (!visited[to]) {
+						visited[to] = 1;
+						order.push_back(static_cast<std::uint32_t>(to));
+					}
+				}
+				if (degrees) {
+					std::sort(order.begin() + static_cast<std::ptrdiff_t>(first_new), order.end(), [degrees](std::uint32_t first, std::uint32_t second) {
+						return (*degrees)[first] < (*degrees)[second] || ((*degrees)[first] == (*degrees)[second] && first < second);
+						});
+				}
+			}
+			return levels;
+		}
+
+		//Start of Cuthill–McKee in the component of start: a node of low degree far from the rest of the
+		//component (George, Liu). Repeats the search from the lowest-degree node of the last level while that
+		//lengthens the search. visited is left as it was
+		template <AdjacencyGraph GRAPH>
+		size_t pseudo_peripheral_node(const GRAPH& graph, size_t start, const std::vector<std::uint32_t>& degrees,
+			std::vector<std::uint8_t>& visited, std::vector<std::uint32_t>& scratch)
+		{
+			constexpr size_t MAX_ROUNDS = 8;
+			size_t best_depth = 0;
+			for (size_t round = 0; round < MAX_ROUNDS; ++round) {
+				scratch.clear();
+				ComponentLevels levels = order_component(graph, start, visited, scratch, nullptr);
+				for (std::uint32_t index : scratch) {
+					visited[index] = 0;
+				}
+				if (round > 0 && levels.depth <= best_depth) {
+					break;
+				}
+				best_depth = levels.depth;
+				size_t candidate = scratch[levels.last_level];
+				for (size_t i = levels.last_level; i < scratch.size(); ++i) {
+					if (degrees[scratch[i]] < degrees[candidate]) {
+						candidate = scratch[i];
+					}
+				}
+				if (candidate == start) {
+					break;
+				}
+				start = candidate;
+			}
+			return start;
+		}
+
+		//Buckets of nodes by an integer key that only changes by one, with the maximum found in O(1)
+		//amortized time (the unit heap of Gorder)
+		class UnitHeap {
+		private:
+			std::vector<std::uint32_t> keys;
+			std::vector<std::uint32_t> previous;
+			std::vector<std::uint32_t> next;
+			std::vector<std::uint32_t> heads;
+			std::vector<std::uint8_t> present;
+			size_t top = 0;
+			size_t amount = 0;
+
+			void link(std::uint32_t node) {
+				size_t key = keys[node];
+				if (key >= heads.size()) {
+					heads.resize(std::max(key + 1, heads.size() * 2), NO_ORDER_NODE);
+				}
+				previous[node] = NO_ORDER_NODE;
+				next[node] = heads[key];
+				if (heads[key] != NO_ORDER_NODE) {
+					previous[heads[key]] = node;
+				}
+				heads[key] = node;
+				top = std::max(top, key);
+			}
+			void unlink(std::uint32_t node) {
+				if (previous[node] != NO_ORDER_NODE) {
+					next[previous[node]] = next[node];
+				}
+				else {
+					heads[keys[node]] = next[node];
+				}
+				if (next[node] != NO_ORDER_NODE) {
+					previous[next[node]] = previous[node];
+				}
+			}
+		public:
+			//Every node with key 0, the first nodes come out first on equal keys
+			explicit UnitHeap(size_t amount_nodes) : keys(amount_nodes, 0), previous(amount_nodes), next(amount_nodes),
+				heads(16, NO_ORDER_NODE), present(amount_nodes, 1), amount(amount_nodes)
+			{
+				for (size_t i = amount_nodes; i-- > 0;) {
+					link(static_cast<std::uint32_t>(i));
+				}
+			}
+
+			bool empty() const {
+				return amount == 0;
+			}
+			bool contains(size_t node) const {
+				return present[node] != 0;
+			}
+			void increase(std::uint32_t node) {
+				unlink(node);
+				++keys[node];
+				link(node);
+			}
+			void decrease(std::uint32_t node) {
+				unlink(node);
+				--keys[node];
+				link(node);
+			}
+			void remove(std::uint32_t node) {
+				unlink(node);
+				present[node] = 0;
+				--amount;
+			}
+			std::uint32_t popMax() {
+				while (heads[top] == NO_ORDER_NODE) {
+					--top;
+				}
+				std::uint32_t node = heads[top];
+				remove(node);
+				return node;
+			}
+		};
+	}
+
+	//Nodes by descending degree, equal degrees by index
+	template <AdjacencyGraph GRAPH>
+	Permutation degreeOrder(const GRAPH& graph) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::REORDER);
+		detail::check_reorder_size(graph);
+		std::vector<std::uint32_t> degrees = detail::degrees_of(graph);
+		std::vector<std::uint32_t> order(degrees.size());
+		std::iota(order.begin(), order.end(), std::uint32_t(0));
+		std::stable_sort(order.begin(), order.end(), [&degrees](std::uint32_t first, std::uint32_t second) {
+			return degrees[first] > degrees[second];
+			});
+		return Permutation(std::move(order));
+	}
+
+	//Nodes in the order a breadth-first search from source reaches them, then the other components
+	//searched from their lowest index
+	template <AdjacencyGraph GRAPH>
+	Permutation bfsOrder(const GRAPH& graph, size_t source = 0) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::REORDER);
+		detail::check_reorder_size(graph);
+		const size_t amount_nodes = graph.getAmountNodes();
+		if (amount_nodes != 0 && source >= amount_nodes) {
+			throw InvalidIndexException();
+		}
+		std::vector<std::uint8_t> visited(amount_nodes, 0);
+		std::vector<std::uint32_t> order;
+		order.reserve(amount_nodes);
+		if (amount_nodes != 0) {
+			detail::order_component(graph, source, visited, order, nullptr);
+		}
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			if (!visited[index]) {
+				detail::order_component(graph, index, visited, order, nullptr);
+			}
+		}
+		return Permutation(std::move(order));
+	}
+
+	//Reverse Cuthill–McKee: breadth-first search from a pseudo-peripheral node of every component,
+	//visiting the neighbours of a node by ascending degree, and the whole order reversed
+	template <AdjacencyGraph GRAPH>
+	Permutation reverseCuthillMcKeeOrder(const GRAPH& graph) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::REORDER);
+		detail::check_reorder_size(graph);
+		const size_t amount_nodes = graph.getAmountNodes();
+		std::vector<std::uint32_t> degrees = detail::degrees_of(graph);
+		//Components are started from their nodes of lowest degree
+		std::vector<std::uint32_t> starts(amount_nodes);
+		std::iota(starts.begin(), starts.end(), std::uint32_t(0));
+		std::stable_sort(starts.begin(), starts.end(), [&degrees](std::uint32_t first, std::uint32_t second) {
+			return degrees[first] < degrees[second];
+			});
+
+		std::vector<std::uint8_t> visited(amount_nodes, 0);
+		std::vector<std::uint32_t> order;
+		std::vector<std::uint32_t> scratch;
+		order.reserve(amount_nodes);
+		for (std::uint32_t start : starts) {
+			if (!visited[start]) {
+				size_t peripheral = detail::pseudo_peripheral_node(graph, start, degrees, visited, scratch);
+				detail::order_component(graph, peripheral, visited, order, &degrees);
+				//In a directed graph the peripheral node may not reach start, which is then ordered on its own
+				if (!visited[start]) {
+					detail::order_component(graph, start, visited, order, &degrees);
+				}
+			}
+		}
+		std::reverse(order.begin(), order.end());
+		return Permutation(std::move(order));
+	}
+
+	//Gorder: starting from the node of highest degree, always places the node with the highest score
+	//against the last window placed nodes. A node scores one for every window node it is adjacent to
+	//and one for every neighbour it shares with a window node. Neighbours with more than sqrt(V) edges
+	//are not followed for shared neighbours, as in the original heuristic, so hubs do not dominate the cost
+	template <AdjacencyGraph GRAPH>
+	Permutation gorderOrder(const GRAPH& graph, size_t window = 5) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::REORDER);
+		detail::check_reorder_size(graph);
+		const size_t amount_nodes = graph.getAmountNodes();
+		std::vector<std::uint32_t> order;
+		order.reserve(amount_nodes);
+		if (amount_nodes == 0) {
+			return Permutation(std::move(order));
+		}
+		window = std::max<size_t>(1, window);
+		std::vector<std::uint32_t> degrees = detail::degrees_of(graph);
+		const size_t hub_degree = static_cast<size_t>(std::sqrt(static_cast<double>(amount_nodes)));
+
+		detail::UnitHeap heap(amount_nodes);
+		//Adds one to (or takes one from) the scores of the unplaced nodes related to node
+		auto update = [&](std::uint32_t node, bool increase) {
+			auto change = [&](size_t to) {
+				if (to != node && heap.contains(to)) {
+					increase ? heap.increase(static_cast<std::uint32_t>(to)) : heap.decrease(static_cast<std::uint32_t>(to));
+				}
+			};
+			for (const auto& edge : graph.outEdges(node)) {
+				size_t neighbour = edge.get_to_index();
+				change(neighbour);
+				if (degrees[neighbour] <= hub_degree) {
+					for (const auto& second : graph.outEdges(neighbour)) {
+						change(second.get_to_index());
+					}
+				}
+			}
+		};
+
+		std::uint32_t first = static_cast<std::uint32_t>(std::max_element(degrees.begin(), degrees.end()) - degrees.begin());
+		heap.remove(first);
+		order.push_back(first);
+		update(first, true);
+		while (!heap.empty()) {
+			if (order.size() > window) {
+				update(order[order.size() - window - 1], false);
+			}
+			std::uint32_t node = heap.popMax();
+			order.push_back(node);
+			update(node, true);
+		}
+		return Permutation(std::move(order));
+	}
+
+	template <AdjacencyGraph GRAPH>
+	Permutation computeOrder(const GRAPH& graph, const ReorderingOptions& options = ReorderingOptions()) {
+		switch (options.ordering) {
+		case Ordering::DEGREE:
+			return degreeOrder(graph);
+		case Ordering::BFS:
+			return bfsOrder(graph, options.source);
+		case Ordering::GORDER:
+			return gorderOrder(graph, options.window);
+		default:
+			return reverseCuthillMcKeeOrder(graph);
+		}
+	}
+}
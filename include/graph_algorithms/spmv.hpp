@@ -0,0 +1,212 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/graph_policies.hpp"
+#include "../graph_core/compact_graph.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <span>
+#include <limits>
+#include <concepts>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Semirings of spmv: y[i] = add over the edges i -> j of multiply(weight, x[j]), starting from zero()
+
+	//Weighted sums
+	template <typename VALUE>
+	struct PlusTimes {
+		using value_type = VALUE;
+		VALUE zero() const {
+			return VALUE();
+		}
+		VALUE add(VALUE first, VALUE second) const {
+			return first + second;
+		}
+		template <typename WEIGHT_TYPE>
+		VALUE multiply(WEIGHT_TYPE weight, VALUE x) const {
+			return static_cast<VALUE>(weight) * x;
+		}
+	};
+
+	//Sums that ignore the weights, such as PageRank over shares already divided by the degree
+	template <typename VALUE>
+	struct PlusSecond {
+		using value_type = VALUE;
+		VALUE zero() const {
+			return VALUE();
+		}
+		VALUE add(VALUE first, VALUE second) const {
+			return first + second;
+		}
+		template <typename WEIGHT_TYPE>
+		VALUE multiply(WEIGHT_TYPE, VALUE x) const {
+			return x;
+		}
+	};
+
+	//Tropical semiring: one relaxation step of Bellman-Ford. zero() is the unreachable distance
+	template <typename VALUE>
+	struct MinPlus {
+		using value_type = VALUE;
+		VALUE zero() const {
+			if constexpr (std::numeric_limits<VALUE>::has_infinity) {
+				return std::numeric_limits<VALUE>::infinity();
+			}
+			else {
+				return std::numeric_limits<VALUE>::max();
+			}
+		}
+		VALUE add(VALUE first, VALUE second) const {
+			return std::min(first, second);
+		}
+		template <typename WEIGHT_TYPE>
+		VALUE multiply(WEIGHT_TYPE weight, VALUE x) const {
+			return x == zero() ? x : static_cast<VALUE>(weight) + x;
+		}
+	};
+
+	//Smallest value among the neighbours, such as labels
+	template <typename VALUE>
+	struct MinSecond {
+		using value_type = VALUE;
+		VALUE zero() const {
+			return std::numeric_limits<VALUE>::max();
+		}
+		VALUE add(VALUE first, VALUE second) const {
+			return std::min(first, second);
+		}
+		template <typename WEIGHT_TYPE>
+		VALUE multiply(WEIGHT_TYPE, VALUE x) const {
+			return x;
+		}
+	};
+
+	template <typename SEMIRING, typename WEIGHT_TYPE>
+	concept Semiring = requires(const SEMIRING& semiring, typename SEMIRING::value_type value, WEIGHT_TYPE weight) {
+		{ semiring.zero() } -> std::convertible_to<typename SEMIRING::value_type>;
+		{ semiring.add(value, value) } -> std::convertible_to<typename SEMIRING::value_type>;
+		{ semiring.multiply(weight, value) } -> std::convertible_to<typename SEMIRING::value_type>;
+	};
+
+	//Results of the iterative analytics (PageRank, Katz centrality, label propagation)
+	template <typename VALUE>
+	struct IterativeResult {
+		std::vector<VALUE> values;
+		size_t iterations = 0;
+		//Change of the last iteration, in the measure of the analytics
+		double residual = 0;
+		bool converged = false;
+	};
+
+	//The in-edges of every node of a graph in CSR form, built once for pull-style iterations. As an
+	//AdjacencyGraph its outEdges(i) are the edges leading to i, their get_to_index() is the source.
+	//WEIGHT_TYPE = void drops the weights
+	template <typename WEIGHT_TYPE = void>
+	class ReverseAdjacency {
+	public:
+		using weight_type = weight_value_t<WEIGHT_TYPE>;
+		static constexpr bool weighted = is_weighted_v<WEIGHT_TYPE>;
+	private:
+		std::vector<std::uint64_t> offsets;
+		std::vector<std::uint32_t> sources;
+		//Empty for WEIGHT_TYPE = void
+		std::vector<weight_type> weights;
+		std::vector<std::uint32_t> out_degrees;
+	public:
+		ReverseAdjacency() : offsets(1, 0) {}
+		template <AdjacencyGraph GRAPH>
+		explicit ReverseAdjacency(const GRAPH& graph) : offsets(graph.getAmountNodes() + 1, 0), out_degrees(graph.getAmountNodes(), 0) {
+			const size_t amount_nodes = graph.getAmountNodes();
+			if (amount_nodes >= std::numeric_limits<std::uint32_t>::max()) {
+				throw GraphException("Too many nodes for a reverse adjacency");
+			}
+			for (size_t from = 0; from < amount_nodes; ++from) {
+				for (const auto& edge : graph.outEdges(from)) {
+					++offsets[edge.get_to_index() + 1];
+					++out_degrees[from];
+				}
+			}
+			for (size_t index = 0; index < amount_nodes; ++index) {
+				offsets[index + 1] += offsets[index];
+			}
+
+			std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+			sources.resize(offsets.back());
+			if constexpr (weighted) {
+				weights.resize(offsets.back());
+			}
+			for (size_t from = 0; from < amount_nodes; ++from) {
+				for (const auto& edge : graph.outEdges(from)) {
+					std::uint64_t slot = position[edge.get_to_index()]++;
+					sources[slot] = static_cast<std::uint32_t>(from);
+					if constexpr (weighted) {
+						weights[slot] = static_cast<weight_type>(edge.get_weight());
+					}
+				}
+			}
+		}
+
+		size_t getAmountNodes() const {
+			return out_degrees.size();
+		}
+		size_t getAmountEdge() const {
+			return sources.size();
+		}
+		//Sources of the edges leading to the node, by ascending index
+		std::span<const std::uint32_t> neighbors(size_t index) const {
+			return std::span<const std::uint32_t>(sources.data() + offsets[index], inDegree(index));
+		}
+		CompactEdgeRange<WEIGHT_TYPE> outEdges(size_t index) const {
+			if constexpr (weighted) {
+				return CompactEdgeRange<WEIGHT_TYPE>(sources.data() + offsets[index], weights.data() + offsets[index], inDegree(index));
+			}
+			else {
+				return CompactEdgeRange<WEIGHT_TYPE>(sources.data() + offsets[index], inDegree(index));
+			}
+		}
+		size_t inDegree(size_t index) const {
+			return static_cast<size_t>(offsets[index + 1] - offsets[index]);
+		}
+		//Amount of edges leaving the node in the original graph
+		size_t outDegree(size_t index) const {
+			return out_degrees[index];
+		}
+		size_t memoryFootprint() const {
+			return offsets.capacity() * sizeof(std::uint64_t) + sources.capacity() * sizeof(std::uint32_t) +
+				weights.capacity() * sizeof(weight_type) + out_degrees.capacity() * sizeof(std::uint32_t);
+		}
+	};
+
+	//Sparse matrix-vector product over a semiring: y[i] = add over the edges i -> j of multiply(weight, x[j]).
+	//Pass a ReverseAdjacency to pull along the in-edges instead. The nodes are split into chunks that the
+	//threads take in turn, so hubs do not hold up one thread. x and y must not overlap
+	template <AdjacencyGraph GRAPH, typename SEMIRING>
+		requires Semiring<SEMIRING, edge_weight_t<GRAPH>>
+	void spmv(const GRAPH& graph, std::span<const typename SEMIRING::value_type> x, std::span<typename SEMIRING::value_type> y,
+		const SEMIRING& semiring, size_t threads = 1)
+	{
+		using value_t = typename SEMIRING::value_type;
+		instrumentation::ScopedTimer timer(instrumentation::Operation::SPMV);
+		const size_t amount_nodes = graph.getAmountNodes();
+		if (x.size() != amount_nodes || y.size() != amount_nodes) {
+			throw GraphException("Vector sizes do not match the amount of nodes");
+		}
+		parallel_for_dynamic(threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			for (size_t index = begin; index < end; ++index) {
+				value_t sum = semiring.zero();
+				for (const auto& edge : graph.outEdges(index)) {
+					visited.add();
+					sum = semiring.add(sum, semiring.multiply(edge.get_weight(), x[edge.get_to_index()]));
+				}
+				y[index] = sum;
+			}
+			}, 1024);
+	}
+}
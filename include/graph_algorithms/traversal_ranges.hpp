@@ -0,0 +1,220 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "../exceptions.hpp"
+#include "generator.hpp"
+#include "dijkstra.hpp"
+#include <vector>
+#include <queue>
+#include <ranges>
+#include <unordered_map>
+#include <functional>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Node reached by bfsRange or dfsRange, for (auto [node, depth] : bfsRange(graph, source))
+	struct TraversalStep {
+		size_t node;
+		//Edges on the path from the source by which the node was reached
+		size_t depth;
+	};
+
+	//Node settled by bestFirstRange, distance is the length of a shortest path from the source
+	template <typename WEIGHT_TYPE>
+	struct BestFirstStep {
+		size_t node;
+		WEIGHT_TYPE distance;
+	};
+
+	struct TraversalOptions {
+		//Nodes farther than this many edges from the source are not reached
+		size_t max_depth = std::numeric_limits<size_t>::max();
+	};
+
+	namespace detail {
+
+		//Per-node state of a lazy traversal. Starts as a hash map, so a search that stops after a few nodes
+		//costs memory for those nodes only, and turns into a dense array of all nodes once it holds
+		//1/32 of them, where the array is both smaller and faster
+		template <typename VALUE>
+		class SparseArray {
+		private:
+			size_t amount;
+			VALUE absent;
+			std::unordered_map<size_t, VALUE> sparse;
+			std::vector<VALUE> dense;
+			bool is_dense = false;
+		public:
+			SparseArray(size_t _amount, VALUE _absent) : amount(_amount), absent(_absent) {}
+
+			VALUE get(size_t index) const {
+				if (is_dense) {
+					return dense[index];
+				}
+				auto it = sparse.find(index);
+				return it == sparse.end() ? absent : it->second;
+			}
+			void set(size_t index, VALUE value) {
+				if (is_dense) {
+					dense[index] = value;
+					return;
+				}
+				sparse[index] = value;
+				if (sparse.size() > amount / 32) {
+					dense.assign(amount, absent);
+					for (const auto& [key, stored] : sparse) {
+						dense[key] = stored;
+					}
+					std::unordered_map<size_t, VALUE>().swap(sparse);
+					is_dense = true;
+				}
+			}
+		};
+
+		template <AdjacencyGraph GRAPH>
+		Generator<TraversalStep> bfs_range(const GRAPH& graph, size_t source, TraversalOptions options) {
+			SparseArray<bool> reached(graph.getAmountNodes(), false);
+			std::vector<size_t> level{ source };
+			std::vector<size_t> next_level;
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			reached.set(source, true);
+			co_yield TraversalStep{ source, 0 };
+			//Nodes are handed out as soon as they are discovered, before the rest of their level is scanned
+			for (size_t depth = 1; depth <= options.max_depth && !level.empty(); ++depth) {
+				for (size_t index : level) {
+					for (const auto& edge : graph.outEdges(index)) {
+						visited.add();
+						size_t to = edge.get_to_index();
+						if (!reached.get(to)) {
+							reached.set(to, true);
+							next_level.push_back(to);
+							co_yield TraversalStep{ to, depth };
+						}
+					}
+				}
+				level.swap(next_level);
+				next_level.clear();
+			}
+		}
+
+		template <AdjacencyGraph GRAPH>
+		Generator<TraversalStep> dfs_range(const GRAPH& graph, size_t source, TraversalOptions options) {
+			using edge_range = out_edges_t<GRAPH>;
+			struct Frame {
+				std::ranges::iterator_t<edge_range> current;
+				std::ranges::sentinel_t<edge_range> end;
+			};
+
+			SparseArray<bool> reached(graph.getAmountNodes(), false);
+			std::vector<Frame> stack;
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			auto enter = [&](size_t index) {
+				reached.set(index, true);
+				if (stack.size() < options.max_depth) {
+					//Edge iterators refer to the storage of the graph, not to the temporary range object
+					auto&& edges = graph.outEdges(index);
+					stack.push_back(Frame{ std::ranges::begin(edges), std::ranges::end(edges) });
+				}
+				else {
+					//A node at the depth limit is not expanded, an empty frame keeps the depth of the stack
+					stack.push_back(Frame{});
+				}
+			};
+
+			enter(source);
+			co_yield TraversalStep{ source, 0 };
+			while (!stack.empty()) {
+				Frame& frame = stack.back();
+				if (stack.size() > options.max_depth || frame.current == frame.end) {
+					stack.pop_back();
+					continue;
+				}
+				size_t to = (*frame.current).get_to_index();
+				++frame.current;
+				visited.add();
+				if (!reached.get(to)) {
+					enter(to);
+					co_yield TraversalStep{ to, stack.size() - 1 };
+				}
+			}
+		}
+
+		template <AdjacencyGraph GRAPH>
+		Generator<BestFirstStep<edge_weight_t<GRAPH>>> best_first_range(const GRAPH& graph, size_t source, edge_weight_t<GRAPH> max_distance) {
+			using weight_t = edge_weight_t<GRAPH>;
+			using entry = std::pair<weight_t, size_t>;
+
+			SparseArray<weight_t> distance(graph.getAmountNodes(), unreachable_distance<weight_t>());
+			SparseArray<bool> settled(graph.getAmountNodes(), false);
+			std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+			instrumentation::ScopedCounter visited(instrumentation::Counter::EDGES_VISITED);
+			distance.set(source, weight_t());
+			queue.emplace(weight_t(), source);
+			while (!queue.empty()) {
+				auto [current, index] = queue.top();
+				queue.pop();
+				//Entries of nodes whose distance decreased later stay in the queue and are skipped
+				if (settled.get(index)) {
+					continue;
+				}
+				settled.set(index, true);
+				co_yield BestFirstStep<weight_t>{ index, current };
+
+				for (const auto& edge : graph.outEdges(index)) {
+					visited.add();
+					weight_t weight = static_cast<weight_t>(edge.get_weight());
+					if (weight < weight_t()) {
+						throw GraphException("Shortest path search requires non-negative edge weights");
+					}
+					//Saturates instead of overflowing, so a path too long for the weight type is never taken
+					weight_t candidate = add_distance<weight_t>(current, weight);
+					size_t to = edge.get_to_index();
+					if (candidate <= max_distance && candidate < distance.get(to)) {
+						distance.set(to, candidate);
+						queue.emplace(candidate, to);
+					}
+				}
+			}
+		}
+	}
+
+	//Lazy traversals: the nodes are produced one at a time while the range is iterated and the search does no
+	//more work than the loop consumes, so "the first node within k hops that matches" stops as soon as it is found.
+	//The per-node state is allocated for the explored part only until it grows large, see detail::SparseArray.
+	//The graph must outlive the range and must not change while it is iterated. Every node is produced once
+
+	//Breadth-first order from the source, nodes by ascending depth
+	template <AdjacencyGraph GRAPH>
+	Generator<TraversalStep> bfsRange(const GRAPH& graph, size_t source, const TraversalOptions& options = TraversalOptions()) {
+		if (source >= graph.getAmountNodes()) {
+			throw InvalidIndexException();
+		}
+		return detail::bfs_range(graph, source, options);
+	}
+
+	//Depth-first pre-order from the source. depth is that of the first path found, with max_depth a node
+	//first reached by a path that is too long is not reached again by a shorter one
+	template <AdjacencyGraph GRAPH>
+	Generator<TraversalStep> dfsRange(const GRAPH& graph, size_t source, const TraversalOptions& options = TraversalOptions()) {
+		if (source >= graph.getAmountNodes()) {
+			throw InvalidIndexException();
+		}
+		return detail::dfs_range(graph, source, options);
+	}
+
+	//Nodes by ascending distance from the source (Dijkstra order), up to max_distance.
+	//Negative edge weights throw GraphException when they are reached
+	template <AdjacencyGraph GRAPH>
+	Generator<BestFirstStep<edge_weight_t<GRAPH>>> bestFirstRange(const GRAPH& graph, size_t source,
+		edge_weight_t<GRAPH> max_distance = unreachable_distance<edge_weight_t<GRAPH>>())
+	{
+		if (source >= graph.getAmountNodes()) {
+			throw InvalidIndexException();
+		}
+		return detail::best_first_range(graph, source, max_distance);
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "../graph_core/graph_concepts.hpp"
+#include "../graph_core/instrumentation.hpp"
+#include "intersection.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Amount of triangles of an undirected graph: every node intersects its degree-oriented
+	//neighbour set with the sets of its oriented neighbours, so each triangle is found once
+	inline std::uint64_t countTriangles(const NeighbourSets& sets, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COUNT_TRIANGLES);
+		const IntersectionKernel kernel = detail::resolve_kernel(options.kernel);
+		const size_t threads = resolve_threads(options.threads);
+		const NeighbourSets oriented = sets.degreeOriented(threads);
+
+		std::vector<std::uint64_t> partial(threads, 0);
+		parallel_for_dynamic(threads, oriented.getAmountNodes(), [&](size_t thread_id, size_t begin, size_t end) {
+			std::uint64_t count = 0;
+			for (size_t index = begin; index < end; ++index) {
+				auto first = oriented.neighbors(index);
+				for (std::uint32_t to : first) {
+					auto second = oriented.neighbors(to);
+					count += detail::intersection_size(first.data(), first.size(), second.data(), second.size(), kernel);
+				}
+			}
+			partial[thread_id] += count;
+			});
+
+		std::uint64_t result = 0;
+		for (std::uint64_t count : partial) {
+			result += count;
+		}
+		return result;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	std::uint64_t countTriangles(const GRAPH& graph, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COUNT_TRIANGLES);
+		return countTriangles(NeighbourSets(graph, options.threads), options);
+	}
+
+	//Amount of triangles through every node. Every edge is intersected once and its count
+	//of common neighbours goes to both ends, each triangle is seen from two edges of a node
+	inline std::vector<std::uint64_t> countTrianglesPerNode(const NeighbourSets& sets, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COUNT_TRIANGLES);
+		const IntersectionKernel kernel = detail::resolve_kernel(options.kernel);
+		const size_t amount_nodes = sets.getAmountNodes();
+		std::vector<std::uint64_t> result(amount_nodes, 0);
+
+		parallel_for_dynamic(options.threads, amount_nodes, [&](size_t, size_t begin, size_t end) {
+			for (size_t index = begin; index < end; ++index) {
+				auto first = sets.neighbors(index);
+				std::uint64_t own = 0;
+				for (std::uint32_t to : first) {
+					if (to <= index) {
+						continue;
+					}
+					auto second = sets.neighbors(to);
+					std::uint64_t common = detail::intersection_size(first.data(), first.size(), second.data(), second.size(), kernel);
+					own += common;
+					if (common != 0) {
+						std::atomic_ref<std::uint64_t>(result[to]).fetch_add(common, std::memory_order_relaxed);
+					}
+				}
+				std::atomic_ref<std::uint64_t>(result[index]).fetch_add(own, std::memory_order_relaxed);
+			}
+			});
+
+		parallel_for(options.threads, amount_nodes, [&result](size_t, size_t begin, size_t end) {
+			for (size_t index = begin; index < end; ++index) {
+				result[index] /= 2;
+			}
+			});
+		return result;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	std::vector<std::uint64_t> countTrianglesPerNode(const GRAPH& graph, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::COUNT_TRIANGLES);
+		return countTrianglesPerNode(NeighbourSets(graph, options.threads), options);
+	}
+
+	//Share of the pairs of neighbours of every node that are connected themselves, 0 for nodes with fewer than two neighbours
+	inline std::vector<double> localClusteringCoefficient(const NeighbourSets& sets, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::CLUSTERING_COEFFICIENT);
+		std::vector<std::uint64_t> triangles = countTrianglesPerNode(sets, options);
+		std::vector<double> result(triangles.size(), 0.0);
+		for (size_t index = 0; index < triangles.size(); ++index) {
+			double degree = static_cast<double>(sets.degree(index));
+			if (degree >= 2) {
+				result[index] = 2.0 * static_cast<double>(triangles[index]) / (degree * (degree - 1));
+			}
+		}
+		return result;
+	}
+
+	template <AdjacencyGraph GRAPH>
+	std::vector<double> localClusteringCoefficient(const GRAPH& graph, const IntersectionOptions& options = IntersectionOptions()) {
+		instrumentation::ScopedTimer timer(instrumentation::Operation::CLUSTERING_COEFFICIENT);
+		return localClusteringCoefficient(NeighbourSets(graph, options.threads), options);
+	}
+}
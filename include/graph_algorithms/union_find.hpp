@@ -0,0 +1,129 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Disjoint sets with path compression and union by rank
+	class UnionFind {
+	private:
+		std::vector<std::uint32_t> parent;
+		std::vector<std::uint8_t> rank;
+		size_t amount_sets;
+	public:
+		explicit UnionFind(size_t amount = 0) : parent(amount), rank(amount, 0), amount_sets(amount) {
+			std::iota(parent.begin(), parent.end(), std::uint32_t(0));
+		}
+
+		size_t find(size_t element) {
+			size_t root = element;
+			while (parent[root] != root) {
+				root = parent[root];
+			}
+			while (parent[element] != root) {
+				size_t next = parent[element];
+				parent[element] = static_cast<std::uint32_t>(root);
+				element = next;
+			}
+			return root;
+		}
+		//Returns false if the elements were already in one set
+		bool unite(size_t first, size_t second) {
+			first = find(first);
+			second = find(second);
+			if (first == second) {
+				return false;
+			}
+			if (rank[first] < rank[second]) {
+				std::swap(first, second);
+			}
+			parent[second] = static_cast<std::uint32_t>(first);
+			if (rank[first] == rank[second]) {
+				++rank[first];
+			}
+			--amount_sets;
+			return true;
+		}
+		bool connected(size_t first, size_t second) {
+			return find(first) == find(second);
+		}
+		//Adds a new single-element set and returns its element
+		size_t add() {
+			parent.push_back(static_cast<std::uint32_t>(parent.size()));
+			rank.push_back(0);
+			++amount_sets;
+			return parent.size() - 1;
+		}
+		size_t size() const {
+			return parent.size();
+		}
+		size_t amountSets() const {
+			return amount_sets;
+		}
+	};
+
+	//Lock-free disjoint sets: find compresses paths with CAS (path halving),
+	//unite links the root with the smaller index under the other one with CAS.
+	//find and unite may be called from any number of threads at once
+	class ConcurrentUnionFind {
+	private:
+		std::vector<std::atomic<std::uint32_t>> parent;
+	public:
+		explicit ConcurrentUnionFind(size_t amount = 0) : parent(amount) {
+			for (size_t i = 0; i < amount; ++i) {
+				parent[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+			}
+		}
+
+		size_t find(size_t element) {
+			std::uint32_t current = static_cast<std::uint32_t>(element);
+			while (true) {
+				std::uint32_t next = parent[current].load(std::memory_order_acquire);
+				if (next == current) {
+					return current;
+				}
+				std::uint32_t grand = parent[next].load(std::memory_order_acquire);
+				if (grand != next) {
+					parent[current].compare_exchange_weak(next, grand, std::memory_order_release, std::memory_order_relaxed);
+				}
+				current = grand;
+			}
+		}
+		bool unite(size_t first, size_t second) {
+			while (true) {
+				std::uint32_t root_first = static_cast<std::uint32_t>(find(first));
+				std::uint32_t root_second = static_cast<std::uint32_t>(find(second));
+				if (root_first == root_second) {
+					return false;
+				}
+				if (root_first > root_second) {
+					std::swap(root_first, root_second);
+				}
+				std::uint32_t expected = root_first;
+				if (parent[root_first].compare_exchange_strong(expected, root_second, std::memory_order_acq_rel)) {
+					return true;
+				}
+			}
+		}
+		bool connected(size_t first, size_t second) {
+			while (true) {
+				size_t root_first = find(first);
+				size_t root_second = find(second);
+				if (root_first == root_second) {
+					return true;
+				}
+				//root_first may have been linked in between
+				if (parent[root_first].load(std::memory_order_acquire) == root_first) {
+					return false;
+				}
+			}
+		}
+		size_t size() const {
+			return parent.size();
+		}
+	};
+}
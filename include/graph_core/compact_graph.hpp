@@ -0,0 +1,340 @@
+#pragma once
+#include "graph_policies.hpp"
+#include "permutation.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+//Edge of a CompactGraph, returned by value from CompactGraph::outEdges
+template <typename WEIGHT_TYPE>
+class CompactEdge {
+private:
+	std::uint32_t to_index;
+	WEIGHT_TYPE weight;
+public:
+	static constexpr bool weighted = true;
+
+	CompactEdge() : to_index(0), weight() {}
+	CompactEdge(std::uint32_t _to_index, WEIGHT_TYPE _weight) : to_index(_to_index), weight(_weight) {}
+
+	size_t get_to_index() const {
+		return to_index;
+	}
+	WEIGHT_TYPE get_weight() const {
+		return weight;
+	}
+};
+
+//Edge of an unweighted CompactGraph, every edge has weight 1
+template <>
+class CompactEdge<void> {
+private:
+	std::uint32_t to_index;
+public:
+	static constexpr bool weighted = false;
+
+	CompactEdge() : to_index(0) {}
+	explicit CompactEdge(std::uint32_t _to_index) : to_index(_to_index) {}
+
+	size_t get_to_index() const {
+		return to_index;
+	}
+	unit_weight_t get_weight() const {
+		return 1;
+	}
+};
+
+//Range over the edges of one node, zips the target and weight arrays
+template <typename WEIGHT_TYPE>
+class CompactEdgeRange {
+private:
+	const std::uint32_t* targets;
+	const WEIGHT_TYPE* weights;
+	size_t amount;
+public:
+	class iterator {
+	private:
+		const std::uint32_t* target = nullptr;
+		const WEIGHT_TYPE* weight = nullptr;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = CompactEdge<WEIGHT_TYPE>;
+		using difference_type = std::ptrdiff_t;
+		using reference = CompactEdge<WEIGHT_TYPE>;
+		using pointer = void;
+
+		iterator() = default;
+		iterator(const std::uint32_t* _target, const WEIGHT_TYPE* _weight) : target(_target), weight(_weight) {}
+
+		CompactEdge<WEIGHT_TYPE> operator*() const {
+			return CompactEdge<WEIGHT_TYPE>(*target, *weight);
+		}
+		iterator& operator++() {
+			++target;
+			++weight;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator result = *this;
+			++*this;
+			return result;
+		}
+		bool operator==(const iterator& other) const {
+			return target == other.target;
+		}
+	};
+
+	CompactEdgeRange(const std::uint32_t* _targets, const WEIGHT_TYPE* _weights, size_t _amount)
+		: targets(_targets), weights(_weights), amount(_amount) {}
+
+	iterator begin() const {
+		return iterator(targets, weights);
+	}
+	iterator end() const {
+		return iterator(targets + amount, weights + amount);
+	}
+	size_t size() const {
+		return amount;
+	}
+	bool empty() const {
+		return amount == 0;
+	}
+};
+
+//Range over the edges of one node of an unweighted CompactGraph
+template <>
+class CompactEdgeRange<void> {
+private:
+	const std::uint32_t* targets;
+	size_t amount;
+public:
+	class iterator {
+	private:
+		const std::uint32_t* target = nullptr;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = CompactEdge<void>;
+		using difference_type = std::ptrdiff_t;
+		using reference = CompactEdge<void>;
+		using pointer = void;
+
+		iterator() = default;
+		explicit iterator(const std::uint32_t* _target) : target(_target) {}
+
+		CompactEdge<void> operator*() const {
+			return CompactEdge<void>(*target);
+		}
+		iterator& operator++() {
+			++target;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator result = *this;
+			++target;
+			return result;
+		}
+		bool operator==(const iterator& other) const {
+			return target == other.target;
+		}
+	};
+
+	CompactEdgeRange(const std::uint32_t* _targets, size_t _amount) : targets(_targets), amount(_amount) {}
+
+	iterator begin() const {
+		return iterator(targets);
+	}
+	iterator end() const {
+		return iterator(targets + amount);
+	}
+	size_t size() const {
+		return amount;
+	}
+	bool empty() const {
+		return amount == 0;
+	}
+};
+
+/*
+Immutable snapshot of a Graph in compressed sparse row (CSR) form.
+The edges of node i are targets[offsets[i] .. offsets[i + 1]) with weights at the same positions.
+An unweighted graph (WEIGHT_TYPE = void) has no weight array, its edges are 4 bytes each.
+Node indices are the same as in the graph the snapshot was made from.
+Every accessor taking a node index throws InvalidIndexException for an index out of range.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class CompactGraph {
+public:
+	using vertex_id = std::uint32_t;
+	using weight_type = weight_value_t<WEIGHT_TYPE>;
+	static constexpr bool weighted = is_weighted_v<WEIGHT_TYPE>;
+private:
+	std::vector<T> nodes_data;
+	std::vector<std::uint64_t> offsets;
+	std::vector<vertex_id> edge_targets;
+	//Empty for an unweighted graph
+	std::vector<weight_type> edge_weights;
+
+	void check_index(size_t index) const {
+		if (index >= nodes_data.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+	}
+public:
+	//Constructors and destructor
+	CompactGraph() : offsets(1, 0) {}
+	//An unweighted graph takes no weights
+	CompactGraph(std::vector<T> _nodes_data, std::vector<std::uint64_t> _offsets,
+		std::vector<vertex_id> _targets, std::vector<weight_type> _weights = {})
+		: nodes_data(std::move(_nodes_data)), offsets(std::move(_offsets)),
+		edge_targets(std::move(_targets)), edge_weights(std::move(_weights))
+	{
+		if (offsets.size() != nodes_data.size() + 1 || edge_weights.size() != (weighted ? edge_targets.size() : 0) ||
+			offsets.back() != edge_targets.size() || nodes_data.size() > std::numeric_limits<vertex_id>::max()) {
+			throw graph_library::GraphException("Inconsistent CSR arrays");
+		}
+	}
+	CompactGraph(const CompactGraph<T, WEIGHT_TYPE>& other) = default;
+	CompactGraph(CompactGraph<T, WEIGHT_TYPE>&& other) noexcept = default;
+	~CompactGraph() = default;
+
+	//Operators
+	CompactGraph<T, WEIGHT_TYPE>& operator=(const CompactGraph<T, WEIGHT_TYPE>& other) = default;
+	CompactGraph<T, WEIGHT_TYPE>& operator=(CompactGraph<T, WEIGHT_TYPE>&& other) noexcept = default;
+
+
+	//----------- M A I N   F U N C T I O N S ---------
+
+
+	size_t getAmountNodes() const {
+		return nodes_data.size();
+	}
+	size_t getAmountEdge() const {
+		return edge_targets.size();
+	}
+	size_t degree(size_t index) const {
+		check_index(index);
+		return offsets[index + 1] - offsets[index];
+	}
+	bool empty() const {
+		return nodes_data.empty();
+	}
+
+	const T& getNodeData(size_t index) const {
+		check_index(index);
+		return nodes_data[index];
+	}
+	std::span<const vertex_id> neighbors(size_t index) const {
+		check_index(index);
+		return std::span<const vertex_id>(edge_targets.data() + offsets[index], degree(index));
+	}
+	std::span<const WEIGHT_TYPE> weights(size_t index) const requires weighted {
+		check_index(index);
+		return std::span<const WEIGHT_TYPE>(edge_weights.data() + offsets[index], degree(index));
+	}
+	CompactEdgeRange<WEIGHT_TYPE> outEdges(size_t index) const {
+		check_index(index);
+		if constexpr (weighted) {
+			return CompactEdgeRange<WEIGHT_TYPE>(edge_targets.data() + offsets[index], edge_weights.data() + offsets[index], degree(index));
+		}
+		else {
+			return CompactEdgeRange<WEIGHT_TYPE>(edge_targets.data() + offsets[index], degree(index));
+		}
+	}
+
+	bool hasEdgeOriented(size_t index_first, size_t index_second) const {
+		check_index(index_first);
+		for (vertex_id to : neighbors(index_first)) {
+			if (to == index_second) {
+				return true;
+			}
+		}
+		return false;
+	}
+	weight_type getEdgeWeightOriented(size_t index_first, size_t index_second) const {
+		check_index(index_first);
+		auto to = neighbors(index_first);
+		for (size_t i = 0; i < to.size(); ++i) {
+			if (to[i] == index_second) {
+				if constexpr (weighted) {
+					return edge_weights[offsets[index_first] + i];
+				}
+				else {
+					return 1;
+				}
+			}
+		}
+		return std::numeric_limits<weight_type>::max();
+	}
+
+	//Graph with every edge reversed and the same node data, O(V + E).
+	//The edges of every node stay in the order of their sources
+	CompactGraph<T, WEIGHT_TYPE> transposed() const {
+		std::vector<std::uint64_t> reverse_offsets(nodes_data.size() + 1, 0);
+		for (vertex_id to : edge_targets) {
+			++reverse_offsets[to + 1];
+		}
+		for (size_t i = 0; i < nodes_data.size(); ++i) {
+			reverse_offsets[i + 1] += reverse_offsets[i];
+		}
+
+		std::vector<std::uint64_t> position(reverse_offsets.begin(), reverse_offsets.end() - 1);
+		std::vector<vertex_id> reverse_targets(edge_targets.size());
+		std::vector<weight_type> reverse_weights(edge_weights.size());
+		for (size_t from = 0; from < nodes_data.size(); ++from) {
+			for (std::uint64_t i = offsets[from]; i < offsets[from + 1]; ++i) {
+				std::uint64_t slot = position[edge_targets[i]]++;
+				reverse_targets[slot] = static_cast<vertex_id>(from);
+				if constexpr (weighted) {
+					reverse_weights[slot] = edge_weights[i];
+				}
+			}
+		}
+		return CompactGraph<T, WEIGHT_TYPE>(nodes_data, std::move(reverse_offsets), std::move(reverse_targets), std::move(reverse_weights));
+	}
+
+	//Graph with node i renumbered to permutation.newIndex(i) and the same edges, O(V + E).
+	//The edges of every node keep their order
+	CompactGraph<T, WEIGHT_TYPE> permuted(const Permutation& permutation) const {
+		if (permutation.size() != nodes_data.size()) {
+			throw graph_library::GraphException("The permutation does not match the amount of nodes");
+		}
+		std::vector<T> permuted_data = permutation.toNewOrder(nodes_data);
+		std::vector<std::uint64_t> permuted_offsets(nodes_data.size() + 1, 0);
+		for (size_t index = 0; index < nodes_data.size(); ++index) {
+			permuted_offsets[index + 1] = permuted_offsets[index] + degree(permutation.originalIndex(index));
+		}
+
+		std::vector<vertex_id> permuted_targets(edge_targets.size());
+		std::vector<weight_type> permuted_weights(edge_weights.size());
+		for (size_t index = 0; index < nodes_data.size(); ++index) {
+			size_t original = permutation.originalIndex(index);
+			std::uint64_t slot = permuted_offsets[index];
+			for (std::uint64_t i = offsets[original]; i < offsets[original + 1]; ++i, ++slot) {
+				permuted_targets[slot] = static_cast<vertex_id>(permutation.newIndex(edge_targets[i]));
+				if constexpr (weighted) {
+					permuted_weights[slot] = edge_weights[i];
+				}
+			}
+		}
+		return CompactGraph<T, WEIGHT_TYPE>(std::move(permuted_data), std::move(permuted_offsets), std::move(permuted_targets),
+			std::move(permuted_weights));
+	}
+
+	//Raw CSR arrays
+	const std::vector<T>& getNodesData() const {
+		return nodes_data;
+	}
+	const std::vector<std::uint64_t>& getOffsets() const {
+		return offsets;
+	}
+	const std::vector<vertex_id>& getTargets() const {
+		return edge_targets;
+	}
+	const std::vector<WEIGHT_TYPE>& getWeights() const requires weighted {
+		return edge_weights;
+	}
+};
@@ -0,0 +1,298 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+//Optional index of the connected components of a graph, edges count in both directions.
+//Every node stores the id of its component directly (label), so queries only read it and never change the index.
+//Every component keeps its size and a doubly linked circle of its nodes (next, prev).
+//Adding an edge between two components relabels the smaller one, so a node is relabelled at most log V times
+//while edges are added. Removing edges is handled at once: two searches from the ends of a removed edge run in
+//turns, the side whose search runs out first is a component of its own and gets a new id. The searches do about
+//twice the work of the smaller side when the component splits; when it does not, they stop once they meet,
+//which in the worst case (ends far apart in a large component) costs O(V + E) of that component.
+//Ids of vanished components are reused
+class ComponentIndex {
+private:
+	std::vector<std::uint32_t> label;
+	std::vector<std::uint32_t> next;
+	std::vector<std::uint32_t> prev;
+	//Amount of nodes of every id, 0 for unused ids, and the unused ids
+	std::vector<std::uint32_t> sizes;
+	std::vector<std::uint32_t> free_ids;
+	size_t amount_sets = 0;
+	//Marks of the two searches of split(): nodes reached from the first end get mark_stamp, from the second mark_stamp + 1
+	std::vector<std::uint32_t> marks;
+	std::uint32_t mark_stamp = 0;
+	bool enabled = false;
+
+	std::uint32_t new_id() {
+		++amount_sets;
+		if (!free_ids.empty()) {
+			std::uint32_t id = free_ids.back();
+			free_ids.pop_back();
+			return id;
+		}
+		sizes.push_back(0);
+		return static_cast<std::uint32_t>(sizes.size() - 1);
+	}
+	void free_id(std::uint32_t id) {
+		--amount_sets;
+		sizes[id] = 0;
+		free_ids.push_back(id);
+	}
+	void make_single(size_t index) {
+		std::uint32_t id = new_id();
+		label[index] = id;
+		sizes[id] = 1;
+		next[index] = prev[index] = static_cast<std::uint32_t>(index);
+	}
+	void unlink(size_t index) {
+		next[prev[index]] = next[index];
+		prev[next[index]] = prev[index];
+		next[index] = prev[index] = static_cast<std::uint32_t>(index);
+	}
+	//Joins the circles of two nodes into one
+	void splice(size_t first, size_t second) {
+		std::uint32_t after_first = next[first];
+		std::uint32_t after_second = next[second];
+		next[first] = after_second;
+		prev[after_second] = static_cast<std::uint32_t>(first);
+		next[second] = after_first;
+		prev[after_first] = static_cast<std::uint32_t>(second);
+	}
+	void next_stamp() {
+		if (mark_stamp >= std::numeric_limits<std::uint32_t>::max() - 2) {
+			std::fill(marks.begin(), marks.end(), 0);
+			mark_stamp = 0;
+		}
+		mark_stamp += 2;
+	}
+
+	//Breadth-first search of one side of split(), expanded one node at a time
+	struct Search {
+		std::vector<std::uint32_t> reached;
+		size_t head = 0;
+		size_t work = 0;
+
+		bool exhausted() const {
+			return head == reached.size();
+		}
+	};
+	Search first_search;
+	Search second_search;
+
+	//Expands the next node of the search. Returns true once it reaches a node of the other search
+	template <typename NEIGHBOURS>
+	bool expand(Search& search, std::uint32_t own, std::uint32_t other, const NEIGHBOURS& neighbours) {
+		size_t index = search.reached[search.head++];
+		bool met = false;
+		neighbours(index, [&](size_t to) {
+			++search.work;
+			if (met || marks[to] == own) {
+				return;
+			}
+			if (marks[to] == other) {
+				met = true;
+				return;
+			}
+			marks[to] = own;
+			search.reached.push_back(static_cast<std::uint32_t>(to));
+			});
+		return met;
+	}
+	//first and second were in one component and an edge between them or on a path between them was removed.
+	//If they are still joined nothing changes, otherwise the side found first becomes a new component.
+	//Returns false if the component split
+	template <typename NEIGHBOURS>
+	bool split(size_t first, size_t second, const NEIGHBOURS& neighbours) {
+		if (first == second) {
+			return true;
+		}
+		next_stamp();
+		const std::uint32_t first_mark = mark_stamp;
+		const std::uint32_t second_mark = mark_stamp + 1;
+		first_search.reached.assign(1, static_cast<std::uint32_t>(first));
+		second_search.reached.assign(1, static_cast<std::uint32_t>(second));
+		first_search.head = second_search.head = 0;
+		first_search.work = second_search.work = 0;
+		marks[first] = first_mark;
+		marks[second] = second_mark;
+
+		//The search that did less work goes on, so the cost follows the smaller side
+		while (!first_search.exhausted() && !second_search.exhausted()) {
+			bool met = first_search.work <= second_search.work ?
+				expand(first_search, first_mark, second_mark, neighbours) : expand(second_search, second_mark, first_mark, neighbours);
+			if (met) {
+				return true;
+			}
+		}
+		const Search& side = first_search.exhausted() ? first_search : second_search;
+		const std::uint32_t old_id = label[side.reached.front()];
+		const std::uint32_t id = new_id();
+		for (std::uint32_t member : side.reached) {
+			unlink(member);
+			label[member] = id;
+		}
+		for (size_t i = 1; i < side.reached.size(); ++i) {
+			splice(side.reached[0], side.reached[i]);
+		}
+		sizes[id] = static_cast<std::uint32_t>(side.reached.size());
+		sizes[old_id] -= sizes[id];
+		return false;
+	}
+public:
+	//Main functions
+	bool is_enabled() const {
+		return enabled;
+	}
+	//Builds the index from the edge lists, O(V + E + V log V)
+	template <typename LISTS>
+	void enable(const LISTS& adj_list) {
+		enabled = true;
+		rebuild(adj_list);
+	}
+	void disable() {
+		enabled = false;
+		clear();
+	}
+	void clear() {
+		label.clear();
+		next.clear();
+		prev.clear();
+		sizes.clear();
+		free_ids.clear();
+		marks.clear();
+		first_search = Search();
+		second_search = Search();
+		mark_stamp = 0;
+		amount_sets = 0;
+	}
+	template <typename LISTS>
+	void rebuild(const LISTS& adj_list) {
+		if (!enabled) {
+			return;
+		}
+		clear();
+		label.resize(adj_list.size());
+		next.resize(adj_list.size());
+		prev.resize(adj_list.size());
+		marks.assign(adj_list.size(), 0);
+		sizes.reserve(adj_list.size());
+		for (size_t i = 0; i < adj_list.size(); ++i) {
+			make_single(i);
+		}
+		for (size_t i = 0; i < adj_list.size(); ++i) {
+			for (const auto& edge : adj_list[i]) {
+				unite(i, edge.get_to_index());
+			}
+		}
+	}
+	//Every node becomes a component of its own, for a graph without edges
+	void reset() {
+		if (!enabled) {
+			return;
+		}
+		size_t amount = label.size();
+		sizes.clear();
+		free_ids.clear();
+		amount_sets = 0;
+		for (size_t i = 0; i < amount; ++i) {
+			make_single(i);
+		}
+	}
+	//A new node without edges
+	void push_back() {
+		if (!enabled) {
+			return;
+		}
+		label.push_back(0);
+		next.push_back(0);
+		prev.push_back(0);
+		marks.push_back(0);
+		make_single(label.size() - 1);
+	}
+
+	//Merges the components of an added edge, relabelling the smaller one
+	void unite(size_t first, size_t second) {
+		if (!enabled || label[first] == label[second]) {
+			return;
+		}
+		if (sizes[label[first]] < sizes[label[second]]) {
+			std::swap(first, second);
+		}
+		const std::uint32_t id = label[first];
+		const std::uint32_t old_id = label[second];
+		size_t current = second;
+		do {
+			label[current] = id;
+			current = next[current];
+		} while (current != second);
+		sizes[id] += sizes[old_id];
+		free_id(old_id);
+		splice(first, second);
+	}
+	//An edge first -> second was removed, neighbours(index, f) calls f for every node joined to index by an edge
+	//in either direction
+	template <typename NEIGHBOURS>
+	void remove_edge(size_t first, size_t second, const NEIGHBOURS& neighbours) {
+		if (enabled) {
+			split(first, second, neighbours);
+		}
+	}
+	//Edges between nodes of one component were removed, endpoints are their ends (duplicates allowed).
+	//Every endpoint is checked against an anchor endpoint; when the anchor itself is split off,
+	//the next endpoint still in the old component takes its place
+	template <typename NEIGHBOURS>
+	void remove_edges(const std::vector<std::uint32_t>& endpoints, const NEIGHBOURS& neighbours) {
+		if (!enabled || endpoints.empty()) {
+			return;
+		}
+		const std::uint32_t old_id = label[endpoints.front()];
+		size_t anchor = endpoints.front();
+		for (std::uint32_t endpoint : endpoints) {
+			if (label[endpoint] != old_id) {
+				continue;
+			}
+			if (label[anchor] != old_id) {
+				anchor = endpoint;
+			}
+			else if (!split(anchor, endpoint, neighbours) && label[anchor] != old_id) {
+				anchor = endpoint;
+			}
+		}
+	}
+	//The node lost all its edges, endpoints are the nodes they led to or came from.
+	//The node becomes a component of its own, then the endpoints are checked as by remove_edges
+	template <typename NEIGHBOURS>
+	void isolate(size_t index, const std::vector<std::uint32_t>& endpoints, const NEIGHBOURS& neighbours) {
+		if (!enabled) {
+			return;
+		}
+		const std::uint32_t old_id = label[index];
+		if (sizes[old_id] == 1) {
+			return;
+		}
+		unlink(index);
+		--sizes[old_id];
+		std::uint32_t id = new_id();
+		label[index] = id;
+		sizes[id] = 1;
+		remove_edges(endpoints, neighbours);
+	}
+
+	//Queries, O(1) and without changes, so const graphs can be queried from several threads
+	size_t component_of(size_t index) const {
+		return label[index];
+	}
+	size_t amount_components() const {
+		return amount_sets;
+	}
+	size_t memory_footprint() const {
+		return (label.capacity() + next.capacity() + prev.capacity() + sizes.capacity() + free_ids.capacity() + marks.capacity() +
+			first_search.reached.capacity() + second_search.reached.capacity()) * sizeof(std::uint32_t);
+	}
+};
@@ -0,0 +1,515 @@
+#pragma once
+#include "compact_graph.hpp"
+#include "edge_record.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+//Array of unsigned integers of a fixed bit width, packed one after another into 64-bit words
+class BitPackedArray {
+private:
+	std::vector<std::uint64_t> words;
+	size_t amount = 0;
+	unsigned width = 0;
+public:
+	BitPackedArray() = default;
+	BitPackedArray(size_t _amount, unsigned _width) : words((_amount * _width + 63) / 64 + 1, 0), amount(_amount), width(_width) {
+		if (width > 64) {
+			throw graph_library::GraphException("Bit width above 64");
+		}
+	}
+
+	//The value must fit into width bits
+	void set(size_t index, std::uint64_t value) {
+		if (width == 0) {
+			return;
+		}
+		size_t bit = index * width;
+		size_t word = bit / 64;
+		unsigned shift = bit % 64;
+		words[word] |= value << shift;
+		if (shift + width > 64) {
+			words[word + 1] |= value >> (64 - shift);
+		}
+	}
+	std::uint64_t get(size_t index) const {
+		if (width == 0) {
+			return 0;
+		}
+		size_t bit = index * width;
+		size_t word = bit / 64;
+		unsigned shift = bit % 64;
+		std::uint64_t value = words[word] >> shift;
+		if (shift + width > 64) {
+			value |= words[word + 1] << (64 - shift);
+		}
+		return width == 64 ? value : value & ((std::uint64_t(1) << width) - 1);
+	}
+	//Appends a value that fits into width bits
+	void push_back(std::uint64_t value) {
+		++amount;
+		size_t needed = (amount * width + 63) / 64 + 1;
+		if (words.size() < needed) {
+			words.resize(needed, 0);
+		}
+		set(amount - 1, value);
+	}
+	void reserve(size_t _amount) {
+		words.reserve((_amount * width + 63) / 64 + 1);
+	}
+	void shrinkToFit() {
+		words.shrink_to_fit();
+	}
+	size_t size() const {
+		return amount;
+	}
+	unsigned bitWidth() const {
+		return width;
+	}
+	size_t memoryFootprint() const {
+		return words.capacity() * sizeof(std::uint64_t);
+	}
+};
+
+//Lossless mapping of an arithmetic weight to an unsigned key of the same size: integers by their
+//two's complement, floating point numbers by their bits. Keys are stored as offsets from the smallest key
+template <typename WEIGHT_TYPE>
+struct WeightKey {
+	static_assert(std::is_arithmetic_v<WEIGHT_TYPE> && !std::is_same_v<WEIGHT_TYPE, bool> && sizeof(WEIGHT_TYPE) <= 8,
+		"CompressedGraph packs integer and floating point weights of up to 64 bits");
+	using type = typename std::conditional_t<std::is_floating_point_v<WEIGHT_TYPE>,
+		std::conditional<sizeof(WEIGHT_TYPE) == 4, std::uint32_t, std::uint64_t>, std::make_unsigned<WEIGHT_TYPE>>::type;
+
+	static type toKey(WEIGHT_TYPE weight) {
+		if constexpr (std::is_floating_point_v<WEIGHT_TYPE>) {
+			return std::bit_cast<type>(weight);
+		}
+		else {
+			return static_cast<type>(weight);
+		}
+	}
+	static WEIGHT_TYPE fromKey(type key) {
+		if constexpr (std::is_floating_point_v<WEIGHT_TYPE>) {
+			return std::bit_cast<WEIGHT_TYPE>(key);
+		}
+		else {
+			return static_cast<WEIGHT_TYPE>(key);
+		}
+	}
+};
+
+//LEB128: 7 bits per byte, the high bit marks that another byte follows
+inline std::uint64_t read_varint(const std::uint8_t*& position) {
+	std::uint64_t value = *position++;
+	if (value < 0x80) {
+		return value;
+	}
+	value &= 0x7F;
+	for (unsigned shift = 7;; shift += 7) {
+		std::uint64_t byte = *position++;
+		value |= (byte & 0x7F) << shift;
+		if (byte < 0x80) {
+			return value;
+		}
+	}
+}
+
+//Range over the edges of one node of a CompressedGraph, decodes the targets while it is iterated
+template <typename WEIGHT_TYPE>
+class CompressedEdgeRange {
+private:
+	using key_type = typename WeightKey<std::conditional_t<is_weighted_v<WEIGHT_TYPE>, WEIGHT_TYPE, int>>::type;
+
+	const std::uint8_t* bytes;
+	size_t from;
+	size_t amount;
+	//Weight column and the position of the first edge of the node in it, unused for unweighted graphs
+	const BitPackedArray* weights;
+	size_t first_edge;
+	key_type min_key;
+public:
+	class iterator {
+	private:
+		const std::uint8_t* position = nullptr;
+		size_t remaining = 0;
+		size_t target = 0;
+		const BitPackedArray* weights = nullptr;
+		size_t edge = 0;
+		key_type min_key = 0;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = CompactEdge<WEIGHT_TYPE>;
+		using difference_type = std::ptrdiff_t;
+		using reference = CompactEdge<WEIGHT_TYPE>;
+		using pointer = void;
+
+		iterator() = default;
+		explicit iterator(const CompressedEdgeRange& range)
+			: position(range.bytes), remaining(range.amount), weights(range.weights), edge(range.first_edge), min_key(range.min_key)
+		{
+			if (remaining != 0) {
+				//The first target is stored relative to the node, zigzag encoded
+				std::uint64_t delta = read_varint(position);
+				target = range.from + static_cast<size_t>((delta >> 1) ^ (~(delta & 1) + 1));
+			}
+		}
+
+		CompactEdge<WEIGHT_TYPE> operator*() const {
+			if constexpr (is_weighted_v<WEIGHT_TYPE>) {
+				key_type key = static_cast<key_type>(min_key + weights->get(edge));
+				return CompactEdge<WEIGHT_TYPE>(static_cast<std::uint32_t>(target), WeightKey<WEIGHT_TYPE>::fromKey(key));
+			}
+			else {
+				return CompactEdge<WEIGHT_TYPE>(static_cast<std::uint32_t>(target));
+			}
+		}
+		iterator& operator++() {
+			++edge;
+			if (--remaining != 0) {
+				target += static_cast<size_t>(read_varint(position));
+			}
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator result = *this;
+			++*this;
+			return result;
+		}
+		//Iterators of one range are equal when the same amount of edges is left
+		bool operator==(const iterator& other) const {
+			return remaining == other.remaining;
+		}
+	};
+
+	CompressedEdgeRange(const std::uint8_t* _bytes, size_t _from, size_t _amount, const BitPackedArray* _weights = nullptr,
+		size_t _first_edge = 0, key_type _min_key = 0)
+		: bytes(_bytes), from(_from), amount(_amount), weights(_weights), first_edge(_first_edge), min_key(_min_key) {}
+
+	iterator begin() const {
+		return iterator(*this);
+	}
+	iterator end() const {
+		return iterator();
+	}
+	size_t size() const {
+		return amount;
+	}
+	bool empty() const {
+		return amount == 0;
+	}
+};
+
+template <typename T, typename WEIGHT_TYPE>
+class CompressedGraphBuilder;
+
+/*
+Read-only compressed snapshot of a graph for graphs that do not fit into memory as a CompactGraph.
+The edges of every node are sorted by target and stored in one byte stream: the degree, then the first
+target relative to the node (zigzag encoded) and the gaps to the following targets, all as LEB128 varints.
+Weights go to a bit-packed column as offsets from the smallest weight, with as many bits as their range
+needs, so a graph with few distinct weights pays a few bits per edge. outEdges decodes on the fly,
+so every algorithm written against AdjacencyGraph runs on it directly.
+Node indices are the same as in the snapshot it was made from, the edges of a node come in ascending target order.
+It is made from a CompactGraph, or without one by CompressedGraphBuilder from edges sorted by source
+or by MappedGraph::toCompressedGraph from a binary graph file.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class CompressedGraph {
+public:
+	using weight_type = weight_value_t<WEIGHT_TYPE>;
+	static constexpr bool weighted = is_weighted_v<WEIGHT_TYPE>;
+private:
+	using key_type = typename WeightKey<std::conditional_t<weighted, WEIGHT_TYPE, int>>::type;
+
+	friend class CompressedGraphBuilder<T, WEIGHT_TYPE>;
+
+	std::vector<T> nodes_data;
+	//Start of the edges of node i in the byte stream
+	std::vector<std::uint64_t> byte_offsets;
+	std::vector<std::uint8_t> bytes;
+	//Position of the first edge of node i in the weight column, empty for an unweighted graph
+	std::vector<std::uint64_t> edge_offsets;
+	BitPackedArray weights;
+	key_type min_key = 0;
+	size_t amount_edges = 0;
+
+	void check_index(size_t index) const {
+		if (index >= nodes_data.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+	}
+	void write_varint(std::uint64_t value) {
+		while (value >= 0x80) {
+			bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		bytes.push_back(static_cast<std::uint8_t>(value));
+	}
+	//Empty weight column of the given bit width, before the first node is appended
+	void start_weights(unsigned width) {
+		if constexpr (weighted) {
+			weights = BitPackedArray(0, width);
+			edge_offsets.assign(1, 0);
+		}
+	}
+	//Encodes the edges of the next node, sorting them by target first.
+	//The weight keys must lie within the bit width of the column above min_key
+	void append_node(std::vector<std::pair<std::uint32_t, weight_type>>& edges) {
+		const size_t index = byte_offsets.size() - 1;
+		std::sort(edges.begin(), edges.end(), [](const auto& first, const auto& second) {
+			return first.first < second.first;
+			});
+
+		write_varint(edges.size());
+		for (size_t k = 0; k < edges.size(); ++k) {
+			if (k == 0) {
+				std::int64_t delta = static_cast<std::int64_t>(edges[k].first) - static_cast<std::int64_t>(index);
+				write_varint((static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+			}
+			else {
+				write_varint(edges[k].first - edges[k - 1].first);
+			}
+			if constexpr (weighted) {
+				weights.push_back(static_cast<key_type>(WeightKey<WEIGHT_TYPE>::toKey(edges[k].second) - min_key));
+			}
+		}
+		amount_edges += edges.size();
+		byte_offsets.push_back(bytes.size());
+		if constexpr (weighted) {
+			edge_offsets.push_back(amount_edges);
+		}
+	}
+public:
+	//Constructors and destructor
+	CompressedGraph() : byte_offsets(1, 0) {}
+	//O(V + E log(max degree)), the edges of every node are sorted
+	explicit CompressedGraph(const CompactGraph<T, WEIGHT_TYPE>& compact) : CompressedGraph() {
+		const size_t amount_nodes = compact.getAmountNodes();
+		nodes_data = compact.getNodesData();
+		byte_offsets.reserve(amount_nodes + 1);
+		if constexpr (weighted) {
+			const auto& all_weights = compact.getWeights();
+			key_type max_key = 0;
+			if (!all_weights.empty()) {
+				min_key = std::numeric_limits<key_type>::max();
+				for (WEIGHT_TYPE weight : all_weights) {
+					min_key = std::min(min_key, WeightKey<WEIGHT_TYPE>::toKey(weight));
+					max_key = std::max(max_key, WeightKey<WEIGHT_TYPE>::toKey(weight));
+				}
+			}
+			start_weights(static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(max_key - min_key))));
+			weights.reserve(compact.getAmountEdge());
+			edge_offsets.reserve(amount_nodes + 1);
+		}
+
+		//About one byte per edge for a graph whose nodes are numbered with some locality
+		bytes.reserve(compact.getAmountEdge() + amount_nodes);
+		std::vector<std::pair<std::uint32_t, weight_type>> edges;
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			edges.clear();
+			for (const auto& edge : compact.outEdges(index)) {
+				edges.emplace_back(static_cast<std::uint32_t>(edge.get_to_index()), edge.get_weight());
+			}
+			append_node(edges);
+		}
+		bytes.shrink_to_fit();
+	}
+	CompressedGraph(const CompressedGraph<T, WEIGHT_TYPE>& other) = default;
+	CompressedGraph(CompressedGraph<T, WEIGHT_TYPE>&& other) noexcept = default;
+	~CompressedGraph() = default;
+
+	//Operators
+	CompressedGraph<T, WEIGHT_TYPE>& operator=(const CompressedGraph<T, WEIGHT_TYPE>& other) = default;
+	CompressedGraph<T, WEIGHT_TYPE>& operator=(CompressedGraph<T, WEIGHT_TYPE>&& other) noexcept = default;
+
+
+	//----------- M A I N   F U N C T I O N S ---------
+
+
+	size_t getAmountNodes() const {
+		return nodes_data.size();
+	}
+	size_t getAmountEdge() const {
+		return amount_edges;
+	}
+	//Decodes the degree stored in front of the edges
+	size_t degree(size_t index) const {
+		const std::uint8_t* position = bytes.data() + byte_offsets[index];
+		return static_cast<size_t>(read_varint(position));
+	}
+	bool empty() const {
+		return nodes_data.empty();
+	}
+
+	const T& getNodeData(size_t index) const {
+		check_index(index);
+		return nodes_data[index];
+	}
+	CompressedEdgeRange<WEIGHT_TYPE> outEdges(size_t index) const {
+		const std::uint8_t* position = bytes.data() + byte_offsets[index];
+		size_t amount = static_cast<size_t>(read_varint(position));
+		if constexpr (weighted) {
+			return CompressedEdgeRange<WEIGHT_TYPE>(position, index, amount, &weights, edge_offsets[index], min_key);
+		}
+		else {
+			return CompressedEdgeRange<WEIGHT_TYPE>(position, index, amount);
+		}
+	}
+
+	//CSR snapshot with the same nodes and edges, the edges of every node sorted by target
+	CompactGraph<T, WEIGHT_TYPE> decompressed() const {
+		std::vector<std::uint64_t> offsets(nodes_data.size() + 1, 0);
+		std::vector<typename CompactGraph<T, WEIGHT_TYPE>::vertex_id> targets;
+		std::vector<weight_type> decoded_weights;
+		targets.reserve(amount_edges);
+		if constexpr (weighted) {
+			decoded_weights.reserve(amount_edges);
+		}
+		for (size_t index = 0; index < nodes_data.size(); ++index) {
+			for (const auto& edge : outEdges(index)) {
+				targets.push_back(static_cast<std::uint32_t>(edge.get_to_index()));
+				if constexpr (weighted) {
+					decoded_weights.push_back(edge.get_weight());
+				}
+			}
+			offsets[index + 1] = targets.size();
+		}
+		return CompactGraph<T, WEIGHT_TYPE>(nodes_data, std::move(offsets), std::move(targets), std::move(decoded_weights));
+	}
+
+	//Bits every weight takes in the weight column, 0 for an unweighted graph or a single weight
+	unsigned weightBits() const {
+		return weights.bitWidth();
+	}
+	//Bytes of the node data, the offsets, the byte stream and the weight column. Heap memory owned by T itself is not counted
+	size_t memoryFootprint() const {
+		return sizeof(*this) + nodes_data.capacity() * sizeof(T) + byte_offsets.capacity() * sizeof(std::uint64_t) +
+			bytes.capacity() + edge_offsets.capacity() * sizeof(std::uint64_t) + weights.memoryFootprint();
+	}
+};
+
+/*
+Builds a CompressedGraph from edges sorted by source without a CompactGraph in between. A node is encoded
+as soon as an edge of a later source arrives, so besides the compressed graph only the edges of one node are held:
+	CompressedGraphBuilder<int> builder(amount_nodes, min_weight, max_weight);
+	builder.addEdges(batch);
+	CompressedGraph<int> graph = builder.build();
+The batches may be read from a file one after another; together they list the sources in ascending order,
+the targets of one source in any order. The bit width of the weight column is fixed by the weight range
+given up front, without a range every weight takes all bits of its type.
+The amount of nodes grows to the largest index used by an edge.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class CompressedGraphBuilder {
+public:
+	using weight_type = weight_value_t<WEIGHT_TYPE>;
+	static constexpr bool weighted = is_weighted_v<WEIGHT_TYPE>;
+private:
+	using key_type = typename WeightKey<std::conditional_t<weighted, WEIGHT_TYPE, int>>::type;
+
+	CompressedGraph<T, WEIGHT_TYPE> graph;
+	std::vector<T> nodes_data;
+	size_t amount_nodes;
+	//Weight keys the column holds: min_key and up to max_offset above it
+	key_type min_key = 0;
+	key_type max_offset = std::numeric_limits<key_type>::max();
+	//Source of the collected edges, every node before it is encoded
+	size_t current = 0;
+	std::vector<std::pair<std::uint32_t, weight_type>> pending;
+
+	void start() {
+		graph = CompressedGraph<T, WEIGHT_TYPE>();
+		graph.min_key = min_key;
+		graph.start_weights(weighted ? static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(max_offset))) : 0);
+		current = 0;
+		pending.clear();
+	}
+	//Encodes every node before end
+	void encode_until(size_t end) {
+		while (current < end) {
+			graph.append_node(pending);
+			pending.clear();
+			++current;
+		}
+	}
+public:
+	explicit CompressedGraphBuilder(size_t _amount_nodes = 0) : amount_nodes(_amount_nodes) {
+		start();
+	}
+	//Weights outside [min_weight, max_weight] are rejected. Floating point weights get a narrower column
+	//only for a range of non-negative weights, their bits are ordered like their values only there
+	CompressedGraphBuilder(size_t _amount_nodes, weight_type min_weight, weight_type max_weight) requires weighted
+		: amount_nodes(_amount_nodes)
+	{
+		if (max_weight < min_weight) {
+			throw graph_library::GraphException("Empty weight range");
+		}
+		bool narrow = true;
+		if constexpr (std::is_floating_point_v<WEIGHT_TYPE>) {
+			narrow = !std::signbit(min_weight);
+		}
+		if (narrow) {
+			min_key = WeightKey<WEIGHT_TYPE>::toKey(min_weight);
+			max_offset = static_cast<key_type>(WeightKey<WEIGHT_TYPE>::toKey(max_weight) - min_key);
+		}
+		start();
+	}
+
+	size_t getAmountNodes() const {
+		return amount_nodes;
+	}
+	size_t getAmountEdge() const {
+		return graph.amount_edges + pending.size();
+	}
+	//Data of every node, the amount of nodes becomes at least data.size()
+	void setNodesData(std::vector<T> data) {
+		amount_nodes = std::max(amount_nodes, data.size());
+		nodes_data = std::move(data);
+	}
+
+	//The source must not be below the source of the previous edge
+	void addEdge(size_t from, size_t to, weight_type weight = weight_type()) {
+		if (from >= std::numeric_limits<std::uint32_t>::max() || to >= std::numeric_limits<std::uint32_t>::max()) {
+			throw graph_library::InvalidIndexException();
+		}
+		if (from < current) {
+			throw graph_library::GraphException("Edges are not sorted by source");
+		}
+		if constexpr (weighted) {
+			if (static_cast<key_type>(WeightKey<WEIGHT_TYPE>::toKey(weight) - min_key) > max_offset) {
+				throw graph_library::GraphException("Edge weight outside the range of the builder");
+			}
+		}
+		encode_until(from);
+		pending.emplace_back(static_cast<std::uint32_t>(to), weight);
+		amount_nodes = std::max(amount_nodes, std::max(from, to) + 1);
+	}
+	void addEdges(std::span<const EdgeRecord<weight_type>> edges) {
+		for (const auto& edge : edges) {
+			addEdge(edge.from, edge.to, edge.weight);
+		}
+	}
+
+	//Encodes the remaining nodes and leaves the builder empty with the same weight range. Nodes without data get T()
+	CompressedGraph<T, WEIGHT_TYPE> build() {
+		encode_until(amount_nodes);
+		nodes_data.resize(amount_nodes);
+		graph.nodes_data = std::move(nodes_data);
+		graph.bytes.shrink_to_fit();
+		graph.weights.shrinkToFit();
+		CompressedGraph<T, WEIGHT_TYPE> result = std::move(graph);
+		nodes_data.clear();
+		amount_nodes = 0;
+		start();
+		return result;
+	}
+};
@@ -0,0 +1,254 @@
+#pragma once
+#include "cow_graph.hpp"
+#include "../exceptions.hpp"
+#include <atomic>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+//Edge changes collected by a writer without locks and applied to a ConcurrentGraph as one version
+template <typename WEIGHT_TYPE = int>
+class GraphUpdateBatch {
+public:
+	enum class Kind : std::uint8_t {
+		ADD_EDGE,
+		ADD_EDGE_ORIENTED,
+		REMOVE_EDGE,
+		REMOVE_EDGE_ORIENTED,
+		SET_EDGE_WEIGHT
+	};
+	struct Operation {
+		Kind kind;
+		size_t first;
+		size_t second;
+		WEIGHT_TYPE weight;
+	};
+private:
+	std::vector<Operation> operations;
+public:
+	void addEdge(size_t index_first, size_t index_second, WEIGHT_TYPE weight = 0) {
+		operations.push_back({ Kind::ADD_EDGE, index_first, index_second, weight });
+	}
+	void addEdgeOriented(size_t index_first, size_t index_second, WEIGHT_TYPE weight = 0) {
+		operations.push_back({ Kind::ADD_EDGE_ORIENTED, index_first, index_second, weight });
+	}
+	void removeEdge(size_t index_first, size_t index_second) {
+		operations.push_back({ Kind::REMOVE_EDGE, index_first, index_second, WEIGHT_TYPE() });
+	}
+	void removeEdgeOriented(size_t index_first, size_t index_second) {
+		operations.push_back({ Kind::REMOVE_EDGE_ORIENTED, index_first, index_second, WEIGHT_TYPE() });
+	}
+	void setEdgeWeight(size_t index_first, size_t index_second, WEIGHT_TYPE weight) {
+		operations.push_back({ Kind::SET_EDGE_WEIGHT, index_first, index_second, weight });
+	}
+
+	//Applies the changes in the order they were added
+	template <typename T>
+	void applyTo(CowGraph<T, WEIGHT_TYPE>& graph) const {
+		for (const auto& operation : operations) {
+			switch (operation.kind) {
+			case Kind::ADD_EDGE:
+				graph.addEdge(operation.first, operation.second, operation.weight);
+				break;
+			case Kind::ADD_EDGE_ORIENTED:
+				graph.addEdgeOriented(operation.first, operation.second, operation.weight);
+				break;
+			case Kind::REMOVE_EDGE:
+				graph.removeEdge(operation.first, operation.second);
+				break;
+			case Kind::REMOVE_EDGE_ORIENTED:
+				graph.removeEdgeOriented(operation.first, operation.second);
+				break;
+			case Kind::SET_EDGE_WEIGHT:
+				graph.setEdgeWeight(operation.first, operation.second, operation.weight);
+				break;
+			}
+		}
+	}
+
+	const std::vector<Operation>& getOperations() const {
+		return operations;
+	}
+	size_t size() const {
+		return operations.size();
+	}
+	bool empty() const {
+		return operations.empty();
+	}
+	void clear() {
+		operations.clear();
+	}
+};
+
+/*
+Graph for concurrent readers and writers. Every change produces a new immutable version:
+	ConcurrentGraph<int> graph(CowGraph<int>(initial));
+	{
+		auto view = graph.read();	//no locks, the version stays valid while view lives
+		graph_library::bfs(view.graph(), 0);
+	}
+	GraphUpdateBatch<int> batch;
+	batch.addEdge(1, 2, 5);
+	graph.apply(batch);			//readers see all of the batch or none of it
+Writers copy the current version (a CowGraph, so only the blocks they touch are copied), change the copy
+and publish it with one atomic store. Writers are serialized among themselves, readers never wait for them.
+Replaced versions are freed by epoch-based reclamation: a version retired in epoch r is freed once every
+active reader has entered an epoch after r. A reader that holds a view for long delays the freeing of
+the versions published meanwhile, not the writers.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class ConcurrentGraph {
+public:
+	//Readers active at the same time; more readers wait for a free slot
+	static constexpr size_t READER_SLOTS = 128;
+	using graph_type = CowGraph<T, WEIGHT_TYPE>;
+private:
+	struct Version {
+		graph_type graph;
+		std::uint64_t number;
+	};
+	struct Retired {
+		std::unique_ptr<const Version> version;
+		std::uint64_t epoch;
+	};
+	//Epoch the reader entered, 0 if the slot is free. One cache line per slot
+	struct alignas(64) ReaderSlot {
+		std::atomic<std::uint64_t> epoch{ 0 };
+	};
+
+	std::atomic<const Version*> current;
+	std::atomic<std::uint64_t> global_epoch{ 1 };
+	std::array<ReaderSlot, READER_SLOTS> slots;
+	//Guards writing, retired and the version numbers
+	std::mutex writer_mutex;
+	std::vector<Retired> retired;
+
+	ReaderSlot& enter() {
+		//Threads start at different slots, so a slot is usually free at the first try
+		size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+		for (size_t attempt = 0;; ++attempt) {
+			ReaderSlot& slot = slots[(start + attempt) % READER_SLOTS];
+			std::uint64_t expected = 0;
+			if (slot.epoch.load(std::memory_order_relaxed) == 0 &&
+				slot.epoch.compare_exchange_strong(expected, global_epoch.load())) {
+				return slot;
+			}
+			if (attempt % READER_SLOTS == READER_SLOTS - 1) {
+				std::this_thread::yield();
+			}
+		}
+	}
+	//Frees the retired versions no active reader can see. Called with writer_mutex held
+	void reclaim_retired() {
+		std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+		for (const auto& slot : slots) {
+			std::uint64_t epoch = slot.epoch.load();
+			if (epoch != 0) {
+				oldest = std::min(oldest, epoch);
+			}
+		}
+		std::erase_if(retired, [oldest](const Retired& entry) {
+			return entry.epoch < oldest;
+			});
+	}
+	void publish(graph_type&& graph) {
+		auto version = std::make_unique<const Version>(Version{ std::move(graph), current.load()->number + 1 });
+		const Version* previous = current.exchange(version.release());
+		//Readers that entered up to this epoch may still hold previous
+		std::uint64_t epoch = global_epoch.fetch_add(1);
+		retired.push_back({ std::unique_ptr<const Version>(previous), epoch });
+		reclaim_retired();
+	}
+public:
+	//Consistent read-only view of one version, keeps it alive until destroyed
+	class ReadGuard {
+	private:
+		ReaderSlot* slot;
+		const Version* version;
+
+		friend class ConcurrentGraph<T, WEIGHT_TYPE>;
+		ReadGuard(ReaderSlot* _slot, const Version* _version) : slot(_slot), version(_version) {}
+	public:
+		ReadGuard(const ReadGuard&) = delete;
+		ReadGuard& operator=(const ReadGuard&) = delete;
+		ReadGuard(ReadGuard&& other) noexcept : slot(std::exchange(other.slot, nullptr)), version(other.version) {}
+		ReadGuard& operator=(ReadGuard&&) = delete;
+		~ReadGuard() {
+			if (slot != nullptr) {
+				slot->epoch.store(0, std::memory_order_release);
+			}
+		}
+
+		const graph_type& graph() const {
+			return version->graph;
+		}
+		const graph_type* operator->() const {
+			return &version->graph;
+		}
+		//Number of the version, grows by one with every published change
+		std::uint64_t versionNumber() const {
+			return version->number;
+		}
+		//Copy that stays valid after the guard is gone, O(V / BLOCK_SIZE)
+		graph_type snapshot() const {
+			return version->graph;
+		}
+	};
+
+	//Constructors and destructor
+	ConcurrentGraph() : ConcurrentGraph(graph_type()) {}
+	explicit ConcurrentGraph(graph_type initial) : current(new Version{ std::move(initial), 0 }) {}
+	ConcurrentGraph(const ConcurrentGraph&) = delete;
+	ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+	//No reader may be active
+	~ConcurrentGraph() {
+		delete current.load();
+	}
+
+
+	//----------- M A I N   F U N C T I O N S ---------
+
+
+	//Lock-free: a compare-exchange on a reader slot and an atomic load of the current version
+	ReadGuard read() {
+		ReaderSlot& slot = enter();
+		return ReadGuard(&slot, current.load());
+	}
+
+	//Applies the whole batch as one version. If an operation throws, nothing is published
+	void apply(const GraphUpdateBatch<WEIGHT_TYPE>& batch) {
+		update([&batch](graph_type& graph) {
+			batch.applyTo(graph);
+			});
+	}
+	//Calls change on a copy of the current version and publishes the copy. If change throws, nothing is published
+	template <typename FUNCTION>
+	void update(FUNCTION&& change) {
+		std::lock_guard<std::mutex> lock(writer_mutex);
+		graph_type graph = current.load()->graph;
+		change(graph);
+		publish(std::move(graph));
+	}
+
+	std::uint64_t versionNumber() const {
+		return current.load()->number;
+	}
+	//Versions replaced but not freed yet
+	size_t retiredVersions() {
+		std::lock_guard<std::mutex> lock(writer_mutex);
+		return retired.size();
+	}
+	//Frees the replaced versions that no reader can see any more
+	void reclaim() {
+		std::lock_guard<std::mutex> lock(writer_mutex);
+		reclaim_retired();
+	}
+};
@@ -0,0 +1,325 @@
+#pragma once
+#include "graph.hpp"
+#include "compact_graph.hpp"
+#include "edge.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Graph with copy-on-write snapshots. Nodes are numbered by index and stored in blocks of BLOCK_SIZE nodes,
+each block holds the data and the outgoing edges of its nodes and is shared between copies.
+Copying the graph copies only the table of blocks, O(V / BLOCK_SIZE), and a change copies the single block
+it touches, so a fork with a few edits costs memory proportional to the edits:
+	CowGraph<int> base(graph);
+	CowGraph<int> fork = base;
+	fork.addEdge(1, 2, 5);	//base is not changed
+Every block records the copy that may change it in place. Copying gives both graphs new owner tags, so each of them
+clones a block on its first change after the copy and changes its own clone in place from then on; the reference
+count of a block is never consulted. Different copies may be used from different threads,
+one copy may not be changed while another thread reads or copies it.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class CowGraph {
+public:
+	static constexpr size_t BLOCK_BITS = 6;
+	static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+	using edge_list = std::vector<Edge<T, WEIGHT_TYPE>>;
+private:
+	struct Block {
+		std::vector<T> data;
+		std::vector<edge_list> edges;
+		//Tag of the graph that created the block, the only one allowed to change it
+		std::uint64_t owner = 0;
+	};
+
+	std::vector<std::shared_ptr<const Block>> blocks;
+	size_t amount_nodes = 0;
+	size_t amount_edges = 0;
+	//Changed by copying, which only reads the graph otherwise: a graph copied from two threads at once gets two new tags
+	mutable std::atomic<std::uint64_t> owner;
+
+	static std::uint64_t next_owner() {
+		static std::atomic<std::uint64_t> counter(0);
+		return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+	//The blocks are shared with a copy now, none of them may be changed in place any more
+	void disown() const {
+		owner.store(next_owner(), std::memory_order_relaxed);
+	}
+
+	void check_index(size_t index) const {
+		if (index >= amount_nodes) {
+			throw graph_library::InvalidIndexException();
+		}
+	}
+	const Block& block_of(size_t index) const {
+		return *blocks[index >> BLOCK_BITS];
+	}
+	//The block of the node owned by this graph alone, cloned first if it was created before the last copy
+	Block& mutable_block_of(size_t index) {
+		auto& block = blocks[index >> BLOCK_BITS];
+		const std::uint64_t tag = owner.load(std::memory_order_relaxed);
+		if (block->owner != tag) {
+			auto clone = std::make_shared<Block>(*block);
+			clone->owner = tag;
+			block = std::move(clone);
+		}
+		return const_cast<Block&>(*block);
+	}
+	edge_list& mutable_edges(size_t index) {
+		return mutable_block_of(index).edges[index & (BLOCK_SIZE - 1)];
+	}
+	void push_node(T value) {
+		if (amount_nodes >= EDGE_PAIRED_BIT) {
+			throw graph_library::GraphException("Too many nodes");
+		}
+		if ((amount_nodes & (BLOCK_SIZE - 1)) == 0) {
+			auto block = std::make_shared<Block>();
+			block->owner = owner.load(std::memory_order_relaxed);
+			block->data.reserve(BLOCK_SIZE);
+			block->edges.reserve(BLOCK_SIZE);
+			blocks.push_back(std::move(block));
+		}
+		Block& block = mutable_block_of(amount_nodes);
+		block.data.push_back(std::move(value));
+		block.edges.emplace_back();
+		++amount_nodes;
+	}
+	//Removes every edge index_first -> index_second, returns the amount removed
+	size_t erase_edges(size_t index_first, size_t index_second) {
+		//A block is not copied when there is nothing to remove
+		if (!hasEdgeOriented(index_first, index_second)) {
+			return 0;
+		}
+		size_t removed = std::erase_if(mutable_edges(index_first), [index_second](const Edge<T, WEIGHT_TYPE>& edge) {
+			return edge.get_to_index() == index_second;
+			});
+		amount_edges -= removed;
+		return removed;
+	}
+	//Sets the weight of every edge index_first -> index_second
+	void set_weights(size_t index_first, size_t index_second, WEIGHT_TYPE weight) {
+		if (!hasEdgeOriented(index_first, index_second)) {
+			return;
+		}
+		for (auto& edge : mutable_edges(index_first)) {
+			if (edge.get_to_index() == index_second) {
+				edge.set_weight(weight);
+			}
+		}
+	}
+public:
+	//Constructors and destructor
+	CowGraph() : owner(next_owner()) {}
+	//Deep copy of a graph with the same node indices, O(V + E). Removed nodes of the graph become isolated nodes
+	template <typename ALLOCATOR>
+	explicit CowGraph(const Graph<T, WEIGHT_TYPE, ALLOCATOR>& graph) : CowGraph(graph.freeze()) {}
+	explicit CowGraph(const CompactGraph<T, WEIGHT_TYPE>& compact) : owner(next_owner()) {
+		blocks.reserve((compact.getAmountNodes() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		for (size_t i = 0; i < compact.getAmountNodes(); ++i) {
+			push_node(compact.getNodeData(i));
+			auto targets = compact.neighbors(i);
+			auto weights = compact.weights(i);
+			edge_list& edges = mutable_edges(i);
+			edges.reserve(targets.size());
+			for (size_t k = 0; k < targets.size(); ++k) {
+				edges.emplace_back(targets[k], weights[k]);
+			}
+		}
+		amount_edges = compact.getAmountEdge();
+	}
+	//Copies share all blocks, O(V / BLOCK_SIZE)
+	CowGraph(const CowGraph<T, WEIGHT_TYPE>& other)
+		: blocks(other.blocks), amount_nodes(other.amount_nodes), amount_edges(other.amount_edges), owner(next_owner())
+	{
+		other.disown();
+	}
+	CowGraph(CowGraph<T, WEIGHT_TYPE>&& other) noexcept
+		: blocks(std::move(other.blocks)), amount_nodes(std::exchange(other.amount_nodes, 0)), amount_edges(std::exchange(other.amount_edges, 0)),
+		owner(other.owner.load(std::memory_order_relaxed))
+	{
+		other.blocks.clear();
+		other.disown();
+	}
+	~CowGraph() = default;
+
+	//Operators
+	CowGraph<T, WEIGHT_TYPE>& operator=(const CowGraph<T, WEIGHT_TYPE>& other) {
+		if (this != &other) {
+			blocks = other.blocks;
+			amount_nodes = other.amount_nodes;
+			amount_edges = other.amount_edges;
+			disown();
+			other.disown();
+		}
+		return *this;
+	}
+	CowGraph<T, WEIGHT_TYPE>& operator=(CowGraph<T, WEIGHT_TYPE>&& other) noexcept {
+		if (this != &other) {
+			blocks = std::move(other.blocks);
+			amount_nodes = std::exchange(other.amount_nodes, 0);
+			amount_edges = std::exchange(other.amount_edges, 0);
+			owner.store(other.owner.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			other.blocks.clear();
+			other.disown();
+		}
+		return *this;
+	}
+
+
+	//----------- M A I N   F U N C T I O N S ---------
+
+
+	//Addition
+	//Returns the index of the new node
+	size_t addNode(const T& value) {
+		push_node(value);
+		return amount_nodes - 1;
+	}
+	void addNodes(const std::vector<T>& data) {
+		for (const auto& value : data) {
+			push_node(value);
+		}
+	}
+	//Undirected edge, stored in both directions as in Graph::addEdge
+	void addEdge(size_t index_first, size_t index_second, WEIGHT_TYPE weight = 0) {
+		addEdgeOriented(index_first, index_second, weight);
+		if (index_first != index_second) {
+			addEdgeOriented(index_second, index_first, weight);
+		}
+	}
+	void addEdgeOriented(size_t index_first, size_t index_second, WEIGHT_TYPE weight = 0) {
+		check_index(index_first);
+		check_index(index_second);
+		mutable_edges(index_first).emplace_back(index_second, weight);
+		++amount_edges;
+	}
+
+	//Removal
+	void removeEdge(size_t index_first, size_t index_second) {
+		check_index(index_first);
+		check_index(index_second);
+		erase_edges(index_first, index_second);
+		if (index_first != index_second) {
+			erase_edges(index_second, index_first);
+		}
+	}
+	void removeEdgeOriented(size_t index_first, size_t index_second) {
+		check_index(index_first);
+		check_index(index_second);
+		erase_edges(index_first, index_second);
+	}
+
+	//Getters and setters
+	size_t getAmountNodes() const {
+		return amount_nodes;
+	}
+	size_t getAmountEdge() const {
+		return amount_edges;
+	}
+	size_t degree(size_t index) const {
+		return outEdges(index).size();
+	}
+	bool empty() const {
+		return amount_nodes == 0;
+	}
+	const T& getNodeData(size_t index) const {
+		check_index(index);
+		return block_of(index).data[index & (BLOCK_SIZE - 1)];
+	}
+	void setNodeData(size_t index, const T& value) {
+		check_index(index);
+		mutable_block_of(index).data[index & (BLOCK_SIZE - 1)] = value;
+	}
+	const edge_list& outEdges(size_t index) const {
+		return block_of(index).edges[index & (BLOCK_SIZE - 1)];
+	}
+	bool hasEdgeOriented(size_t index_first, size_t index_second) const {
+		check_index(index_first);
+		const edge_list& edges = outEdges(index_first);
+		return std::any_of(edges.begin(), edges.end(), [index_second](const Edge<T, WEIGHT_TYPE>& edge) {
+			return edge.get_to_index() == index_second;
+			});
+	}
+	bool hasEdge(size_t index_first, size_t index_second) const {
+		return hasEdgeOriented(index_first, index_second) && hasEdgeOriented(index_second, index_first);
+	}
+	//Max value of WEIGHT_TYPE if there is no such edge
+	WEIGHT_TYPE getEdgeWeightOriented(size_t index_first, size_t index_second) const {
+		check_index(index_first);
+		for (const auto& edge : outEdges(index_first)) {
+			if (edge.get_to_index() == index_second) {
+				return edge.get_weight();
+			}
+		}
+		return std::numeric_limits<WEIGHT_TYPE>::max();
+	}
+	void setEdgeOrientedWeight(size_t index_first, size_t index_second, WEIGHT_TYPE weight) {
+		check_index(index_first);
+		check_index(index_second);
+		set_weights(index_first, index_second, weight);
+	}
+	void setEdgeWeight(size_t index_first, size_t index_second, WEIGHT_TYPE weight) {
+		check_index(index_first);
+		check_index(index_second);
+		set_weights(index_first, index_second, weight);
+		set_weights(index_second, index_first, weight);
+	}
+
+	//Conversions
+	template <typename ALLOCATOR = graph_library::instrumentation::DefaultAllocator>
+	Graph<T, WEIGHT_TYPE, ALLOCATOR> toGraph(const ALLOCATOR& allocator = ALLOCATOR()) const {
+		return Graph<T, WEIGHT_TYPE, ALLOCATOR>(freeze(), allocator);
+	}
+	CompactGraph<T, WEIGHT_TYPE> freeze() const {
+		std::vector<T> nodes_data;
+		std::vector<std::uint64_t> offsets(amount_nodes + 1, 0);
+		std::vector<std::uint32_t> targets;
+		std::vector<WEIGHT_TYPE> weights;
+		nodes_data.reserve(amount_nodes);
+		targets.reserve(amount_edges);
+		weights.reserve(amount_edges);
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			nodes_data.push_back(getNodeData(i));
+			for (const auto& edge : outEdges(i)) {
+				targets.push_back(static_cast<std::uint32_t>(edge.get_to_index()));
+				weights.push_back(edge.get_weight());
+			}
+			offsets[i + 1] = targets.size();
+		}
+		return CompactGraph<T, WEIGHT_TYPE>(std::move(nodes_data), std::move(offsets), std::move(targets), std::move(weights));
+	}
+
+	//Memory
+	size_t amountBlocks() const {
+		return blocks.size();
+	}
+	//Amount of blocks this graph shares with another copy
+	size_t sharedBlocks(const CowGraph<T, WEIGHT_TYPE>& other) const {
+		size_t result = 0;
+		for (size_t i = 0; i < std::min(blocks.size(), other.blocks.size()); ++i) {
+			result += blocks[i] == other.blocks[i];
+		}
+		return result;
+	}
+	//Approximate amount of memory referenced by the graph in bytes, shared blocks included.
+	//Heap memory owned by T itself is not counted
+	size_t memoryFootprint() const {
+		size_t result = sizeof(*this) + blocks.capacity() * sizeof(std::shared_ptr<const Block>);
+		for (const auto& block : blocks) {
+			result += sizeof(Block) + 2 * sizeof(void*);
+			result += block->data.capacity() * sizeof(T) + block->edges.capacity() * sizeof(edge_list);
+			for (const auto& edges : block->edges) {
+				result += edges.capacity() * sizeof(Edge<T, WEIGHT_TYPE>);
+			}
+		}
+		return result;
+	}
+};
@@ -1,21 +1,41 @@
 #pragma once
 #include "node.hpp"
+#include "graph_policies.hpp"
+#include <cstdint>
 
-//We implement an adjacency list, where for each vertex (node) a list of its neighbors is stored
+//Bit of the stored target index that marks an edge created by Graph::addEdge together with its opposite edge.
+//Node indices stay below it
+inline constexpr std::uint32_t EDGE_PAIRED_BIT = std::uint32_t(1) << 31;
+
+//We implement an adjacency list, where for each vertex (node) a list of its neighbors is stored.
+//An edge refers to its target node by the index of the node in the graph
 template <typename T, typename WEIGHT_TYPE = int>
 class Edge {
 private:
-	std::weak_ptr<Node<T>> to_node;
+	//Index of the target and EDGE_PAIRED_BIT
+	std::uint32_t to_index;
 	WEIGHT_TYPE weight = 0;
 public:
+	static constexpr bool weighted = true;
+
 	//Constructors and destructor
 	Edge() = delete;
-	Edge(std::shared_ptr<Node<T>> _to_node, WEIGHT_TYPE _weight = 0) : to_node(_to_node), weight(_weight) {}
+	Edge(size_t _to_index, WEIGHT_TYPE _weight = 0) : to_index(static_cast<std::uint32_t>(_to_index)), weight(_weight) {}
 	~Edge() = default;
 
 	//Main functions
-	std::shared_ptr<Node<T>> get_to_node() const {
-		return to_node.lock();
+	size_t get_to_index() const {
+		return to_index & ~EDGE_PAIRED_BIT;
+	}
+	void set_to_index(size_t _to_index) {
+		to_index = static_cast<std::uint32_t>(_to_index) | (to_index & EDGE_PAIRED_BIT);
+	}
+	//The edge was created by addEdge and the graph holds its opposite edge
+	bool is_paired() const {
+		return (to_index & EDGE_PAIRED_BIT) != 0;
+	}
+	void set_paired(bool paired) {
+		to_index = paired ? (to_index | EDGE_PAIRED_BIT) : (to_index & ~EDGE_PAIRED_BIT);
 	}
 	void set_weight(WEIGHT_TYPE _weight) {
 		weight = _weight;
@@ -25,11 +45,46 @@ public:
 	}
 
 	//Operator
+	//Compares the target and the weight, not whether the edge is paired
 	bool operator==(const Edge<T, WEIGHT_TYPE>& other) const {
-		std::shared_ptr<Node<T>> this_to_node = to_node.lock();
-		std::shared_ptr<Node<T>> other_to_node = other.to_node.lock();
+		return get_to_index() == other.get_to_index() && weight == other.weight;
+	}
+};
+
+//Edge of an unweighted graph: only the index of the target, every edge has weight 1
+template <typename T>
+class Edge<T, void> {
+private:
+	//Index of the target and EDGE_PAIRED_BIT
+	std::uint32_t to_index;
+public:
+	static constexpr bool weighted = false;
+
+	//Constructors and destructor
+	Edge() = delete;
+	Edge(size_t _to_index) : to_index(static_cast<std::uint32_t>(_to_index)) {}
+	~Edge() = default;
 
-		return this_to_node && other_to_node &&
-			this_to_node == other_to_node && weight == other.weight;
+	//Main functions
+	size_t get_to_index() const {
+		return to_index & ~EDGE_PAIRED_BIT;
+	}
+	void set_to_index(size_t _to_index) {
+		to_index = static_cast<std::uint32_t>(_to_index) | (to_index & EDGE_PAIRED_BIT);
+	}
+	bool is_paired() const {
+		return (to_index & EDGE_PAIRED_BIT) != 0;
+	}
+	void set_paired(bool paired) {
+		to_index = paired ? (to_index | EDGE_PAIRED_BIT) : (to_index & ~EDGE_PAIRED_BIT);
+	}
+	unit_weight_t get_weight() const {
+		return 1;
+	}
+
+	//Operator
+	bool operator==(const Edge<T, void>& other) const {
+		return get_to_index() == other.get_to_index();
 	}
 };
+static_assert(sizeof(Edge<int, void>) == sizeof(std::uint32_t), "An unweighted edge is the index of its target");
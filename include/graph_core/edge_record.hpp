@@ -0,0 +1,38 @@
+#pragma once
+#include "graph_concepts.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//Flat description of an edge by node indices, used for bulk edge arrays
+template <typename WEIGHT_TYPE = int>
+struct EdgeRecord {
+	std::uint32_t from;
+	std::uint32_t to;
+	WEIGHT_TYPE weight;
+
+	bool operator==(const EdgeRecord<WEIGHT_TYPE>& other) const = default;
+};
+
+//Copies the edges of the graph into one flat array.
+//With only_forward every edge from -> to with from >= to is skipped, which leaves one copy
+//of each undirected edge of a graph built with addEdge (and drops self-loops)
+template <AdjacencyGraph GRAPH>
+std::vector<EdgeRecord<edge_weight_t<GRAPH>>> collectEdges(const GRAPH& graph, bool only_forward = false) {
+	std::vector<EdgeRecord<edge_weight_t<GRAPH>>> result;
+	size_t amount_edges = 0;
+	for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+		amount_edges += out_degree(graph, i);
+	}
+	result.reserve(only_forward ? amount_edges / 2 + 1 : amount_edges);
+
+	for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+		for (const auto& edge : graph.outEdges(i)) {
+			size_t to = edge.get_to_index();
+			if (!only_forward || i < to) {
+				result.push_back({ static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(to), edge.get_weight() });
+			}
+		}
+	}
+	return result;
+}
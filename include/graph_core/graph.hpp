@@ -3,60 +3,352 @@
 
 #include "node.hpp"
 #include "edge.hpp"
+#include "neighbour_view.hpp"
+#include "value_index.hpp"
+#include "component_index.hpp"
+#include "compact_graph.hpp"
+#include "permutation.hpp"
+#include "graph_policies.hpp"
+#include "instrumentation.hpp"
 #include "../exceptions.hpp"
 #include <vector>
-#include <list>
 #include <string>
 #include <memory>
 #include <stdexcept>
 #include <algorithm>
 #include <limits>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
 
 
-template <typename T, typename WEIGHT_TYPE = int>
+//ALLOCATOR serves the nodes (with their shared_ptr control blocks), the node table and all edge lists.
+//Use std::pmr::polymorphic_allocator to place a graph in a memory resource, see memory_resources.hpp.
+//WEIGHT_TYPE = void gives an unweighted graph and DIRECTION chooses between Mixed, Undirected and Directed edges,
+//see graph_policies.hpp. An unweighted graph accepts weight arguments and ignores them
+template <typename T, typename WEIGHT_TYPE = int, typename ALLOCATOR = graph_library::instrumentation::DefaultAllocator, DirectionPolicy DIRECTION = Mixed>
 class Graph {
+public:
+	using allocator_type = ALLOCATOR;
+	using direction = DIRECTION;
+	using weight_type = weight_value_t<WEIGHT_TYPE>;
+	static constexpr bool weighted = is_weighted_v<WEIGHT_TYPE>;
+	static constexpr bool directed = std::is_same_v<DIRECTION, Directed>;
+	static constexpr bool undirected = std::is_same_v<DIRECTION, Undirected>;
 private:
-	std::vector<std::shared_ptr<Node<T>>> nodes;
-	std::vector<std::list<Edge<T, WEIGHT_TYPE>>> adj_list;
+	template <typename U>
+	using rebind_t = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<U>;
+	using node_pointer = std::shared_ptr<Node<T>>;
+	using edge_list = std::vector<Edge<T, WEIGHT_TYPE>, rebind_t<Edge<T, WEIGHT_TYPE>>>;
+	//Do nothing unless GRAPH_LIBRARY_INSTRUMENTATION is defined, see instrumentation.hpp
+	using ScopedTimer = graph_library::instrumentation::ScopedTimer;
+	using ScopedCounter = graph_library::instrumentation::ScopedCounter;
+	using Operation = graph_library::instrumentation::Operation;
+	using Counter = graph_library::instrumentation::Counter;
+
+	ALLOCATOR allocator;
+	std::vector<node_pointer, rebind_t<node_pointer>> nodes;
+	std::vector<edge_list, rebind_t<edge_list>> adj_list;
+	//unpaired.get(i) are the sources of the edges leading to node i without an opposite edge, not kept for undirected graphs
+	UnpairedSources<rebind_t<std::uint32_t>, !undirected> unpaired;
+	size_t amount_removed = 0;
+	ValueIndex<T> value_index;
+	//Kept up to date by every change of the edges, queries only read it
+	ComponentIndex component_index;
+	//Lets the nodes find their edges, see Node::get_neibours. Created with the first node
+	std::unique_ptr<NodeOwner<T>> owner;
 	/*
 	A vertex in the vertices vector with index i = 1 - vertices.size
 	corresponds to a list of edges with index i = 1 - adj_list.size = 1 - vertices.size,
-	emanating from this vertex.
+	emanating from this vertex. adj_list and unpaired (if it is kept) always have the same size as nodes.
+	The index is also stored in the node itself (Node::get_index), so it must be
+	kept up to date whenever the nodes vector is changed.
+	adj_list is the only place where edges are stored: edges refer to their target by index
+	and the neighbours of a node are a view over its edges (see getNeighbors).
+	A removed node leaves an empty slot (nodes[i] == nullptr, no edges) so that the indices
+	of the other nodes do not change. compact() drops the empty slots and renumbers the nodes.
 	*/
 
 	//Private functions
+	//Functions for maintaining node indices
+	//The node and its control block share one allocation from the graph allocator
+	template <typename VALUE>
+	node_pointer new_node(VALUE&& value) const {
+		return std::allocate_shared<Node<T>>(rebind_t<Node<T>>(allocator), std::forward<VALUE>(value));
+	}
+	//Every edge list gets the graph allocator explicitly, stateful allocators are not passed on by the outer vector
+	edge_list new_edge_list() const {
+		return edge_list(rebind_t<Edge<T, WEIGHT_TYPE>>(allocator));
+	}
+	static NodeNeighbourView<T> node_neighbours(const void* graph, size_t index) {
+		const auto& edges = static_cast<const Graph*>(graph)->adj_list[index];
+		return NodeNeighbourView<T>(reinterpret_cast<const std::byte*>(edges.data()), edges.size(), sizeof(Edge<T, WEIGHT_TYPE>),
+			&edge_target, static_cast<const Graph*>(graph)->nodes.data());
+	}
+	static size_t edge_target(const std::byte* edge) {
+		return reinterpret_cast<const Edge<T, WEIGHT_TYPE>*>(edge)->get_to_index();
+	}
+	//Nodes may outlive the graph, they must not refer to it afterwards
+	void detach_nodes() {
+		for (const auto& node : nodes) {
+			if (node) {
+				node->owner = nullptr;
+			}
+		}
+	}
+	void push_node(std::shared_ptr<Node<T>> node) {
+		if (nodes.size() >= EDGE_PAIRED_BIT) {
+			throw graph_library::GraphException("Too many nodes");
+		}
+		if (!owner) {
+			owner = std::make_unique<NodeOwner<T>>(NodeOwner<T>{ this, &node_neighbours });
+		}
+		node->index = nodes.size();
+		node->owner = owner.get();
+		value_index.insert(node->get_data(), node->index);
+		nodes.push_back(std::move(node));
+		adj_list.push_back(new_edge_list());
+		unpaired.push_back();
+		component_index.push_back();
+	}
+	static Edge<T, WEIGHT_TYPE> make_edge(size_t to_index, weight_type weight) {
+		if constexpr (weighted) {
+			return Edge<T, WEIGHT_TYPE>(to_index, weight);
+		}
+		else {
+			return Edge<T, WEIGHT_TYPE>(to_index);
+		}
+	}
+	//paired: the opposite edge is added as well, see Edge::is_paired
+	void push_edge(size_t index_first, size_t index_second, weight_type weight, bool paired) {
+		adj_list[index_first].push_back(make_edge(index_second, weight));
+		adj_list[index_first].back().set_paired(paired);
+		if (!paired) {
+			unpaired.add(index_second, index_first);
+		}
+		component_index.unite(index_first, index_second);
+	}
+	//Removes the outgoing edges of the node and all edges leading to it. The edges leading to it are found
+	//through their opposite edges, which addEdge creates, and through the sources of the unpaired edges
+	//(addEdgeOriented, or any edge of a directed graph), so this costs the sum of the degrees of its neighbours
+	void erase_all_edges(size_t index) {
+		std::vector<std::uint32_t> endpoints;
+		for (const auto& edge : adj_list[index]) {
+			size_t to_index = edge.get_to_index();
+			if (to_index == index) {
+				continue;
+			}
+			if (component_index.is_enabled()) {
+				endpoints.push_back(static_cast<std::uint32_t>(to_index));
+			}
+			if (edge.is_paired()) {
+				erase_edges(to_index, index);
+			}
+			else {
+				unpaired.remove(to_index, index);
+			}
+		}
+		adj_list[index].clear();
+		auto sources = unpaired.take(index);
+		std::sort(sources.begin(), sources.end());
+		sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+		for (std::uint32_t source : sources) {
+			if (source != index) {
+				erase_edges(source, index);
+				if (component_index.is_enabled()) {
+					endpoints.push_back(source);
+				}
+			}
+		}
+		isolate_component(index, endpoints);
+	}
+	//Removes the node with all its edges and leaves an empty slot
+	void erase_node(size_t index) {
+		erase_all_edges(index);
+		adj_list[index].shrink_to_fit();
+		value_index.erase(nodes[index]->get_data(), index);
+		nodes[index]->owner = nullptr;
+		nodes[index] = nullptr;
+		++amount_removed;
+	}
+	//Removes every edge index_first -> index_second and returns their amount. The opposite edges of removed
+	//paired edges stay, the caller removes them as well or unpairs them. The component index is left to the caller
+	size_t erase_edges(size_t index_first, size_t index_second) {
+		graph_library::instrumentation::count(Counter::EDGES_VISITED, adj_list[index_first].size());
+		size_t removed_unpaired = 0;
+		size_t removed = std::erase_if(adj_list[index_first], [index_second, &removed_unpaired](const Edge<T, WEIGHT_TYPE>& edge) {
+			if (edge.get_to_index() != index_second) {
+				return false;
+			}
+			removed_unpaired += !edge.is_paired();
+			return true;
+			});
+		unpaired.remove(index_second, index_first, removed_unpaired);
+		return removed;
+	}
+	//Paired edge index_first -> index_second that is the opposite of an edge with the given weight,
+	//one with the same weight if there is one. end() of the list if there is none
+	auto find_opposite(size_t index_first, size_t index_second, weight_type weight) {
+		auto& edges = adj_list[index_first];
+		auto result = edges.end();
+		for (auto it = edges.begin(); it != edges.end(); ++it) {
+			if (it->get_to_index() == index_second && it->is_paired()) {
+				if (it->get_weight() == weight) {
+					return it;
+				}
+				if (result == edges.end()) {
+					result = it;
+				}
+			}
+		}
+		return result;
+	}
+	//Marks as paired every edge of a snapshot that has an opposite edge of the same weight, the way addEdge
+	//creates them; other edges stay unpaired. An undirected graph throws GraphException for such an edge.
+	//O(E log E): the edges from the smaller node and those from the larger node are sorted and matched
+	void pair_snapshot_edges() {
+		if constexpr (!directed) {
+			struct HalfEdge {
+				std::uint32_t low;
+				std::uint32_t high;
+				weight_type weight;
+				std::uint32_t node;
+				size_t position;
+			};
+			std::vector<HalfEdge> up;
+			std::vector<HalfEdge> down;
+			for (size_t i = 0; i < adj_list.size(); ++i) {
+				for (size_t k = 0; k < adj_list[i].size(); ++k) {
+					size_t to = adj_list[i][k].get_to_index();
+					if (to == i) {
+						continue;
+					}
+					auto low = static_cast<std::uint32_t>(std::min(i, to));
+					auto high = static_cast<std::uint32_t>(std::max(i, to));
+					(i < to ? up : down).push_back({ low, high, adj_list[i][k].get_weight(), static_cast<std::uint32_t>(i), k });
+				}
+			}
+			auto before = [](const HalfEdge& first, const HalfEdge& second) {
+				return std::tie(first.low, first.high, first.weight) < std::tie(second.low, second.high, second.weight);
+			};
+			std::sort(up.begin(), up.end(), before);
+			std::sort(down.begin(), down.end(), before);
+			size_t matched = 0;
+			for (size_t u = 0, d = 0; u < up.size() && d < down.size();) {
+				if (before(up[u], down[d])) {
+					++u;
+				}
+				else if (before(down[d], up[u])) {
+					++d;
+				}
+				else {
+					adj_list[up[u].node][up[u].position].set_paired(true);
+					adj_list[down[d].node][down[d].position].set_paired(true);
+					++u;
+					++d;
+					++matched;
+				}
+			}
+			if (undirected && (matched != up.size() || matched != down.size())) {
+				throw graph_library::GraphException("The snapshot has an edge without an opposite edge, it is not undirected");
+			}
+		}
+	}
+	void rebuild_value_index() {
+		if (!value_index.is_enabled()) {
+			return;
+		}
+		value_index.clear();
+		value_index.reserve(nodes.size());
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			if (nodes[i]) {
+				value_index.insert(nodes[i]->get_data(), i);
+			}
+		}
+	}
+	//Index of a node for the queries of the component index
+	size_t component_query_index(const std::shared_ptr<Node<T>>& node) const {
+		size_t index = get_index_node(node);
+		if (index == std::numeric_limits<size_t>::max()) {
+			throw graph_library::NodeNotFoundException();
+		}
+		return index;
+	}
+	void check_component_index() const {
+		if (!component_index.is_enabled()) {
+			throw graph_library::GraphException("The component index is not enabled, see enableComponentIndex");
+		}
+	}
+	//Calls report(i) for every node i joined to the node by an edge in either direction: the targets of its edges,
+	//which include the sources of paired edges leading to it, and the sources of unpaired edges leading to it
+	auto component_neighbours() const {
+		return [this](size_t index, auto&& report) {
+			for (const auto& edge : adj_list[index]) {
+				report(edge.get_to_index());
+			}
+			for (std::uint32_t source : unpaired.get(index)) {
+				report(source);
+			}
+		};
+	}
+	//The edges between the nodes were removed, the component may have split
+	void split_component(size_t index_first, size_t index_second) {
+		if (component_index.is_enabled()) {
+			ScopedTimer timer(Operation::SPLIT_COMPONENTS);
+			component_index.remove_edge(index_first, index_second, component_neighbours());
+		}
+	}
+	//The node lost all its edges, which led to or came from the endpoints
+	void isolate_component(size_t index, const std::vector<std::uint32_t>& endpoints) {
+		if (component_index.is_enabled()) {
+			ScopedTimer timer(Operation::SPLIT_COMPONENTS);
+			component_index.isolate(index, endpoints, component_neighbours());
+		}
+	}
+	size_t find_index_by_value(const T& value) const {
+		if (value_index.is_enabled()) {
+			return value_index.find_first(value);
+		}
+		ScopedCounter comparisons(Counter::LOOKUP_COMPARISONS);
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			comparisons.add();
+			if (nodes[i] && nodes[i]->get_data() == value) {
+				return i;
+			}
+		}
+		return std::numeric_limits<size_t>::max();
+	}
+
 	//Functions for searching and changing edges
 	std::vector<Edge<T, WEIGHT_TYPE>*> findEdgeMutable(
 		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second,
-		WEIGHT_TYPE weight = 0, bool comparable_by_weight = true)
+		weight_type weight = 0, bool comparable_by_weight = true)
 	{
 		std::vector<Edge<T, WEIGHT_TYPE>*> result;
-		result.push_back(findEdgeMutable(node_first, node_second, weight, comparable_by_weight));
-		result.push_back(findEdgeMutable(node_second, node_first, weight, comparable_by_weight));
+		result.push_back(findEdgeOrientedMutable(node_first, node_second, weight, comparable_by_weight));
+		result.push_back(findEdgeOrientedMutable(node_second, node_first, weight, comparable_by_weight));
 		return result;
 	}
 	
 	Edge<T, WEIGHT_TYPE>* findEdgeOrientedMutable(
-		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0, bool comparable_by_weight = true) {
+		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type weight = 0, bool comparable_by_weight = true) {
 		if (!node_first || !node_second) {
-			throw NodeIsNullException();
+			throw graph_library::NodeIsNullException();
 		}
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
-		}
-
-		if (index_first >= adj_list.size()) {
-			return nullptr;
+			throw graph_library::NodeNotFoundException();
 		}
 
 		auto& edge_list = adj_list[index_first];
+		ScopedCounter visited(Counter::EDGES_VISITED);
 		for (auto& edge : edge_list) {
-			auto to_node = edge.get_to_node();
-			if (to_node && *to_node == *node_second) {
-				if (comparable_by_weight) {
+			visited.add();
+			if (edge.get_to_index() == index_second) {
+				if (weighted && comparable_by_weight) {
 					if (edge.get_weight() == weight) {
 						return &edge;
 					}
@@ -72,258 +364,367 @@ private:
 	
 	size_t get_index_node(std::shared_ptr<Node<T>> node) const {
 		if (!node) {
-			throw NodeIsNullException();
+			throw graph_library::NodeIsNullException();
 		}
 
-		for (size_t i = 0; i < nodes.size(); ++i) {
-			if (node && nodes[i] && *nodes[i] == *node) {
-				return i;
-			}
+		graph_library::instrumentation::count(Counter::NODE_LOOKUPS);
+		//Nodes of this graph carry their own index
+		size_t index = node->index;
+		if (index < nodes.size() && nodes[index] == node) {
+			return index;
 		}
 
-		return std::numeric_limits<size_t>::max();
+		//The node belongs to another graph, look it up by data
+		graph_library::instrumentation::count(Counter::LOOKUP_SCANS);
+		return find_index_by_value(node->get_data());
 	}
 public:
 	//Construstors and destructor
-	Graph() : nodes(), adj_list() {}
-	Graph(size_t amount_nodes, const T& value = T())  requires std::default_initializable<T> {
+	Graph() : Graph(ALLOCATOR()) {}
+	explicit Graph(const ALLOCATOR& _allocator) : allocator(_allocator), nodes(_allocator), adj_list(_allocator), unpaired(rebind_t<std::uint32_t>(_allocator)) {}
+	Graph(size_t amount_nodes, const T& value = T(), const ALLOCATOR& _allocator = ALLOCATOR()) requires std::default_initializable<T>
+		: Graph(_allocator)
+	{
+		nodes.reserve(amount_nodes);
 		for (size_t i = 0; i < amount_nodes; ++i) {
-			nodes.push_back(std::make_shared<Node<T>>(value));
+			push_node(new_node(value));
 		}
 	}
-	Graph(const std::vector<Node<T>>& other_nodes) {
+	Graph(const std::vector<Node<T>>& other_nodes, const ALLOCATOR& _allocator = ALLOCATOR()) : Graph(_allocator) {
+		nodes.reserve(other_nodes.size());
 		for (size_t i = 0; i < other_nodes.size(); ++i) {
-			nodes.push_back(std::make_shared<Node<T>>(other_nodes[i]->get_data()));
+			push_node(new_node(other_nodes[i].get_data()));
 		}
-		adj_list.resize(other_nodes.size());
 	}
-	Graph(const Graph<T, WEIGHT_TYPE>& other) {
+	//Deep copy in O(V + E): new nodes with the same indices, the edges are copied as they are
+	Graph(const Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>& other)
+		: Graph(other, std::allocator_traits<ALLOCATOR>::select_on_container_copy_construction(other.allocator)) {}
+	Graph(const Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>& other, const ALLOCATOR& _allocator) : Graph(_allocator) {
+		ScopedTimer timer(Operation::COPY);
+		if (other.value_index.is_enabled()) {
+			value_index.enable();
+		}
+		nodes.reserve(other.nodes.size());
 		for (const auto& orig_node : other.nodes) {
-			nodes.push_back(std::make_shared<Node<T>>(orig_node->get_data()));
+			if (orig_node) {
+				push_node(new_node(orig_node->get_data()));
+			}
+			else {
+				//Removed nodes stay empty slots, so that the indices match
+				nodes.push_back(nullptr);
+				adj_list.push_back(new_edge_list());
+			}
 		}
-
-		adj_list.resize(nodes.size());
 		for (size_t i = 0; i < other.adj_list.size(); ++i) {
-			for (const auto& orig_edge : other.adj_list[i]) {
-				auto orig_to_node = orig_edge.get_to_node();
-				for (size_t j = 0; j < nodes.size(); ++j) {
-					if (orig_to_node && *orig_to_node == *nodes[j]) {
-						adj_list[i].push_back(Edge<T, WEIGHT_TYPE>(nodes[j], orig_edge.get_weight()));
-						break;
-					}
+			adj_list[i].assign(other.adj_list[i].begin(), other.adj_list[i].end());
+		}
+		unpaired.rebuild(adj_list);
+		amount_removed = other.amount_removed;
+		component_index = other.component_index;
+	}
+	//Mutable graph with the nodes and edges of a snapshot, O(V + E log E). The opposite of freeze.
+	//An edge and an opposite edge of the same weight become a pair as if added by addEdge. For an undirected
+	//graph the snapshot must contain every edge in both directions, GraphException otherwise
+	explicit Graph(const CompactGraph<T, WEIGHT_TYPE>& compact, const ALLOCATOR& _allocator = ALLOCATOR()) : Graph(_allocator) {
+		nodes.reserve(compact.getAmountNodes());
+		adj_list.reserve(compact.getAmountNodes());
+		for (size_t i = 0; i < compact.getAmountNodes(); ++i) {
+			push_node(new_node(compact.getNodeData(i)));
+			auto targets = compact.neighbors(i);
+			auto& edges = adj_list.back();
+			edges.reserve(targets.size());
+			if constexpr (weighted) {
+				auto weights = compact.weights(i);
+				for (size_t k = 0; k < targets.size(); ++k) {
+					edges.emplace_back(targets[k], weights[k]);
 				}
 			}
-		}
-
-		for (size_t i = 0; i < nodes.size(); ++i) {
-			for (const auto& edge : adj_list[i]) {
-				nodes[i]->get_neibours().push_back(edge.get_to_node());
+			else {
+				edges.assign(targets.begin(), targets.end());
 			}
 		}
+		pair_snapshot_edges();
+		unpaired.rebuild(adj_list);
+	}
+	Graph(Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>&& other) noexcept
+		: allocator(other.allocator), nodes(std::move(other.nodes)), adj_list(std::move(other.adj_list)), unpaired(std::move(other.unpaired)),
+		amount_removed(std::exchange(other.amount_removed, 0)), value_index(std::move(other.value_index)),
+		component_index(std::move(other.component_index)), owner(std::move(other.owner))
+	{
+		if (owner) {
+			owner->graph = this;
+		}
+	}
+	~Graph() {
+		detach_nodes();
 	}
-	Graph(Graph<T, WEIGHT_TYPE>&& other) noexcept : nodes(std::move(other.nodes)), adj_list(std::move(other.adj_list)) {}
-	~Graph() = default;
 
 
 	//----------- M A I N   F U N C T I O N S ---------
 
 
 	//Addition
-	void addNode(const T& value) {
-		nodes.push_back(std::make_shared<Node<T>>(value));
+	//Returns the new node, its index is node->get_index()
+	std::shared_ptr<Node<T>> addNode(const T& value) {
+		ScopedTimer timer(Operation::ADD_NODE);
+		push_node(new_node(value));
+		return nodes.back();
 	}
 	void addNodes(const std::vector<T>& data) {
+		ScopedTimer timer(Operation::ADD_NODE);
+		nodes.reserve(nodes.size() + data.size());
 		for (size_t i = 0; i < data.size(); ++i) {
-			nodes.push_back(std::make_shared<Node<T>>(data[i]));
+			push_node(new_node(data[i]));
 		}
 	}
-	void addEdge(std::shared_ptr<Node<T>> node_first, std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0) {
+	//Directed graphs store only the edge from node_first to node_second
+	void addEdge(std::shared_ptr<Node<T>> node_first, std::shared_ptr<Node<T>> node_second, weight_type weight = 0) {
+		ScopedTimer timer(Operation::ADD_EDGE);
 		if (!node_first || !node_second) { return; }
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
+			throw graph_library::NodeNotFoundException();
 		}
 
-		node_first->get_neibours().push_back(std::weak_ptr<Node<T>>(node_second));
-		if (index_first != index_second) {
-			node_second->get_neibours().push_back(std::weak_ptr<Node<T>>(node_first));
-		}
-
-		if (index_first >= adj_list.size()) {
-			adj_list.resize(index_first + 1);
-		}
-		if (index_second >= adj_list.size()) {
-			adj_list.resize(index_second + 1);
-		}
-
-		adj_list[index_first].push_back(Edge<T, WEIGHT_TYPE>(node_second, weight));
-		if (index_first != index_second) {
-			adj_list[index_second].push_back(Edge<T, WEIGHT_TYPE>(node_first, weight));
+		bool paired = !directed && index_first != index_second;
+		push_edge(index_first, index_second, weight, paired);
+		if (paired) {
+			push_edge(index_second, index_first, weight, true);
 		}
 	}
-	void addEdgeOriented(std::shared_ptr<Node<T>> node_first, std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0) {
+	void addEdge(size_t index_first, size_t index_second, weight_type weight = 0) {
+		addEdge(getNode(index_first), getNode(index_second), weight);
+	}
+	//Not available for undirected graphs, where every edge has an opposite edge
+	void addEdgeOriented(std::shared_ptr<Node<T>> node_first, std::shared_ptr<Node<T>> node_second, weight_type weight = 0) requires (!undirected) {
+		ScopedTimer timer(Operation::ADD_EDGE);
 		if (!node_first || !node_second) { return; }
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
+			throw graph_library::NodeNotFoundException();
 		}
 
-		node_first->get_neibours().push_back(std::weak_ptr<Node<T>>(node_second));
-
-		if (index_first >= adj_list.size()) {
-			adj_list.resize(index_first + 1);
-		}
-
-		adj_list[index_first].push_back(Edge<T, WEIGHT_TYPE>(node_second, weight));
+		push_edge(index_first, index_second, weight, false);
+	}
+	void addEdgeOriented(size_t index_first, size_t index_second, weight_type weight = 0) requires (!undirected) {
+		addEdgeOriented(getNode(index_first), getNode(index_second), weight);
 	}
 
 
 	//Removing
-	//Removes all vertex encountered with data = value
+	//Removal of nodes leaves empty slots: the other nodes keep their indices until compact()
+	//Removes the first vertex encountered with data = value
 	void removeNode(const T& value) {
-		for (size_t i = 0; i < nodes.size(); ++i) {
-			if (nodes[i]->get_data() == value) {
-				removeAllEdgesOfNode(nodes[i]);
-				nodes.erase(nodes.begin() + i);
-				break;
-			}
+		ScopedTimer timer(Operation::REMOVE_NODE);
+		size_t index = find_index_by_value(value);
+		if (index != std::numeric_limits<size_t>::max()) {
+			erase_node(index);
 		}
 	}
 	void removeAllNodeWithValue(const T& value) {
-		size_t nodes_size = nodes.size();
-		for (size_t i = 0; i < nodes_size;) {
+		ScopedTimer timer(Operation::REMOVE_NODE);
+		for (size_t i = 0; i < nodes.size(); ++i) {
 			if (nodes[i] && nodes[i]->get_data() == value) {
-				removeAllEdgesOfNode(nodes[i]);
-				nodes.erase(nodes.begin() + i);
-				--nodes_size;
-			}
-			else {
-				++i;
+				erase_node(i);
 			}
 		}
 	}
 	void removeNode(std::shared_ptr<Node<T>> node) {
-		auto it = std::find(nodes.begin(), nodes.end(), node);
-		if (it != nodes.end()) {
-			removeAllEdgesOfNode(node);
-			nodes.erase(it);
+		ScopedTimer timer(Operation::REMOVE_NODE);
+		if (!node) { return; }
+
+		size_t index = node->index;
+		if (index < nodes.size() && nodes[index] == node) {
+			erase_node(index);
 		}
 	}
 	void removeAllNodes() {
-		removeAllEdge();
+		detach_nodes();
 		nodes.clear();
+		adj_list.clear();
+		unpaired.clear();
+		amount_removed = 0;
+		value_index.clear();
+		component_index.clear();
+	}
+	//Drops the empty slots of removed nodes and renumbers the other nodes in their order, O(V + E).
+	//Returns the new index of every old index, max of size_t for removed nodes
+	std::vector<size_t> compact() {
+		ScopedTimer timer(Operation::COMPACT);
+		std::vector<size_t> new_index(nodes.size(), std::numeric_limits<size_t>::max());
+		size_t amount = 0;
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			if (nodes[i]) {
+				new_index[i] = amount++;
+			}
+		}
+		if (amount_removed == 0) {
+			return new_index;
+		}
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			if (!nodes[i]) {
+				continue;
+			}
+			size_t to = new_index[i];
+			nodes[to] = std::move(nodes[i]);
+			nodes[to]->index = to;
+			if (to != i) {
+				adj_list[to] = std::move(adj_list[i]);
+			}
+			for (auto& edge : adj_list[to]) {
+				edge.set_to_index(new_index[edge.get_to_index()]);
+			}
+		}
+		nodes.erase(nodes.begin() + amount, nodes.end());
+		adj_list.erase(adj_list.begin() + amount, adj_list.end());
+		unpaired.rebuild(adj_list);
+		amount_removed = 0;
+		rebuild_value_index();
+		component_index.rebuild(adj_list);
+		return new_index;
+	}
+	//Renumbers node i to permutation.newIndex(i) in place, O(V + E). Node handles stay valid and report
+	//their new indices, the edges of every node keep their order. Compact the graph first if it has removed nodes
+	void permute(const Permutation& permutation) {
+		ScopedTimer timer(Operation::PERMUTE);
+		if (permutation.size() != nodes.size()) {
+			throw graph_library::GraphException("The permutation does not match the amount of nodes");
+		}
+		if (amount_removed != 0) {
+			throw graph_library::GraphException("Compact the graph before permuting, it has removed nodes");
+		}
+		std::vector<node_pointer, rebind_t<node_pointer>> permuted_nodes(nodes.get_allocator());
+		std::vector<edge_list, rebind_t<edge_list>> permuted_lists(adj_list.get_allocator());
+		permuted_nodes.reserve(nodes.size());
+		permuted_lists.reserve(adj_list.size());
+		for (size_t index = 0; index < nodes.size(); ++index) {
+			size_t original = permutation.originalIndex(index);
+			permuted_nodes.push_back(std::move(nodes[original]));
+			permuted_nodes.back()->index = index;
+			permuted_lists.push_back(std::move(adj_list[original]));
+			for (auto& edge : permuted_lists.back()) {
+				edge.set_to_index(permutation.newIndex(edge.get_to_index()));
+			}
+		}
+		nodes.swap(permuted_nodes);
+		adj_list.swap(permuted_lists);
+		unpaired.rebuild(adj_list);
+		rebuild_value_index();
+		component_index.rebuild(adj_list);
 	}
-	//Removes all edge encountered between node_first and node_second
+	//Removes all edge encountered between node_first and node_second, for directed graphs from node_first to node_second
 	void removeEdge(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) {
+		ScopedTimer timer(Operation::REMOVE_EDGE);
 		if (!node_first || !node_second) { return; }
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 
-		if (index_first == std::numeric_limits<size_t>::max() && index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
-		}
-		else if (index_first != std::numeric_limits<size_t>::max() && index_second != std::numeric_limits<size_t>::max()) {
-			adj_list[index_first].remove(*findEdgeOriented(node_first, node_second, 0, false));
-			node_first->get_neibours().remove_if([node_second](const std::weak_ptr<Node<T>>& neighbour_wp) {
-				if (auto neighbour_sp = neighbour_wp.lock()) {
-					return *neighbour_sp == *node_second;
-				}
-				return false;
-				});
-			if (index_first != index_second) {
-				adj_list[index_second].remove(*findEdgeOriented(node_second, node_first, 0, false));
-				node_second->get_neibours().remove_if([node_first](const std::weak_ptr<Node<T>>& neighbour_wp) {
-					if (auto neighbour_sp = neighbour_wp.lock()) {
-						return *neighbour_sp == *node_first;
-					}
-					return false;
-					});
-			}
+		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
+			throw graph_library::NodeNotFoundException();
 		}
-		else if (index_first == std::numeric_limits<size_t>::max()) {
-			adj_list[index_second].remove(*findEdgeOriented(node_second, node_first, 0, false));
-			node_second->get_neibours().remove_if([node_first](const std::weak_ptr<Node<T>>& neighbour_wp) {
-				if (auto neighbour_sp = neighbour_wp.lock()) {
-					return *neighbour_sp == *node_first;
-				}
-				return false;
-				});
+
+		size_t removed = erase_edges(index_first, index_second);
+		if (!directed && index_first != index_second) {
+			removed += erase_edges(index_second, index_first);
 		}
-		else {
-			adj_list[index_first].remove(*findEdgeOriented(node_first, node_second, 0, false));
-			node_first->get_neibours().remove_if([node_second](const std::weak_ptr<Node<T>>& neighbour_wp) {
-				if (auto neighbour_sp = neighbour_wp.lock()) {
-					return *neighbour_sp == *node_second;
-				}
-				return false;
-				});
+		if (removed != 0) {
+			split_component(index_first, index_second);
 		}
 	}
+	//Removes the edges leaving the node and their opposite edges. For directed graphs all edges leading to the node
 	void removeAllEdgesOfNode(const std::shared_ptr<Node<T>> node) {
+		ScopedTimer timer(Operation::REMOVE_EDGE);
 		if (!node) { return; }
 
 		size_t index = get_index_node(node);
 		if (index == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
+			throw graph_library::NodeNotFoundException();
 		}
 
-		if (adj_list.empty()) {
+		if constexpr (directed) {
+			erase_all_edges(index);
 			return;
 		}
-
-		if (index < adj_list.size()) {
-			for (auto& edge : adj_list[index]) {
-				removeEdgeOriented(edge.get_to_node(), node);
+		std::vector<std::uint32_t> endpoints;
+		for (const auto& edge : adj_list[index]) {
+			size_t to_index = edge.get_to_index();
+			if (!edge.is_paired()) {
+				unpaired.remove(to_index, index);
+			}
+			if (to_index != index) {
+				erase_edges(to_index, index);
+				if (component_index.is_enabled()) {
+					endpoints.push_back(static_cast<std::uint32_t>(to_index));
+				}
 			}
-			adj_list[index].clear();
-			node->get_neibours().clear();
 		}
-		else {
-			throw InvalidIndexException();
+		adj_list[index].clear();
+		//Unpaired edges leading to the node stay
+		if (unpaired.get(index).empty()) {
+			isolate_component(index, endpoints);
+		}
+		else if (component_index.is_enabled()) {
+			endpoints.push_back(static_cast<std::uint32_t>(index));
+			ScopedTimer timer(Operation::SPLIT_COMPONENTS);
+			component_index.remove_edges(endpoints, component_neighbours());
 		}
 	}
-	void removeEdgeOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) {
+	void removeEdgeOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) requires (!undirected) {
+		ScopedTimer timer(Operation::REMOVE_EDGE);
 		if (!node_first || !node_second) { return; }
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
+			throw graph_library::NodeNotFoundException();
 		}
 
-		if (adj_list.size() > index_first) {
-			adj_list[index_first].remove(*findEdgeOriented(node_first, node_second, 0, false));
-			node_first->get_neibours().remove_if([node_second](const std::weak_ptr<Node<T>>& neighbour_wp) {
-				if (auto neighbour_sp = neighbour_wp.lock()) {
-					return *neighbour_sp == *node_second;
-				}
-				return false;
-				});
+		//The opposite edges of removed paired edges stay and lose their pair
+		std::vector<weight_type> paired_weights;
+		for (const auto& edge : adj_list[index_first]) {
+			if (edge.get_to_index() == index_second && edge.is_paired()) {
+				paired_weights.push_back(edge.get_weight());
+			}
+		}
+		size_t removed = erase_edges(index_first, index_second);
+		for (weight_type weight : paired_weights) {
+			auto opposite_it = find_opposite(index_second, index_first, weight);
+			if (opposite_it != adj_list[index_second].end()) {
+				opposite_it->set_paired(false);
+				unpaired.add(index_first, index_second);
+			}
+		}
+		if (removed != 0) {
+			split_component(index_first, index_second);
 		}
 	}
+	//Removes the edge and, if addEdge created it together with an opposite edge, that opposite edge
 	void removeEdge(std::shared_ptr<Edge<T, WEIGHT_TYPE>> edge) {
+		ScopedTimer timer(Operation::REMOVE_EDGE);
+		if (!edge) { return; }
+
 		for (size_t i = 0; i < adj_list.size(); ++i) {
-			if (std::find(adj_list[i].begin(), adj_list[i].end(), edge) != adj_list.end()) {
-				adj_list[i].remove(edge);
-				std::shared_ptr<Node<T>> to_node = edge->get_to_node();
-				std::shared_ptr<Node<T>> node = nodes[i];
-				node->get_neibours().remove_if([to_node](const std::weak_ptr<Node<T>>& neighbour_wp) {
-					if (auto neighbour_sp = neighbour_wp.lock()) {
-						return *neighbour_sp == *to_node;
-					}
-					return false;
-					});
-				to_node->get_neibours().remove_if([node](const std::weak_ptr<Node<T>>& neighbour_wp) {
-					if (auto neighbour_sp = neighbour_wp.lock()) {
-						return *neighbour_sp == *node;
+			auto it = std::find(adj_list[i].begin(), adj_list[i].end(), *edge);
+			if (it != adj_list[i].end()) {
+				size_t to_index = it->get_to_index();
+				bool paired = it->is_paired();
+				adj_list[i].erase(it);
+				if (paired) {
+					auto& opposite = adj_list[to_index];
+					auto opposite_it = find_opposite(to_index, i, edge->get_weight());
+					if (opposite_it != opposite.end()) {
+						opposite.erase(opposite_it);
 					}
-					return false;
-					});
+				}
+				else {
+					unpaired.remove(to_index, i);
+				}
+				split_component(i, to_index);
 				break;
 			}
 		}
@@ -332,25 +733,44 @@ public:
 		for (size_t i = 0; i < adj_list.size(); ++i) {
 			adj_list[i].clear();
 		}
-		adj_list.clear();
-		for (size_t i = 0; i < nodes.size(); ++i) {
-			nodes[i]->get_neibours().clear();
-		}
+		unpaired.reset();
+		component_index.reset();
 	}
 
 
 	std::vector<std::shared_ptr<Node<T>>> getAllNodesWithValue(const T& value) {
 		std::vector <std::shared_ptr<Node<T>>> result;
+		if (value_index.is_enabled()) {
+			std::vector<size_t> indices;
+			value_index.for_each(value, [&indices](size_t index) { indices.push_back(index); });
+			std::sort(indices.begin(), indices.end());
+			for (size_t index : indices) {
+				result.push_back(nodes[index]);
+			}
+			return result;
+		}
 		for (size_t i = 0; i < nodes.size(); ++i) {
-			if (nodes[i]->get_data() == value) {
+			if (nodes[i] && nodes[i]->get_data() == value) {
 				result.push_back(nodes[i]);
 			}
 		}
 		return result;
 	}
+	//Nodes are numbered 0 .. getAmountNodes() - 1, the empty slots of removed nodes included.
+	//The algorithms skip the empty slots, see is_node_alive in graph_concepts.hpp
 	size_t getAmountNodes() const {
 		return nodes.size();
 	}
+	//Empty slots left by removed nodes until compact()
+	size_t getAmountRemovedNodes() const {
+		return amount_removed;
+	}
+	bool isNodeRemoved(size_t index) const {
+		if (index >= nodes.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+		return !nodes[index];
+	}
 	size_t getAmountEdge() const {
 		size_t result = 0;
 		for (size_t i = 0; i < adj_list.size(); ++i) {
@@ -361,55 +781,64 @@ public:
 	}
 	size_t getAmountEdgesOfNode(std::shared_ptr<Node<T>> node) {
 		if (!node) {
-			throw NodeIsNullException();
+			throw graph_library::NodeIsNullException();
 		}
 
 		size_t index = get_index_node(node);
 		if (index == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
+			throw graph_library::NodeNotFoundException();
 		}
 
-		if (index > adj_list.size()) {
-			throw InvalidIndexException();
-		}
 		return adj_list[index].size();
 	}
 
 
-	WEIGHT_TYPE getEdgeWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) const {
-		WEIGHT_TYPE weight_edge_f = getEdgeWeightOriented(node_first, node_second);
+	weight_type getEdgeWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) const {
+		weight_type weight_edge_f = getEdgeWeightOriented(node_first, node_second);
 		return weight_edge_f;
 	}
-	WEIGHT_TYPE getEdgeWeightOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) const {
+	//Unweighted graphs return 1 for an existing edge
+	weight_type getEdgeWeightOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) const {
+		ScopedTimer timer(Operation::GET_EDGE_WEIGHT);
 		if (!node_first || !node_second) {
-			return std::numeric_limits<WEIGHT_TYPE>::max();
+			return std::numeric_limits<weight_type>::max();
 		}
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
-		if (index_first == std::numeric_limits<WEIGHT_TYPE>::max() || index_second == std::numeric_limits<WEIGHT_TYPE>::max()) {
-			throw NodeNotFoundException();
+		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
+			throw graph_library::NodeNotFoundException();
 		}
 
-		if (index_first >= adj_list.size()) {
-			return std::numeric_limits<WEIGHT_TYPE>::max();
-		}
+		ScopedCounter visited(Counter::EDGES_VISITED);
 		for (auto it = adj_list[index_first].begin(); it != adj_list[index_first].end(); ++it) {
-			if (*(it->get_to_node()) == *(node_second)) {
+			visited.add();
+			if (it->get_to_index() == index_second) {
 				return it->get_weight();
 			}
 		}
-		return std::numeric_limits<WEIGHT_TYPE>::max();
+		return std::numeric_limits<weight_type>::max();
 	}
 
 
-	void setEdgeOrientedWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE newWeight) {
+	void setEdgeOrientedWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type newWeight)
+		requires (weighted && !undirected)
+	{
+		ScopedTimer timer(Operation::SET_EDGE_WEIGHT);
 		Edge<T, WEIGHT_TYPE>* edge = findEdgeOrientedMutable(node_first, node_second, 0, false);
 		if (edge) {
 			edge->set_weight(newWeight);
 		}
 	}
-	void setEdgeWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE newWeight) {
+	//Directed graphs change only the edge from node_first to node_second
+	void setEdgeWeight(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type newWeight) requires weighted {
+		ScopedTimer timer(Operation::SET_EDGE_WEIGHT);
+		if constexpr (directed) {
+			if (Edge<T, WEIGHT_TYPE>* edge = findEdgeOrientedMutable(node_first, node_second, 0, false)) {
+				edge->set_weight(newWeight);
+			}
+			return;
+		}
 		std::vector<Edge<T, WEIGHT_TYPE>*> vec = findEdgeMutable(node_first, node_second, 0, false);
 		if (vec.size() != 2) {
 			throw std::runtime_error("Wrong size output \"findEdge\" vector");
@@ -422,49 +851,118 @@ public:
 	T& getNodeData(const std::shared_ptr<Node<T>> node) const {
 		return node->get_data();
 	}
+	//Use this instead of Node::set_data while the value index is enabled
 	void setNodeData(const std::shared_ptr<Node<T>> node, const T& newData) {
+		size_t index = get_index_node(node);
+		if (index < nodes.size() && nodes[index] == node) {
+			value_index.erase(node->get_data(), index);
+			value_index.insert(newData, index);
+		}
 		node->set_data(newData);
 	}
-	const std::list<std::weak_ptr<Node<T>>>& getNeighbors(std::shared_ptr<Node<T>> node) const {
-		return node->get_neibours();
+	//View over the edges of the node that yields the neighbouring nodes
+	NeighbourView<T, WEIGHT_TYPE> getNeighbors(std::shared_ptr<Node<T>> node) const {
+		ScopedTimer timer(Operation::GET_NEIGHBORS);
+		size_t index = get_index_node(node);
+		if (index == std::numeric_limits<size_t>::max()) {
+			throw graph_library::NodeNotFoundException();
+		}
+		return NeighbourView<T, WEIGHT_TYPE>(adj_list[index], nodes);
+	}
+	//Edges leaving the node with the given index, see graph_concepts.hpp
+	const edge_list& outEdges(size_t index) const {
+		return adj_list[index];
 	}
 
 
-	//Finds the first vertex encountered with data = value
-	std::shared_ptr<Node<T>> findNode(const T& value) const {
+	//Immutable CSR snapshot of the graph for read-heavy workloads, O(V + E)
+	CompactGraph<T, WEIGHT_TYPE> freeze() const {
+		ScopedTimer timer(Operation::FREEZE);
+		using vertex_id = typename CompactGraph<T, WEIGHT_TYPE>::vertex_id;
+		if (nodes.size() > std::numeric_limits<vertex_id>::max()) {
+			throw graph_library::GraphException("Too many nodes for a CompactGraph");
+		}
+
+		std::vector<T> nodes_data;
+		nodes_data.reserve(nodes.size());
+		for (const auto& node : nodes) {
+			if (node) {
+				nodes_data.push_back(node->get_data());
+			}
+			else if constexpr (std::default_initializable<T>) {
+				//Removed nodes stay in the snapshot as isolated nodes, so that the indices match
+				nodes_data.push_back(T());
+			}
+			else {
+				throw graph_library::GraphException("Compact the graph before freezing, it has removed nodes");
+			}
+		}
+
+		std::vector<std::uint64_t> offsets(nodes.size() + 1, 0);
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			offsets[i + 1] = offsets[i] + adj_list[i].size();
+		}
+
+		std::vector<vertex_id> targets;
+		std::vector<weight_type> weights;
+		targets.reserve(offsets.back());
+		if constexpr (weighted) {
+			weights.reserve(offsets.back());
+		}
 		for (size_t i = 0; i < nodes.size(); ++i) {
-			if (nodes[i]->get_data() == value) {
-				return nodes[i];
+			for (const auto& edge : adj_list[i]) {
+				targets.push_back(static_cast<vertex_id>(edge.get_to_index()));
+				if constexpr (weighted) {
+					weights.push_back(edge.get_weight());
+				}
 			}
 		}
-		return nullptr;
+
+		return CompactGraph<T, WEIGHT_TYPE>(std::move(nodes_data), std::move(offsets), std::move(targets), std::move(weights));
+	}
+
+
+	//Finds the first vertex encountered with data = value
+	std::shared_ptr<Node<T>> findNode(const T& value) const {
+		ScopedTimer timer(Operation::FIND_NODE);
+		size_t index = find_index_by_value(value);
+		if (index == std::numeric_limits<size_t>::max()) {
+			return nullptr;
+		}
+		return nodes[index];
+	}
+	//nullptr for the slot of a removed node
+	std::shared_ptr<Node<T>> getNode(size_t index) const {
+		if (index >= nodes.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+		return nodes[index];
 	}
-	//Finds the first edge encountered between node_first and node_second
+	//Finds the first edge encountered between node_first and node_second, for directed graphs only from node_first.
+	//The returned pointers are valid until the edges of the graph are changed
 	std::vector<const Edge<T, WEIGHT_TYPE>*> findEdge(
 		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second,
-		WEIGHT_TYPE weight = 0, bool comparable_by_weight = true) const
+		weight_type weight = 0, bool comparable_by_weight = true) const
 	{
+		ScopedTimer timer(Operation::FIND_EDGE);
 		std::vector<const Edge<T, WEIGHT_TYPE>*> result;
 
 		if (!node_first || !node_second) {
-			throw NodeIsNullException();
+			throw graph_library::NodeIsNullException();
 		}
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
-		}
-
-		if (index_first >= adj_list.size() || index_second >= adj_list.size()) {
-			throw InvalidIndexException();
+			throw graph_library::NodeNotFoundException();
 		}
 
+		ScopedCounter visited(Counter::EDGES_VISITED);
 		auto& list_first = adj_list[index_first];
 		for (auto it = list_first.begin(); it != list_first.end(); ++it) {
-			auto to_node = it->get_to_node();
-			if (to_node && to_node == node_second) {
-				if (!comparable_by_weight || weight == it->get_weight()) {
+			visited.add();
+			if (it->get_to_index() == index_second) {
+				if (!weighted || !comparable_by_weight || weight == it->get_weight()) {
 					result.push_back(&(*it));
 					if (index_first != index_second) {
 						break;
@@ -473,15 +971,15 @@ public:
 			}
 		}
 
-		if (index_first == index_second) {
+		if (directed || index_first == index_second) {
 			return result;
 		}
 
 		auto& list_second = adj_list[index_second];
 		for (auto it = list_second.begin(); it != list_second.end(); ++it) {
-			auto to_node = it->get_to_node();
-			if (to_node && to_node == node_first) {
-				if (!comparable_by_weight || weight == it->get_weight()) {
+			visited.add();
+			if (it->get_to_index() == index_first) {
+				if (!weighted || !comparable_by_weight || weight == it->get_weight()) {
 					result.push_back(&(*it));
 					break;
 				}
@@ -491,26 +989,24 @@ public:
 		return result;
 	}
 	const Edge<T, WEIGHT_TYPE>* findEdgeOriented(
-		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0, bool comparable_by_weight = true) const {
+		const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type weight = 0, bool comparable_by_weight = true) const {
+		ScopedTimer timer(Operation::FIND_EDGE);
 		if (!node_first || !node_second) {
-			throw NodeIsNullException();
+			throw graph_library::NodeIsNullException();
 		}
 
 		size_t index_first = get_index_node(node_first);
 		size_t index_second = get_index_node(node_second);
 		if (index_first == std::numeric_limits<size_t>::max() || index_second == std::numeric_limits<size_t>::max()) {
-			throw NodeNotFoundException();
-		}
-
-		if (index_first >= adj_list.size()) {
-			return nullptr;
+			throw graph_library::NodeNotFoundException();
 		}
 
 		auto& edge_list = adj_list[index_first];
+		ScopedCounter visited(Counter::EDGES_VISITED);
 		for (auto& edge : edge_list) {
-			auto to_node = edge.get_to_node();
-			if (to_node && *to_node == *node_second) {
-				if (comparable_by_weight) {
+			visited.add();
+			if (edge.get_to_index() == index_second) {
+				if (weighted && comparable_by_weight) {
 					if (edge.get_weight() == weight) {
 						return &edge;
 					}
@@ -528,11 +1024,81 @@ public:
 	bool hasNode(const T& value) const {
 		return !(findNode(value) == nullptr);
 	}
-	bool hasEdgeOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0) const {
+	bool hasEdgeOriented(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type weight = 0) const {
+		ScopedTimer timer(Operation::HAS_EDGE);
 		return (findEdgeOriented(node_first, node_second, weight, (weight == 0 ? false : true)) != nullptr);
 	}
-	bool hasEdge(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, WEIGHT_TYPE weight = 0) const {
-		return hasEdgeOriented(node_first, node_second) && hasEdgeOriented(node_second, node_first);
+	//Directed graphs look for the edge from node_first to node_second. Undirected graphs look at
+	//one direction only, the opposite edge always exists. A non-zero weight has to match as in hasEdgeOriented
+	bool hasEdge(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second, weight_type weight = 0) const {
+		ScopedTimer timer(Operation::HAS_EDGE);
+		if constexpr (directed || undirected) {
+			return hasEdgeOriented(node_first, node_second, weight);
+		}
+		else {
+			return hasEdgeOriented(node_first, node_second, weight) && hasEdgeOriented(node_second, node_first, weight);
+		}
+	}
+
+
+	//Hash index from node data to node, makes findNode and lookups of
+	//nodes from other graphs O(1). Requires std::hash<T>
+	void enableValueIndex() requires Hashable<T> {
+		if (!value_index.is_enabled()) {
+			value_index.enable();
+			rebuild_value_index();
+		}
+	}
+	void disableValueIndex() {
+		value_index.disable();
+	}
+	bool hasValueIndex() const {
+		return value_index.is_enabled();
+	}
+
+
+	//Index of the connected components, edges count in both directions (weakly connected for directed edges).
+	//Adding an edge relabels the smaller of the two components it joins, amortized O(log V) per node.
+	//Removing edges searches from their ends at once and splits off the smaller side, see ComponentIndex for
+	//the costs. Queries are O(1) and do not change the graph, so a const graph can be queried from several threads.
+	//Queries throw GraphException while the index is disabled. A removed node is a component of its own until compact()
+	void enableComponentIndex() {
+		if (!component_index.is_enabled()) {
+			component_index.enable(adj_list);
+		}
+	}
+	void disableComponentIndex() {
+		component_index.disable();
+	}
+	bool hasComponentIndex() const {
+		return component_index.is_enabled();
+	}
+	bool connected(size_t index_first, size_t index_second) const {
+		if (index_first >= nodes.size() || index_second >= nodes.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+		check_component_index();
+		return component_index.component_of(index_first) == component_index.component_of(index_second);
+	}
+	bool connected(const std::shared_ptr<Node<T>> node_first, const std::shared_ptr<Node<T>> node_second) const {
+		return connected(component_query_index(node_first), component_query_index(node_second));
+	}
+	//Id of the component of the node, below the amount of nodes and the same for all its nodes.
+	//Ids stay until the edges change, ids of merged or split components are reused
+	size_t componentOf(size_t index) const {
+		if (index >= nodes.size()) {
+			throw graph_library::InvalidIndexException();
+		}
+		check_component_index();
+		return component_index.component_of(index);
+	}
+	size_t componentOf(const std::shared_ptr<Node<T>> node) const {
+		return componentOf(component_query_index(node));
+	}
+	//Amount of components of the nodes that are not removed
+	size_t componentCount() const {
+		check_component_index();
+		return component_index.amount_components() - amount_removed;
 	}
 
 
@@ -540,27 +1106,64 @@ public:
 		removeAllNodes();
 	}
 	bool empty() const {
-		return nodes.size() == 0;
+		return nodes.size() == amount_removed;
+	}
+	allocator_type getAllocator() const {
+		return allocator;
+	}
+	//Approximate amount of memory owned by the graph in bytes. Heap memory owned by T itself
+	//and allocator bookkeeping are not counted
+	size_t memoryFootprint() const {
+		//allocate_shared places the node and its control block in one allocation
+		constexpr size_t node_size = sizeof(Node<T>) + 2 * sizeof(void*);
+		size_t result = sizeof(*this);
+		result += nodes.capacity() * sizeof(node_pointer);
+		result += (nodes.size() - amount_removed) * node_size;
+		result += unpaired.memory_footprint();
+		result += adj_list.capacity() * sizeof(edge_list);
+		for (const auto& edges : adj_list) {
+			result += edges.capacity() * sizeof(Edge<T, WEIGHT_TYPE>);
+		}
+		result += value_index.memory_footprint();
+		result += component_index.memory_footprint();
+		return result;
 	}
 
 
 	//Operators
-	Graph<T, WEIGHT_TYPE>& operator=(const Graph<T, WEIGHT_TYPE>& other) {
+	//The nodes are copied, not shared: changing one graph does not change the other
+	Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>& operator=(const Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>& other) {
 		if (&other != this) {
-			clear();
-			nodes = other.nodes;
-			adj_list = other.adj_list;
+			constexpr bool propagate = std::allocator_traits<ALLOCATOR>::propagate_on_container_copy_assignment::value;
+			*this = Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>(other, propagate ? other.allocator : allocator);
 		}
 		return *this;
 	}
-	Graph<T, WEIGHT_TYPE>& operator=(Graph<T, WEIGHT_TYPE>&& other) noexcept {
+	Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>& operator=(Graph<T, WEIGHT_TYPE, ALLOCATOR, DIRECTION>&& other) noexcept {
 		if (&other != this) {
 			clear();
+			if constexpr (std::allocator_traits<ALLOCATOR>::propagate_on_container_move_assignment::value) {
+				allocator = other.allocator;
+			}
 			nodes = std::move(other.nodes);
 			adj_list = std::move(other.adj_list);
+			unpaired = std::move(other.unpaired);
+			amount_removed = std::exchange(other.amount_removed, 0);
+			value_index = std::move(other.value_index);
+			component_index = std::move(other.component_index);
+			owner = std::move(other.owner);
+			if (owner) {
+				owner->graph = this;
+			}
 		}
 		return *this;
 	}
 };
 
+template <typename T, typename WEIGHT_TYPE = int, typename ALLOCATOR = graph_library::instrumentation::DefaultAllocator>
+using DirectedGraph = Graph<T, WEIGHT_TYPE, ALLOCATOR, Directed>;
+
+template <typename T, typename WEIGHT_TYPE = int, typename ALLOCATOR = graph_library::instrumentation::DefaultAllocator>
+using UndirectedGraph = Graph<T, WEIGHT_TYPE, ALLOCATOR, Undirected>;
+
 #endif
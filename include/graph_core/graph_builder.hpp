@@ -0,0 +1,348 @@
+#pragma once
+#include "graph.hpp"
+#include "compact_graph.hpp"
+#include "edge_record.hpp"
+#include "../graph_algorithms/parallel.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+struct GraphBuilderOptions {
+	//1 - single thread, 0 - all hardware threads
+	size_t threads = 1;
+	//Add the opposite of every edge, as Graph::addEdge does (self-loops are added once)
+	bool symmetric = false;
+	bool remove_self_loops = false;
+	//Keep only the lightest of the edges with the same ends. Implies sort_edges
+	bool remove_duplicates = false;
+	//Sort the edges of every node by target and weight, otherwise they keep the order of insertion
+	bool sort_edges = false;
+};
+
+namespace graph_library::detail {
+
+	//Counting and scatter of buildCompactGraph. The histograms hold COUNT values, which must hold the amount of stored edges
+	template <typename COUNT, typename WEIGHT_TYPE, typename FOR_EACH>
+	void scatter_edge_records(size_t threads, size_t amount_nodes, size_t amount_records, bool mirror, bool skip_loops,
+		const FOR_EACH& for_each_record, std::vector<std::uint64_t>& offsets, std::vector<std::uint32_t>& targets, std::vector<WEIGHT_TYPE>& weights)
+	{
+		//Counting: counts[t][i] is the amount of edges of node i in the range of thread t
+		std::vector<std::vector<COUNT>> counts(threads);
+		std::vector<std::uint8_t> out_of_range(threads, 0);
+		graph_library::parallel_for(threads, amount_records, [&](size_t thread_id, size_t begin, size_t end) {
+			auto& count = counts[thread_id];
+			count.assign(amount_nodes, 0);
+			for_each_record(begin, end, [&](const EdgeRecord<WEIGHT_TYPE>& edge) {
+				if (edge.from >= amount_nodes || edge.to >= amount_nodes) {
+					out_of_range[thread_id] = 1;
+					return;
+				}
+				if (edge.from == edge.to && skip_loops) {
+					return;
+				}
+				++count[edge.from];
+				if (mirror && edge.to != edge.from) {
+					++count[edge.to];
+				}
+				});
+			});
+		if (std::find(out_of_range.begin(), out_of_range.end(), 1) != out_of_range.end()) {
+			throw graph_library::InvalidIndexException();
+		}
+
+		//offsets[i + 1] is the degree of node i, range_first[t] the first edge of the range of nodes of thread t
+		offsets.assign(amount_nodes + 1, 0);
+		std::vector<std::uint64_t> range_first(threads + 1, 0);
+		graph_library::parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+			std::uint64_t amount = 0;
+			for (size_t i = begin; i < end; ++i) {
+				for (const auto& count : counts) {
+					offsets[i + 1] += count[i];
+				}
+				amount += offsets[i + 1];
+			}
+			range_first[thread_id + 1] = amount;
+			});
+		for (size_t t = 0; t < threads; ++t) {
+			range_first[t + 1] += range_first[t];
+		}
+		//counts[t][i] becomes the first slot of thread t in node i and offsets[i + 1] the end of node i
+		graph_library::parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+			std::uint64_t start = range_first[thread_id];
+			for (size_t i = begin; i < end; ++i) {
+				for (auto& count : counts) {
+					COUNT amount = count[i];
+					count[i] = static_cast<COUNT>(start);
+					start += amount;
+				}
+				offsets[i + 1] = start;
+			}
+			});
+
+		targets.resize(offsets.back());
+		weights.resize(offsets.back());
+		//Scatter: counts[t][i] serves as the next free slot of thread t in node i
+		graph_library::parallel_for(threads, amount_records, [&](size_t thread_id, size_t begin, size_t end) {
+			auto& next = counts[thread_id];
+			for_each_record(begin, end, [&](const EdgeRecord<WEIGHT_TYPE>& edge) {
+				if (edge.from == edge.to && skip_loops) {
+					return;
+				}
+				std::uint64_t slot = next[edge.from]++;
+				targets[slot] = edge.to;
+				weights[slot] = edge.weight;
+				if (mirror && edge.to != edge.from) {
+					slot = next[edge.to]++;
+					targets[slot] = edge.from;
+					weights[slot] = edge.weight;
+				}
+				});
+			});
+	}
+}
+
+/*
+CSR arrays from batches of edges in one O(V + E) pass (plus the per-node sorts when sorting or deduplicating).
+The edges of all batches are split into one contiguous range per thread. Every thread counts the degrees of its range
+in a histogram of its own, prefix sums over the nodes and then over the threads give every thread its own slots
+in each node, and every thread scatters its range into its slots. No atomics are needed and every node keeps its
+edges in the order of the batches whatever the amount of threads. The histograms take O(threads * V) memory,
+so counting uses fewer threads when there are fewer than threads edges per node, and 32-bit counts below 2^31 edges.
+Sorting and deduplicating work on whole nodes, the compaction after deduplicating on one range of nodes per thread.
+nodes_data may be empty: the nodes then get their index as data when T is an integer type and T() otherwise
+*/
+template <typename T, typename WEIGHT_TYPE>
+CompactGraph<T, WEIGHT_TYPE> buildCompactGraph(size_t amount_nodes, std::span<const std::vector<EdgeRecord<WEIGHT_TYPE>>> batches,
+	std::vector<T> nodes_data = {}, const GraphBuilderOptions& options = GraphBuilderOptions())
+{
+	if (amount_nodes > std::numeric_limits<std::uint32_t>::max()) {
+		throw graph_library::GraphException("Too many nodes for a CompactGraph");
+	}
+	if (!nodes_data.empty() && nodes_data.size() != amount_nodes) {
+		throw graph_library::GraphException("Node data does not match the amount of nodes");
+	}
+
+	//Position of every batch in the concatenation of all batches
+	std::vector<size_t> batch_first(batches.size() + 1, 0);
+	for (size_t b = 0; b < batches.size(); ++b) {
+		batch_first[b + 1] = batch_first[b] + batches[b].size();
+	}
+	const size_t amount_records = batch_first.back();
+	const size_t threads = std::max<size_t>(1, std::min(graph_library::resolve_threads(options.threads), amount_records));
+	const bool mirror = options.symmetric;
+	const bool skip_loops = options.remove_self_loops;
+	const bool sort_edges = options.sort_edges || options.remove_duplicates;
+	//Calls function(edge) for the edges [begin, end) of the concatenation of all batches
+	auto for_each_record = [&](size_t begin, size_t end, auto&& function) {
+		size_t b = static_cast<size_t>(std::upper_bound(batch_first.begin(), batch_first.end(), begin) - batch_first.begin()) - 1;
+		for (; begin < end; ++b) {
+			size_t last = std::min(end, batch_first[b + 1]);
+			for (size_t k = begin - batch_first[b]; k < last - batch_first[b]; ++k) {
+				function(batches[b][k]);
+			}
+			begin = last;
+		}
+	};
+
+	//Histograms of 32 bits while the stored edges fit, at most twice the records with symmetric.
+	//Counting runs on at most amount_records / amount_nodes threads, so the histograms take no more memory than the edges
+	const size_t count_threads = std::max<size_t>(1, std::min(threads, amount_nodes == 0 ? threads : amount_records / amount_nodes));
+	std::vector<std::uint64_t> offsets;
+	std::vector<std::uint32_t> targets;
+	std::vector<WEIGHT_TYPE> weights;
+	if (amount_records <= std::numeric_limits<std::uint32_t>::max() / 2) {
+		graph_library::detail::scatter_edge_records<std::uint32_t>(count_threads, amount_nodes, amount_records, mirror, skip_loops,
+			for_each_record, offsets, targets, weights);
+	}
+	else {
+		graph_library::detail::scatter_edge_records<std::uint64_t>(count_threads, amount_nodes, amount_records, mirror, skip_loops,
+			for_each_record, offsets, targets, weights);
+	}
+	if (nodes_data.empty()) {
+		nodes_data.resize(amount_nodes);
+		if constexpr (std::is_integral_v<T>) {
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				nodes_data[i] = static_cast<T>(i);
+			}
+		}
+	}
+	if (!sort_edges) {
+		return CompactGraph<T, WEIGHT_TYPE>(std::move(nodes_data), std::move(offsets), std::move(targets), std::move(weights));
+	}
+
+	//Amount of edges of every node left after removing duplicates
+	std::vector<std::uint64_t> kept(options.remove_duplicates ? amount_nodes : 0);
+	//Nodes are handed out in chunks, a few nodes of high degree would leave a thread with a fixed range of nodes most of the sorting
+	std::vector<std::vector<std::pair<std::uint32_t, WEIGHT_TYPE>>> orders(threads);
+	graph_library::parallel_for_dynamic(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+		auto& order = orders[thread_id];
+		for (size_t i = begin; i < end; ++i) {
+			std::uint64_t first = offsets[i];
+			std::uint64_t last = offsets[i + 1];
+			order.clear();
+			for (std::uint64_t k = first; k < last; ++k) {
+				order.emplace_back(targets[k], weights[k]);
+			}
+			std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+				return a.first < b.first || (a.first == b.first && a.second < b.second);
+				});
+			if (options.remove_duplicates) {
+				//The lightest edge of every target comes first
+				auto unique_end = std::unique(order.begin(), order.end(), [](const auto& a, const auto& b) {
+					return a.first == b.first;
+					});
+				order.erase(unique_end, order.end());
+				kept[i] = order.size();
+			}
+			for (size_t k = 0; k < order.size(); ++k) {
+				targets[first + k] = order[k].first;
+				weights[first + k] = order[k].second;
+			}
+		}
+		});
+
+	if (!options.remove_duplicates) {
+		return CompactGraph<T, WEIGHT_TYPE>(std::move(nodes_data), std::move(offsets), std::move(targets), std::move(weights));
+	}
+
+	//Compaction of the deduplicated edges into new arrays
+	std::vector<std::uint64_t> kept_first(threads + 1, 0);
+	std::vector<std::uint64_t> range_kept(threads, 0);
+	graph_library::parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			range_kept[thread_id] += kept[i];
+		}
+		});
+	for (size_t t = 0; t < threads; ++t) {
+		kept_first[t + 1] = kept_first[t] + range_kept[t];
+	}
+	std::vector<std::uint64_t> new_offsets(amount_nodes + 1, 0);
+	std::vector<std::uint32_t> new_targets(kept_first.back());
+	std::vector<WEIGHT_TYPE> new_weights(kept_first.back());
+	graph_library::parallel_for(threads, amount_nodes, [&](size_t thread_id, size_t begin, size_t end) {
+		std::uint64_t write = kept_first[thread_id];
+		for (size_t i = begin; i < end; ++i) {
+			std::uint64_t first = offsets[i];
+			std::copy_n(targets.begin() + first, kept[i], new_targets.begin() + write);
+			std::copy_n(weights.begin() + first, kept[i], new_weights.begin() + write);
+			write += kept[i];
+			new_offsets[i + 1] = write;
+		}
+		});
+	return CompactGraph<T, WEIGHT_TYPE>(std::move(nodes_data), std::move(new_offsets), std::move(new_targets), std::move(new_weights));
+}
+
+/*
+Collects edges by node index in batches and builds a graph from all of them at once,
+instead of one Graph::addEdge call per edge:
+	GraphBuilder<int> builder(amount_nodes);
+	builder.addEdges(std::move(batch));
+	Graph<int> graph = builder.build();
+The amount of nodes grows to the largest index used by an edge.
+*/
+template <typename T, typename WEIGHT_TYPE = int>
+class GraphBuilder {
+private:
+	std::vector<std::vector<EdgeRecord<WEIGHT_TYPE>>> batches;
+	std::vector<T> nodes_data;
+	size_t amount_nodes;
+	size_t amount_edges = 0;
+	GraphBuilderOptions options;
+
+	void note_edge(const EdgeRecord<WEIGHT_TYPE>& edge) {
+		amount_nodes = std::max<size_t>(amount_nodes, static_cast<size_t>(std::max(edge.from, edge.to)) + 1);
+	}
+	static EdgeRecord<WEIGHT_TYPE> make_record(size_t from, size_t to, WEIGHT_TYPE weight) {
+		if (from >= std::numeric_limits<std::uint32_t>::max() || to >= std::numeric_limits<std::uint32_t>::max()) {
+			throw graph_library::InvalidIndexException();
+		}
+		return EdgeRecord<WEIGHT_TYPE>{ static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight };
+	}
+public:
+	explicit GraphBuilder(size_t _amount_nodes = 0, const GraphBuilderOptions& _options = GraphBuilderOptions())
+		: amount_nodes(_amount_nodes), options(_options) {}
+
+	size_t getAmountNodes() const {
+		return amount_nodes;
+	}
+	//Edges added so far, before symmetric copies and deduplication
+	size_t getAmountEdge() const {
+		return amount_edges;
+	}
+	const GraphBuilderOptions& getOptions() const {
+		return options;
+	}
+	void setOptions(const GraphBuilderOptions& _options) {
+		options = _options;
+	}
+	void setAmountNodes(size_t _amount_nodes) {
+		amount_nodes = std::max(amount_nodes, _amount_nodes);
+	}
+	//Data of every node, the amount of nodes becomes at least data.size()
+	void setNodesData(std::vector<T> data) {
+		setAmountNodes(data.size());
+		nodes_data = std::move(data);
+	}
+	void reserve(size_t amount) {
+		if (batches.empty()) {
+			batches.emplace_back();
+		}
+		batches.back().reserve(batches.back().size() + amount);
+	}
+
+	void addEdge(size_t from, size_t to, WEIGHT_TYPE weight = 0) {
+		if (batches.empty()) {
+			batches.emplace_back();
+		}
+		batches.back().push_back(make_record(from, to, weight));
+		note_edge(batches.back().back());
+		++amount_edges;
+	}
+	void addEdges(std::span<const EdgeRecord<WEIGHT_TYPE>> edges) {
+		if (batches.empty()) {
+			batches.emplace_back();
+		}
+		batches.back().insert(batches.back().end(), edges.begin(), edges.end());
+		for (const auto& edge : edges) {
+			note_edge(edge);
+		}
+		amount_edges += edges.size();
+	}
+	//Takes the batch without copying it
+	void addEdges(std::vector<EdgeRecord<WEIGHT_TYPE>>&& edges) {
+		for (const auto& edge : edges) {
+			note_edge(edge);
+		}
+		amount_edges += edges.size();
+		batches.push_back(std::move(edges));
+		//Later single edges go to a batch of their own
+		batches.emplace_back();
+	}
+
+	//Both build functions leave the builder empty
+	CompactGraph<T, WEIGHT_TYPE> buildCompact() {
+		std::vector<T> data = std::move(nodes_data);
+		if (!data.empty() && data.size() < amount_nodes) {
+			data.resize(amount_nodes);
+		}
+		auto result = buildCompactGraph<T, WEIGHT_TYPE>(amount_nodes, batches, std::move(data), options);
+		clear();
+		return result;
+	}
+	template <typename ALLOCATOR = graph_library::instrumentation::DefaultAllocator>
+	Graph<T, WEIGHT_TYPE, ALLOCATOR> build(const ALLOCATOR& allocator = ALLOCATOR()) {
+		return Graph<T, WEIGHT_TYPE, ALLOCATOR>(buildCompact(), allocator);
+	}
+	void clear() {
+		batches.clear();
+		nodes_data.clear();
+		amount_nodes = 0;
+		amount_edges = 0;
+	}
+};
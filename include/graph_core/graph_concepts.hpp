@@ -0,0 +1,67 @@
+#pragma once
+#include <concepts>
+#include <ranges>
+#include <utility>
+#include <cstddef>
+#include "graph_policies.hpp"
+
+//Every graph representation (Graph, CompactGraph, ...) exposes the same index-level interface:
+//	getAmountNodes()  - nodes are numbered 0 .. getAmountNodes() - 1
+//	outEdges(index)   - range of edges leaving the node, each edge has get_to_index() and get_weight()
+//Algorithms are written against this interface, so they run on any representation.
+template <typename GRAPH>
+using out_edges_t = decltype(std::declval<const GRAPH&>().outEdges(size_t{}));
+
+template <typename GRAPH>
+using out_edge_t = std::ranges::range_value_t<out_edges_t<GRAPH>>;
+
+template <typename GRAPH>
+using edge_weight_t = std::remove_cvref_t<decltype(std::declval<const out_edge_t<GRAPH>&>().get_weight())>;
+
+template <typename GRAPH>
+concept AdjacencyGraph = requires(const GRAPH& graph, size_t index) {
+	{ graph.getAmountNodes() } -> std::convertible_to<size_t>;
+	{ graph.outEdges(index) } -> std::ranges::forward_range;
+	{ std::declval<const out_edge_t<GRAPH>&>().get_to_index() } -> std::convertible_to<size_t>;
+	std::declval<const out_edge_t<GRAPH>&>().get_weight();
+};
+
+//Amount of edges leaving the node
+template <AdjacencyGraph GRAPH>
+size_t out_degree(const GRAPH& graph, size_t index) {
+	return static_cast<size_t>(std::ranges::distance(graph.outEdges(index)));
+}
+
+//Graph whose edges carry no weight (WEIGHT_TYPE = void), every edge counts as weight 1
+template <typename GRAPH>
+concept UnweightedGraph = AdjacencyGraph<GRAPH> && requires {
+	requires !out_edge_t<GRAPH>::weighted;
+};
+
+//Graph in which every edge is stored in both directions
+template <typename GRAPH>
+concept SymmetricGraph = AdjacencyGraph<GRAPH> && requires {
+	requires std::same_as<typename GRAPH::direction, Undirected>;
+};
+
+//False for the empty slot of a removed node (Graph::isNodeRemoved). Representations without removed nodes have only live nodes
+template <typename GRAPH>
+bool is_node_alive(const GRAPH& graph, size_t index) {
+	if constexpr (requires { graph.isNodeRemoved(index); }) {
+		return !graph.isNodeRemoved(index);
+	}
+	else {
+		return true;
+	}
+}
+
+//Amount of nodes that are not removed, the same as getAmountNodes() for representations without removed nodes
+template <typename GRAPH>
+size_t amount_live_nodes(const GRAPH& graph) {
+	if constexpr (requires { graph.getAmountRemovedNodes(); }) {
+		return graph.getAmountNodes() - graph.getAmountRemovedNodes();
+	}
+	else {
+		return graph.getAmountNodes();
+	}
+}
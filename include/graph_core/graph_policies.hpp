@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Compile-time policies of Graph.
+WEIGHT_TYPE = void makes a graph unweighted: an edge stores only the index of its target (4 bytes)
+and reports the weight 1 (unit_weight_t), so that the weighted algorithms count edges.
+The direction policy is the last template parameter of Graph:
+	Mixed      - addEdge stores both directions, addEdgeOriented one direction (the default)
+	Undirected - addEdge only. Every edge is stored in both directions, so the sources of unpaired edges
+	             are not kept and removing a node always finds the edges leading to it through their opposite edges
+	Directed   - addEdge stores one direction. hasEdge, findEdge, removeEdge and setEdgeWeight work on
+	             the edges from the first node to the second, removeAllEdgesOfNode removes the edges in both directions
+*/
+struct Mixed {};
+struct Undirected {};
+struct Directed {};
+
+template <typename DIRECTION>
+concept DirectionPolicy = std::same_as<DIRECTION, Mixed> || std::same_as<DIRECTION, Undirected> || std::same_as<DIRECTION, Directed>;
+
+//Weight of every edge of an unweighted graph
+using unit_weight_t = std::uint32_t;
+
+template <typename WEIGHT_TYPE>
+inline constexpr bool is_weighted_v = !std::is_void_v<WEIGHT_TYPE>;
+
+//Type in which a graph takes and returns weights: WEIGHT_TYPE, unit_weight_t for unweighted graphs
+template <typename WEIGHT_TYPE>
+using weight_value_t = std::conditional_t<is_weighted_v<WEIGHT_TYPE>, WEIGHT_TYPE, unit_weight_t>;
+
+//For every node of a Graph the sources of the edges leading to it that have no opposite edge (Edge::is_paired),
+//one entry per edge. Removing a node reaches the edges leading to it through their opposite edges and through
+//this list, without scanning the graph. Empty for undirected graphs, where every edge has an opposite edge
+template <typename ALLOCATOR, bool ENABLED>
+class UnpairedSources {
+private:
+	using list = std::vector<std::uint32_t, ALLOCATOR>;
+	using list_allocator = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<list>;
+	std::vector<list, list_allocator> lists;
+
+	list new_list() const {
+		return list(ALLOCATOR(lists.get_allocator()));
+	}
+public:
+	explicit UnpairedSources(const ALLOCATOR& allocator) : lists(list_allocator(allocator)) {}
+
+	const list& get(size_t index) const {
+		return lists[index];
+	}
+	void add(size_t to, size_t from) {
+		lists[to].push_back(static_cast<std::uint32_t>(from));
+	}
+	//Removes up to amount entries of from, the order of the list is not kept
+	void remove(size_t to, size_t from, size_t amount = 1) {
+		auto& sources = lists[to];
+		for (size_t i = sources.size(); i-- > 0 && amount != 0; ) {
+			if (sources[i] == from) {
+				sources[i] = sources.back();
+				sources.pop_back();
+				--amount;
+			}
+		}
+	}
+	//Empties the list of the node and returns its old content
+	list take(size_t index) {
+		list result = new_list();
+		result.swap(lists[index]);
+		return result;
+	}
+	void push_back() {
+		lists.push_back(new_list());
+	}
+	//Collects the unpaired edges of the edge lists, after the nodes were renumbered or the edges copied
+	template <typename LISTS>
+	void rebuild(const LISTS& adj_list) {
+		lists.clear();
+		lists.reserve(adj_list.size());
+		for (size_t i = 0; i < adj_list.size(); ++i) {
+			push_back();
+		}
+		for (size_t i = 0; i < adj_list.size(); ++i) {
+			for (const auto& edge : adj_list[i]) {
+				if (!edge.is_paired()) {
+					add(edge.get_to_index(), i);
+				}
+			}
+		}
+	}
+	void reset() {
+		for (auto& sources : lists) {
+			sources.clear();
+		}
+	}
+	void clear() {
+		lists.clear();
+	}
+	size_t memory_footprint() const {
+		size_t result = lists.capacity() * sizeof(list);
+		for (const auto& sources : lists) {
+			result += sources.capacity() * sizeof(std::uint32_t);
+		}
+		return result;
+	}
+};
+
+template <typename ALLOCATOR>
+class UnpairedSources<ALLOCATOR, false> {
+public:
+	explicit UnpairedSources(const ALLOCATOR&) {}
+
+	std::span<const std::uint32_t> get(size_t) const {
+		return {};
+	}
+	void add(size_t, size_t) {}
+	void remove(size_t, size_t, size_t = 1) {}
+	std::vector<std::uint32_t> take(size_t) {
+		return {};
+	}
+	void push_back() {}
+	template <typename LISTS>
+	void rebuild(const LISTS&) {}
+	void reset() {}
+	void clear() {}
+	size_t memory_footprint() const {
+		return 0;
+	}
+};
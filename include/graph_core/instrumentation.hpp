@@ -0,0 +1,406 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Counters and timers of the hot paths of Graph and the algorithms. Compiled in only when
+GRAPH_LIBRARY_INSTRUMENTATION is defined (CMake option GRAPH_LIBRARY_INSTRUMENTATION); otherwise
+ScopedCounter and ScopedTimer are empty classes with empty inline functions and snapshot() returns zeros,
+so the same calling code builds either way and an optimizing build has nothing left to run for them
+(benchmarks/instrumentation_overhead.cpp compares the times). The macro must be the same in every translation unit.
+
+Every thread writes only its own statistics, so recording never waits for other threads.
+snapshot() sums all threads, including the ones that have finished:
+	auto statistics = graph_library::instrumentation::snapshot();
+	statistics.get(graph_library::instrumentation::Counter::LOOKUP_SCANS);
+	statistics.toJson();
+*/
+namespace graph_library::instrumentation {
+
+#ifdef GRAPH_LIBRARY_INSTRUMENTATION
+	inline constexpr bool enabled = true;
+#else
+	inline constexpr bool enabled = false;
+#endif
+
+	enum class Counter : size_t {
+		//Node handles resolved to an index (Graph::get_index_node)
+		NODE_LOOKUPS,
+		//Lookups of nodes that are not from this graph, which search the nodes by value
+		LOOKUP_SCANS,
+		//Nodes compared by value during those searches
+		LOOKUP_COMPARISONS,
+		//Edges looked at by the edge searches of Graph and by the algorithms
+		EDGES_VISITED,
+		//Allocations of CountingAllocator, the default allocator of Graph in an instrumented build
+		ALLOCATIONS,
+		DEALLOCATIONS,
+		ALLOCATED_BYTES,
+		DEALLOCATED_BYTES,
+		AMOUNT
+	};
+
+	//Public calls that are timed. A call made from inside another timed call is not timed by itself,
+	//so that the time of hasEdge is not counted again as the time of findEdgeOriented
+	enum class Operation : size_t {
+		ADD_NODE,
+		ADD_EDGE,
+		REMOVE_NODE,
+		REMOVE_EDGE,
+		FIND_NODE,
+		FIND_EDGE,
+		HAS_EDGE,
+		GET_EDGE_WEIGHT,
+		SET_EDGE_WEIGHT,
+		GET_NEIGHBORS,
+		COPY,
+		FREEZE,
+		COMPACT,
+		PERMUTE,
+		SPLIT_COMPONENTS,
+		BFS,
+		MULTI_SOURCE_BFS,
+		DFS,
+		STRONGLY_CONNECTED_COMPONENTS,
+		TOPOLOGICAL_SORT,
+		FIND_CYCLE,
+		DIJKSTRA,
+		BIDIRECTIONAL_DIJKSTRA,
+		KRUSKAL,
+		PRIM,
+		COUNT_TRIANGLES,
+		CLUSTERING_COEFFICIENT,
+		COMMON_NEIGHBORS,
+		REORDER,
+		SPMV,
+		PAGERANK,
+		KATZ_CENTRALITY,
+		LABEL_PROPAGATION,
+		AMOUNT
+	};
+
+	inline constexpr size_t AMOUNT_COUNTERS = static_cast<size_t>(Counter::AMOUNT);
+	inline constexpr size_t AMOUNT_OPERATIONS = static_cast<size_t>(Operation::AMOUNT);
+
+	inline const char* counterName(Counter counter) {
+		static constexpr const char* names[AMOUNT_COUNTERS] = {
+			"node_lookups", "lookup_scans", "lookup_comparisons", "edges_visited",
+			"allocations", "deallocations", "allocated_bytes", "deallocated_bytes"
+		};
+		return names[static_cast<size_t>(counter)];
+	}
+	inline const char* operationName(Operation operation) {
+		static constexpr const char* names[AMOUNT_OPERATIONS] = {
+			"add_node", "add_edge", "remove_node", "remove_edge", "find_node", "find_edge", "has_edge",
+			"get_edge_weight", "set_edge_weight", "get_neighbors", "copy", "freeze", "compact", "permute", "split_components",
+			"bfs", "multi_source_bfs", "dfs", "strongly_connected_components", "topological_sort", "find_cycle",
+			"dijkstra", "bidirectional_dijkstra", "kruskal", "prim", "count_triangles", "clustering_coefficient",
+			"common_neighbors", "reorder", "spmv", "pagerank", "katz_centrality", "label_propagation"
+		};
+		return names[static_cast<size_t>(operation)];
+	}
+
+	struct OperationStatistics {
+		std::uint64_t calls = 0;
+		std::uint64_t nanoseconds = 0;
+	};
+
+	//Totals of all threads since the start of the program or the last reset()
+	struct StatisticsSnapshot {
+		std::array<std::uint64_t, AMOUNT_COUNTERS> counters{};
+		std::array<OperationStatistics, AMOUNT_OPERATIONS> operations{};
+
+		std::uint64_t get(Counter counter) const {
+			return counters[static_cast<size_t>(counter)];
+		}
+		const OperationStatistics& get(Operation operation) const {
+			return operations[static_cast<size_t>(operation)];
+		}
+		//{"counters": {"node_lookups": 12, ...}, "operations": {"add_edge": {"calls": 3, "nanoseconds": 950}, ...}}.
+		//Operations that were never called are left out
+		std::string toJson() const {
+			std::string result = "{\"counters\": {";
+			for (size_t i = 0; i < AMOUNT_COUNTERS; ++i) {
+				result += i == 0 ? "\"" : ", \"";
+				result += counterName(static_cast<Counter>(i));
+				result += "\": " + std::to_string(counters[i]);
+			}
+			result += "}, \"operations\": {";
+			bool first = true;
+			for (size_t i = 0; i < AMOUNT_OPERATIONS; ++i) {
+				if (operations[i].calls == 0) {
+					continue;
+				}
+				result += first ? "\"" : ", \"";
+				result += operationName(static_cast<Operation>(i));
+				result += "\": {\"calls\": " + std::to_string(operations[i].calls) +
+					", \"nanoseconds\": " + std::to_string(operations[i].nanoseconds) + "}";
+				first = false;
+			}
+			result += "}}";
+			return result;
+		}
+	};
+
+#ifdef GRAPH_LIBRARY_INSTRUMENTATION
+	namespace detail {
+
+		//Statistics of one thread. Only the owning thread writes them, with plain loads and stores,
+		//the atomics only let snapshot() read them from another thread
+		struct ThreadStatistics {
+			std::array<std::atomic<std::uint64_t>, AMOUNT_COUNTERS> counters{};
+			std::array<std::atomic<std::uint64_t>, AMOUNT_OPERATIONS> calls{};
+			std::array<std::atomic<std::uint64_t>, AMOUNT_OPERATIONS> nanoseconds{};
+			//Timed calls of this thread that are running
+			size_t depth = 0;
+
+			static void add(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+				value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+			}
+			void add_to(StatisticsSnapshot& snapshot) const {
+				for (size_t i = 0; i < AMOUNT_COUNTERS; ++i) {
+					snapshot.counters[i] += counters[i].load(std::memory_order_relaxed);
+				}
+				for (size_t i = 0; i < AMOUNT_OPERATIONS; ++i) {
+					snapshot.operations[i].calls += calls[i].load(std::memory_order_relaxed);
+					snapshot.operations[i].nanoseconds += nanoseconds[i].load(std::memory_order_relaxed);
+				}
+			}
+		};
+
+		//Statistics of the running threads and the sums of the finished ones. The mutex is taken when
+		//a thread records for the first time, when it exits and by snapshot() and reset()
+		class Registry {
+		private:
+			std::mutex mutex;
+			std::vector<const ThreadStatistics*> threads;
+			StatisticsSnapshot finished;
+			//Totals at the last reset(), subtracted by snapshot()
+			StatisticsSnapshot baseline;
+
+			StatisticsSnapshot totals() const {
+				StatisticsSnapshot result = finished;
+				for (const ThreadStatistics* statistics : threads) {
+					statistics->add_to(result);
+				}
+				return result;
+			}
+		public:
+			static Registry& instance() {
+				static Registry registry;
+				return registry;
+			}
+
+			void add(const ThreadStatistics* statistics) {
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.push_back(statistics);
+			}
+			void remove(const ThreadStatistics* statistics) {
+				std::lock_guard<std::mutex> lock(mutex);
+				statistics->add_to(finished);
+				std::erase(threads, statistics);
+			}
+			StatisticsSnapshot snapshot() {
+				std::lock_guard<std::mutex> lock(mutex);
+				StatisticsSnapshot result = totals();
+				for (size_t i = 0; i < AMOUNT_COUNTERS; ++i) {
+					result.counters[i] -= baseline.counters[i];
+				}
+				for (size_t i = 0; i < AMOUNT_OPERATIONS; ++i) {
+					result.operations[i].calls -= baseline.operations[i].calls;
+					result.operations[i].nanoseconds -= baseline.operations[i].nanoseconds;
+				}
+				return result;
+			}
+			void reset() {
+				std::lock_guard<std::mutex> lock(mutex);
+				baseline = totals();
+			}
+		};
+
+		//Set once the statistics of the thread are gone. Trivially destructible, so it can still be read
+		//by destructors of static objects that run after the thread local ones
+		inline bool& thread_exited() {
+			thread_local bool exited = false;
+			return exited;
+		}
+
+		//Registers the statistics of the thread on first use and hands them over to the registry at thread exit.
+		//The registry is created first, so it is destroyed after the statistics of the main thread
+		class ThreadSlot {
+		private:
+			Registry& registry;
+		public:
+			ThreadStatistics statistics;
+
+			ThreadSlot() : registry(Registry::instance()) {
+				registry.add(&statistics);
+			}
+			~ThreadSlot() {
+				registry.remove(&statistics);
+				thread_exited() = true;
+			}
+			ThreadSlot(const ThreadSlot&) = delete;
+			ThreadSlot& operator=(const ThreadSlot&) = delete;
+		};
+
+		//nullptr while the thread is exiting, what is recorded then is dropped
+		inline ThreadStatistics* local() {
+			if (thread_exited()) {
+				return nullptr;
+			}
+			thread_local ThreadSlot slot;
+			return &slot.statistics;
+		}
+	}
+
+	inline void count(Counter counter, std::uint64_t amount = 1) {
+		if (detail::ThreadStatistics* statistics = detail::local()) {
+			detail::ThreadStatistics::add(statistics->counters[static_cast<size_t>(counter)], amount);
+		}
+	}
+	inline StatisticsSnapshot snapshot() {
+		return detail::Registry::instance().snapshot();
+	}
+	//Starts counting from zero again. Counts of other threads that are being recorded concurrently may fall on either side
+	inline void reset() {
+		detail::Registry::instance().reset();
+	}
+
+	//Sums up in a local variable and adds to the thread statistics once, at the end of the scope.
+	//Meant for counting in inner loops
+	class ScopedCounter {
+	private:
+		Counter counter;
+		std::uint64_t amount = 0;
+	public:
+		explicit ScopedCounter(Counter _counter) : counter(_counter) {}
+		~ScopedCounter() {
+			if (amount != 0) {
+				count(counter, amount);
+			}
+		}
+		ScopedCounter(const ScopedCounter&) = delete;
+		ScopedCounter& operator=(const ScopedCounter&) = delete;
+
+		void add(std::uint64_t value = 1) {
+			amount += value;
+		}
+	};
+
+	//Times the scope as one call of the operation, unless it is nested in another timed call of the thread
+	class ScopedTimer {
+	private:
+		Operation operation;
+		detail::ThreadStatistics* statistics;
+		bool outermost = false;
+		std::chrono::steady_clock::time_point start;
+	public:
+		explicit ScopedTimer(Operation _operation) : operation(_operation), statistics(detail::local()) {
+			if (statistics) {
+				outermost = statistics->depth++ == 0;
+			}
+			if (outermost) {
+				start = std::chrono::steady_clock::now();
+			}
+		}
+		~ScopedTimer() {
+			if (!statistics) {
+				return;
+			}
+			--statistics->depth;
+			if (outermost) {
+				auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+				size_t index = static_cast<size_t>(operation);
+				detail::ThreadStatistics::add(statistics->calls[index], 1);
+				detail::ThreadStatistics::add(statistics->nanoseconds[index], static_cast<std::uint64_t>(elapsed));
+			}
+		}
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+	};
+#else
+	inline void count(Counter, std::uint64_t = 1) {}
+	inline StatisticsSnapshot snapshot() {
+		return StatisticsSnapshot();
+	}
+	inline void reset() {}
+
+	class ScopedCounter {
+	public:
+		explicit ScopedCounter(Counter) {}
+		ScopedCounter(const ScopedCounter&) = delete;
+		ScopedCounter& operator=(const ScopedCounter&) = delete;
+
+		void add(std::uint64_t = 1) {}
+	};
+
+	class ScopedTimer {
+	public:
+		explicit ScopedTimer(Operation) {}
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+	};
+#endif
+
+	//Allocator adaptor that counts the allocations and bytes of BASE. Records only in an instrumented build
+	template <typename T, typename BASE = std::allocator<T>>
+	class CountingAllocator {
+	private:
+		template <typename, typename>
+		friend class CountingAllocator;
+		using base_traits = std::allocator_traits<BASE>;
+
+		[[no_unique_address]] BASE base;
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = typename base_traits::propagate_on_container_copy_assignment;
+		using propagate_on_container_move_assignment = typename base_traits::propagate_on_container_move_assignment;
+		using propagate_on_container_swap = typename base_traits::propagate_on_container_swap;
+		using is_always_equal = typename base_traits::is_always_equal;
+		template <typename U>
+		struct rebind {
+			using other = CountingAllocator<U, typename base_traits::template rebind_alloc<U>>;
+		};
+
+		CountingAllocator() = default;
+		CountingAllocator(const BASE& _base) : base(_base) {}
+		template <typename U, typename OTHER_BASE>
+		CountingAllocator(const CountingAllocator<U, OTHER_BASE>& other) : base(other.base) {}
+
+		T* allocate(size_t amount) {
+			count(Counter::ALLOCATIONS);
+			count(Counter::ALLOCATED_BYTES, amount * sizeof(T));
+			return base_traits::allocate(base, amount);
+		}
+		void deallocate(T* pointer, size_t amount) {
+			count(Counter::DEALLOCATIONS);
+			count(Counter::DEALLOCATED_BYTES, amount * sizeof(T));
+			base_traits::deallocate(base, pointer, amount);
+		}
+		CountingAllocator select_on_container_copy_construction() const {
+			return CountingAllocator(base_traits::select_on_container_copy_construction(base));
+		}
+
+		template <typename U, typename OTHER_BASE>
+		bool operator==(const CountingAllocator<U, OTHER_BASE>& other) const {
+			return base == other.base;
+		}
+	};
+
+	//Default allocator of Graph: counted in an instrumented build, plain std::allocator otherwise
+#ifdef GRAPH_LIBRARY_INSTRUMENTATION
+	using DefaultAllocator = CountingAllocator<std::byte>;
+#else
+	using DefaultAllocator = std::allocator<std::byte>;
+#endif
+}
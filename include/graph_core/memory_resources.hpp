@@ -0,0 +1,203 @@
+#pragma once
+#include "graph.hpp"
+#include <memory_resource>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+//Graph whose memory comes from a std::pmr::memory_resource:
+//	ArenaResource arena;
+//	PmrGraph<int> graph(&arena);
+template <typename T, typename WEIGHT_TYPE = int>
+using PmrGraph = Graph<T, WEIGHT_TYPE, std::pmr::polymorphic_allocator<std::byte>>;
+
+/*
+Monotonic arena: allocations are cut from large chunks, deallocation does nothing and all memory
+is returned to the upstream resource at once by release() or the destructor, one call per chunk.
+Meant for graphs that are built and thrown away as a whole. Not thread safe.
+The arena must outlive every graph placed in it
+*/
+class ArenaResource : public std::pmr::memory_resource {
+private:
+	struct Chunk {
+		Chunk* previous;
+		size_t size;
+	};
+
+	std::pmr::memory_resource* upstream;
+	Chunk* last_chunk = nullptr;
+	std::byte* current = nullptr;
+	std::byte* end = nullptr;
+	size_t next_chunk_size;
+	size_t used = 0;
+	size_t reserved = 0;
+
+	void add_chunk(size_t bytes, size_t alignment) {
+		size_t size = std::max(next_chunk_size, sizeof(Chunk) + bytes + alignment);
+		auto* chunk = static_cast<Chunk*>(upstream->allocate(size, alignof(std::max_align_t)));
+		chunk->previous = last_chunk;
+		chunk->size = size;
+		last_chunk = chunk;
+		current = reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+		end = reinterpret_cast<std::byte*>(chunk) + size;
+		reserved += size;
+		//Geometric growth keeps the amount of chunks logarithmic
+		next_chunk_size = std::min<size_t>(next_chunk_size * 2, size_t(1) << 30);
+	}
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		auto aligned = [this, alignment]() {
+			auto address = reinterpret_cast<std::uintptr_t>(current);
+			return reinterpret_cast<std::byte*>((address + alignment - 1) / alignment * alignment);
+		};
+		std::byte* result = current == nullptr ? nullptr : aligned();
+		if (result == nullptr || result + bytes > end) {
+			add_chunk(bytes, alignment);
+			result = aligned();
+		}
+		current = result + bytes;
+		used += bytes;
+		return result;
+	}
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+public:
+	explicit ArenaResource(size_t initial_chunk_size = size_t(1) << 16,
+		std::pmr::memory_resource* _upstream = std::pmr::new_delete_resource())
+		: upstream(_upstream), next_chunk_size(std::max<size_t>(initial_chunk_size, 256)) {}
+	ArenaResource(const ArenaResource&) = delete;
+	ArenaResource& operator=(const ArenaResource&) = delete;
+	~ArenaResource() override {
+		release();
+	}
+
+	//Frees all chunks. Everything allocated from the arena becomes invalid
+	void release() {
+		while (last_chunk != nullptr) {
+			Chunk* previous = last_chunk->previous;
+			upstream->deallocate(last_chunk, last_chunk->size, alignof(std::max_align_t));
+			last_chunk = previous;
+		}
+		current = end = nullptr;
+		used = 0;
+		reserved = 0;
+	}
+	//Bytes handed out since the last release
+	size_t bytesUsed() const {
+		return used;
+	}
+	//Bytes taken from the upstream resource
+	size_t bytesReserved() const {
+		return reserved;
+	}
+};
+
+/*
+Pool of equal blocks for allocations of at most block_size bytes, such as nodes with their
+control blocks. Freed blocks are reused, larger requests go to the upstream resource.
+Blocks are carved from chunks that are returned to the upstream resource at once by release()
+or the destructor. Not thread safe
+*/
+class FixedPoolResource : public std::pmr::memory_resource {
+private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+	struct Chunk {
+		Chunk* previous;
+		size_t size;
+	};
+
+	std::pmr::memory_resource* upstream;
+	size_t block_size;
+	size_t blocks_per_chunk;
+	FreeBlock* free_blocks = nullptr;
+	Chunk* last_chunk = nullptr;
+	//Part of the last chunk not cut into blocks yet
+	std::byte* current = nullptr;
+	std::byte* end = nullptr;
+	size_t blocks_in_use = 0;
+
+	static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+	//The first block of a chunk starts after the header at the block alignment
+	static constexpr size_t HEADER_SIZE = (sizeof(Chunk) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+
+	bool fits(size_t bytes, size_t alignment) const {
+		return bytes <= block_size && alignment <= BLOCK_ALIGNMENT;
+	}
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		if (!fits(bytes, alignment)) {
+			return upstream->allocate(bytes, alignment);
+		}
+		++blocks_in_use;
+		if (free_blocks != nullptr) {
+			FreeBlock* block = free_blocks;
+			free_blocks = block->next;
+			return block;
+		}
+		if (current == end) {
+			size_t size = HEADER_SIZE + block_size * blocks_per_chunk;
+			auto* chunk = static_cast<Chunk*>(upstream->allocate(size, BLOCK_ALIGNMENT));
+			chunk->previous = last_chunk;
+			chunk->size = size;
+			last_chunk = chunk;
+			current = reinterpret_cast<std::byte*>(chunk) + HEADER_SIZE;
+			end = reinterpret_cast<std::byte*>(chunk) + size;
+		}
+		void* result = current;
+		current += block_size;
+		return result;
+	}
+	void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+		if (!fits(bytes, alignment)) {
+			upstream->deallocate(pointer, bytes, alignment);
+			return;
+		}
+		--blocks_in_use;
+		auto* block = static_cast<FreeBlock*>(pointer);
+		block->next = free_blocks;
+		free_blocks = block;
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+public:
+	explicit FixedPoolResource(size_t _block_size, size_t _blocks_per_chunk = 4096,
+		std::pmr::memory_resource* _upstream = std::pmr::new_delete_resource())
+		: upstream(_upstream),
+		block_size((std::max(_block_size, sizeof(FreeBlock)) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT),
+		blocks_per_chunk(std::max<size_t>(_blocks_per_chunk, 1)) {}
+	FixedPoolResource(const FixedPoolResource&) = delete;
+	FixedPoolResource& operator=(const FixedPoolResource&) = delete;
+	~FixedPoolResource() override {
+		release();
+	}
+
+	//Frees all chunks. Every block becomes invalid; larger allocations stay with the upstream resource
+	void release() {
+		while (last_chunk != nullptr) {
+			Chunk* previous = last_chunk->previous;
+			upstream->deallocate(last_chunk, last_chunk->size, BLOCK_ALIGNMENT);
+			last_chunk = previous;
+		}
+		free_blocks = nullptr;
+		current = end = nullptr;
+		blocks_in_use = 0;
+	}
+	size_t blockSize() const {
+		return block_size;
+	}
+	size_t blocksInUse() const {
+		return blocks_in_use;
+	}
+};
+
+//Upper bound of the single allocation that holds a node of PmrGraph<T> with its control block
+//(vtable pointer, two counters and the allocator), a block size of a FixedPoolResource for nodes
+template <typename T>
+constexpr size_t pmr_node_block_size() {
+	return sizeof(Node<T>) + 4 * sizeof(void*);
+}
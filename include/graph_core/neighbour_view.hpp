@@ -0,0 +1,72 @@
+#pragma once
+#include "node.hpp"
+#include "edge.hpp"
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+
+//Read-only view over the edges of one node that yields the neighbouring nodes.
+//It does not own anything and is valid until the graph is changed
+template <typename T, typename WEIGHT_TYPE = int>
+class NeighbourView {
+private:
+	using edge_iterator = const Edge<T, WEIGHT_TYPE>*;
+	using node_pointer = std::shared_ptr<Node<T>>;
+
+	edge_iterator first;
+	edge_iterator last;
+	const node_pointer* nodes;
+public:
+	class iterator {
+	private:
+		edge_iterator edge;
+		const node_pointer* nodes = nullptr;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::shared_ptr<Node<T>>;
+		using difference_type = std::ptrdiff_t;
+		using reference = const std::shared_ptr<Node<T>>&;
+		using pointer = const std::shared_ptr<Node<T>>*;
+
+		iterator() = default;
+		iterator(edge_iterator _edge, const node_pointer* _nodes) : edge(_edge), nodes(_nodes) {}
+
+		reference operator*() const {
+			return nodes[edge->get_to_index()];
+		}
+		pointer operator->() const {
+			return &nodes[edge->get_to_index()];
+		}
+		iterator& operator++() {
+			++edge;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator result = *this;
+			++edge;
+			return result;
+		}
+		bool operator==(const iterator& other) const {
+			return edge == other.edge;
+		}
+	};
+
+	//Any contiguous containers of edges and node pointers, whatever their allocators
+	template <typename EDGES, typename NODES>
+	NeighbourView(const EDGES& _edges, const NODES& _nodes)
+		: first(_edges.data()), last(_edges.data() + _edges.size()), nodes(_nodes.data()) {}
+
+	iterator begin() const {
+		return iterator(first, nodes);
+	}
+	iterator end() const {
+		return iterator(last, nodes);
+	}
+	size_t size() const {
+		return static_cast<size_t>(last - first);
+	}
+	bool empty() const {
+		return first == last;
+	}
+};
@@ -1,22 +1,118 @@
 #pragma once
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <concepts>
+#include <iterator>
+#include <limits>
+#include <cstddef>
+#include "graph_policies.hpp"
+
+template <typename T, typename WEIGHT_TYPE, typename ALLOCATOR, DirectionPolicy DIRECTION>
+class Graph;
+
+template <typename T>
+class Node;
+
+//View over the edges of one node that yields the neighbouring nodes, returned by Node::get_neibours.
+//The same as NeighbourView, but it does not depend on the weight type of the graph: the edges are walked
+//with their size as the stride and target reads the index from one edge.
+//It does not own anything and is valid until the graph is changed
+template <typename T>
+class NodeNeighbourView {
+private:
+	using node_pointer = std::shared_ptr<Node<T>>;
+	using target_function = size_t(*)(const std::byte* edge);
+
+	const std::byte* first = nullptr;
+	size_t amount = 0;
+	size_t stride = 0;
+	target_function target = nullptr;
+	const node_pointer* nodes = nullptr;
+public:
+	class iterator {
+	private:
+		const std::byte* edge = nullptr;
+		size_t stride = 0;
+		target_function target = nullptr;
+		const node_pointer* nodes = nullptr;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::shared_ptr<Node<T>>;
+		using difference_type = std::ptrdiff_t;
+		using reference = const std::shared_ptr<Node<T>>&;
+		using pointer = const std::shared_ptr<Node<T>>*;
+
+		iterator() = default;
+		iterator(const std::byte* _edge, size_t _stride, target_function _target, const node_pointer* _nodes)
+			: edge(_edge), stride(_stride), target(_target), nodes(_nodes) {}
+
+		reference operator*() const {
+			return nodes[target(edge)];
+		}
+		pointer operator->() const {
+			return &nodes[target(edge)];
+		}
+		iterator& operator++() {
+			edge += stride;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator result = *this;
+			edge += stride;
+			return result;
+		}
+		bool operator==(const iterator& other) const {
+			return edge == other.edge;
+		}
+	};
+
+	//Empty view of a node that belongs to no graph
+	NodeNeighbourView() = default;
+	NodeNeighbourView(const std::byte* _first, size_t _amount, size_t _stride, target_function _target, const node_pointer* _nodes)
+		: first(_first), amount(_amount), stride(_stride), target(_target), nodes(_nodes) {}
+
+	iterator begin() const {
+		return iterator(first, stride, target, nodes);
+	}
+	iterator end() const {
+		return iterator(first + amount * stride, stride, target, nodes);
+	}
+	size_t size() const {
+		return amount;
+	}
+	bool empty() const {
+		return amount == 0;
+	}
+};
+
+//Link from the nodes to the graph that stores their edges. The graph keeps it on the heap and points it
+//at itself when it is moved, so that moving a graph does not touch its nodes
+template <typename T>
+struct NodeOwner {
+	const void* graph = nullptr;
+	NodeNeighbourView<T>(*neighbours)(const void* graph, size_t index) = nullptr;
+};
 
 template <typename T>
 class Node {
 private:
 	T data;
-	//Weak_ptr allows you to see your neighbors without owning them
-	std::list<std::weak_ptr<Node<T>>> neighbours;
+	//Index of the node in the owning graph. It is assigned by Graph and lets
+	//every edge operation find the node in O(1) instead of scanning by data
+	size_t index = std::numeric_limits<size_t>::max();
+	//The edges of the node are stored by the graph, get_neibours looks them up through the owner.
+	//nullptr once the node is removed from its graph or the graph is destroyed
+	const NodeOwner<T>* owner = nullptr;
+
+	template <typename, typename, typename, DirectionPolicy>
+	friend class Graph;
 public:
 	//Construstors and destructor
 	Node() requires std::default_initializable<T> : data() {}
 	Node(const T& _data) : data(_data) {}
 	Node(T&& _data) : data(std::move(_data)) {}
 	Node(const Node<T>& other) = delete;
-	Node(Node<T>&& other) noexcept : data(std::move(other.data)) , neighbours(std::move(other.neighbours)) {}
+	Node(Node<T>&& other) noexcept : data(std::move(other.data)), index(other.index), owner(other.owner) {}
 	~Node() = default;
 
 	//Operators
@@ -24,7 +120,8 @@ public:
 	Node<T>& operator=(Node<T>&& other) noexcept {
 		if (&other != this) {
 			data = std::move(other.data);
-			neighbours = std::move(other.neighbours);
+			index = other.index;
+			owner = other.owner;
 		}
 		return *this;
 	}
@@ -37,8 +134,8 @@ public:
 	}
 
 	//Main functions
-	size_t degree() const {
-		return neighbours.size();
+	size_t get_index() const {
+		return index;
 	}
 	void set_data(const T& value) {
 		data = value;
@@ -52,13 +149,15 @@ public:
 	const T& get_data() const {
 		return data;
 	}
-	std::list<std::weak_ptr<Node<T>>>& get_neibours() {
-		return neighbours;
-	}
-	const std::list<std::weak_ptr<Node<T>>>& get_neibours() const {
-		return neighbours;
+	//Neighbouring nodes, the same as Graph::getNeighbors. Empty for a node that is not in a graph
+	NodeNeighbourView<T> get_neibours() const {
+		if (!owner) {
+			return NodeNeighbourView<T>();
+		}
+		return owner->neighbours(owner->graph, index);
 	}
-	void add_neighbour(std::shared_ptr<Node<T>> neighbour) {
-		neighbours.push_back(neighbour);
+	//Amount of edges leaving the node
+	size_t degree() const {
+		return get_neibours().size();
 	}
 };
@@ -0,0 +1,94 @@
+#pragma once
+#include "../exceptions.hpp"
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+//Renumbering of the nodes of a graph: node i of the original graph becomes node newIndex(i),
+//node j of the renumbered graph was node originalIndex(j). Both directions are kept, so results
+//computed on a renumbered graph can be mapped back to the original indices
+class Permutation {
+private:
+	static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+	std::vector<std::uint32_t> new_indices;
+	std::vector<std::uint32_t> original_indices;
+
+	void check_size(size_t amount) const {
+		if (amount != size()) {
+			throw graph_library::GraphException("The permutation does not match the amount of nodes");
+		}
+	}
+public:
+	//Constructors and destructor
+	Permutation() = default;
+	//order[j] is the original index of the node that gets index j
+	explicit Permutation(std::vector<std::uint32_t> order) : new_indices(order.size(), NONE), original_indices(std::move(order)) {
+		for (size_t j = 0; j < original_indices.size(); ++j) {
+			std::uint32_t original = original_indices[j];
+			if (original >= original_indices.size() || new_indices[original] != NONE) {
+				throw graph_library::GraphException("The order is not a permutation of the nodes");
+			}
+			new_indices[original] = static_cast<std::uint32_t>(j);
+		}
+	}
+
+	static Permutation identity(size_t amount) {
+		std::vector<std::uint32_t> order(amount);
+		for (size_t j = 0; j < amount; ++j) {
+			order[j] = static_cast<std::uint32_t>(j);
+		}
+		return Permutation(std::move(order));
+	}
+
+
+	//----------- M A I N   F U N C T I O N S ---------
+
+
+	size_t size() const {
+		return original_indices.size();
+	}
+	size_t newIndex(size_t original) const {
+		return new_indices[original];
+	}
+	size_t originalIndex(size_t index) const {
+		return original_indices[index];
+	}
+	const std::vector<std::uint32_t>& getNewIndices() const {
+		return new_indices;
+	}
+	const std::vector<std::uint32_t>& getOriginalIndices() const {
+		return original_indices;
+	}
+	//Renumbering that takes the renumbered graph back to the original one
+	Permutation inverse() const {
+		return Permutation(new_indices);
+	}
+
+	//Values indexed by the original indices rearranged by the new indices, and back
+	template <typename VALUE>
+	std::vector<VALUE> toNewOrder(const std::vector<VALUE>& values) const {
+		check_size(values.size());
+		std::vector<VALUE> result;
+		result.reserve(values.size());
+		for (std::uint32_t original : original_indices) {
+			result.push_back(values[original]);
+		}
+		return result;
+	}
+	template <typename VALUE>
+	std::vector<VALUE> toOriginalOrder(const std::vector<VALUE>& values) const {
+		check_size(values.size());
+		std::vector<VALUE> result;
+		result.reserve(values.size());
+		for (std::uint32_t index : new_indices) {
+			result.push_back(values[index]);
+		}
+		return result;
+	}
+
+	bool operator==(const Permutation& other) const {
+		return original_indices == other.original_indices;
+	}
+};
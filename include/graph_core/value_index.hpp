@@ -0,0 +1,97 @@
+#pragma once
+#include <unordered_map>
+#include <functional>
+#include <concepts>
+#include <limits>
+#include <cstddef>
+
+template <typename T>
+concept Hashable = requires(const T& value) {
+	{ std::hash<T>{}(value) } -> std::convertible_to<size_t>;
+};
+
+//Optional hash index from node data to node index.
+//Several nodes may share the same data, so this is a multimap.
+template <typename T>
+class ValueIndex {
+private:
+	std::unordered_multimap<T, size_t> index;
+	bool enabled = false;
+public:
+	//Main functions
+	bool is_enabled() const {
+		return enabled;
+	}
+	void enable() {
+		enabled = true;
+	}
+	void disable() {
+		enabled = false;
+		index.clear();
+	}
+	void clear() {
+		index.clear();
+	}
+	void reserve(size_t amount) {
+		if (enabled) {
+			index.reserve(amount);
+		}
+	}
+	void insert(const T& value, size_t position) {
+		if (enabled) {
+			index.emplace(value, position);
+		}
+	}
+	void erase(const T& value, size_t position) {
+		if (!enabled) {
+			return;
+		}
+		auto range = index.equal_range(value);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == position) {
+				index.erase(it);
+				return;
+			}
+		}
+	}
+	//Returns the smallest index with data = value, or max() if there is none
+	size_t find_first(const T& value) const {
+		size_t result = std::numeric_limits<size_t>::max();
+		auto range = index.equal_range(value);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second < result) {
+				result = it->second;
+			}
+		}
+		return result;
+	}
+	//Approximate size of the buckets and the list nodes of the map
+	size_t memory_footprint() const {
+		return index.bucket_count() * sizeof(void*) +
+			index.size() * (sizeof(std::pair<const T, size_t>) + 2 * sizeof(void*));
+	}
+	template <typename Callback>
+	void for_each(const T& value, Callback&& callback) const {
+		auto range = index.equal_range(value);
+		for (auto it = range.first; it != range.second; ++it) {
+			callback(it->second);
+		}
+	}
+};
+
+//Types without std::hash can not be indexed, every call is a no-op
+template <typename T> requires (!Hashable<T>)
+class ValueIndex<T> {
+public:
+	bool is_enabled() const { return false; }
+	void enable() {}
+	void disable() {}
+	void clear() {}
+	void reserve(size_t) {}
+	void insert(const T&, size_t) {}
+	void erase(const T&, size_t) {}
+	size_t find_first(const T&) const { return std::numeric_limits<size_t>::max(); }
+	size_t memory_footprint() const { return 0; }
+	template <typename Callback>
+	void for_each(const T&, Callback&&) const {}
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	/*
+	On-disk layout of a graph in CSR form, shared by file_writer and file_reader:
+		BinaryGraphHeader
+		offsets       amount_nodes + 1 values of uint64
+		targets       amount_edges values of uint32
+		weights       amount_edges values of WEIGHT_TYPE
+		node data     amount_nodes values of T, only for trivially copyable T
+	Every section starts at a multiple of BINARY_GRAPH_ALIGNMENT, so the arrays can be used
+	in place when the file is mapped into memory. Numbers are stored in the byte order of the writer
+	*/
+	inline constexpr char BINARY_GRAPH_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'L', 'I', 'B' };
+	inline constexpr std::uint32_t BINARY_GRAPH_VERSION = 1;
+	inline constexpr std::uint32_t BINARY_GRAPH_BYTE_ORDER = 0x01020304;
+	inline constexpr std::uint64_t BINARY_GRAPH_ALIGNMENT = 64;
+
+	//Kind of a stored number, so a file is not read with a weight type of the same size but other meaning
+	enum class BinaryValueKind : std::uint32_t {
+		NONE = 0,
+		SIGNED = 1,
+		UNSIGNED = 2,
+		FLOATING = 3,
+		//Any other trivially copyable type
+		RAW = 4
+	};
+
+	template <typename VALUE>
+	constexpr BinaryValueKind binary_value_kind() {
+		if constexpr (std::is_floating_point_v<VALUE>) {
+			return BinaryValueKind::FLOATING;
+		}
+		else if constexpr (std::is_integral_v<VALUE> && std::is_signed_v<VALUE>) {
+			return BinaryValueKind::SIGNED;
+		}
+		else if constexpr (std::is_integral_v<VALUE>) {
+			return BinaryValueKind::UNSIGNED;
+		}
+		else if constexpr (std::is_trivially_copyable_v<VALUE>) {
+			return BinaryValueKind::RAW;
+		}
+		else {
+			return BinaryValueKind::NONE;
+		}
+	}
+
+	struct BinaryGraphHeader {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byte_order;
+		std::uint64_t amount_nodes;
+		std::uint64_t amount_edges;
+		std::uint32_t weight_size;
+		BinaryValueKind weight_kind;
+		//0 and NONE when node data is not stored
+		std::uint32_t node_data_size;
+		BinaryValueKind node_data_kind;
+		//Byte positions of the sections from the start of the file
+		std::uint64_t offsets_position;
+		std::uint64_t targets_position;
+		std::uint64_t weights_position;
+		std::uint64_t node_data_position;
+		std::uint64_t file_size;
+	};
+	static_assert(std::is_trivially_copyable_v<BinaryGraphHeader> && sizeof(BinaryGraphHeader) == 88);
+
+	inline constexpr std::uint64_t binary_graph_align(std::uint64_t position) {
+		return (position + BINARY_GRAPH_ALIGNMENT - 1) / BINARY_GRAPH_ALIGNMENT * BINARY_GRAPH_ALIGNMENT;
+	}
+
+	//Header with all section positions for a graph of the given size
+	template <typename T, typename WEIGHT_TYPE>
+	BinaryGraphHeader make_binary_graph_header(std::uint64_t amount_nodes, std::uint64_t amount_edges) {
+		BinaryGraphHeader header{};
+		for (size_t i = 0; i < sizeof(header.magic); ++i) {
+			header.magic[i] = BINARY_GRAPH_MAGIC[i];
+		}
+		header.version = BINARY_GRAPH_VERSION;
+		header.byte_order = BINARY_GRAPH_BYTE_ORDER;
+		header.amount_nodes = amount_nodes;
+		header.amount_edges = amount_edges;
+		header.weight_size = sizeof(WEIGHT_TYPE);
+		header.weight_kind = binary_value_kind<WEIGHT_TYPE>();
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			header.node_data_size = sizeof(T);
+			header.node_data_kind = binary_value_kind<T>();
+		}
+		else {
+			header.node_data_size = 0;
+			header.node_data_kind = BinaryValueKind::NONE;
+		}
+
+		header.offsets_position = binary_graph_align(sizeof(BinaryGraphHeader));
+		header.targets_position = binary_graph_align(header.offsets_position + (amount_nodes + 1) * sizeof(std::uint64_t));
+		header.weights_position = binary_graph_align(header.targets_position + amount_edges * sizeof(std::uint32_t));
+		header.node_data_position = binary_graph_align(header.weights_position + amount_edges * sizeof(WEIGHT_TYPE));
+		header.file_size = header.node_data_position + amount_nodes * header.node_data_size;
+		return header;
+	}
+}
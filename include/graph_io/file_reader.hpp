@@ -1 +1,680 @@
+#pragma once
+#include "binary_format.hpp"
+#include "../graph_core/compact_graph.hpp"
+#include "../graph_core/compressed_graph.hpp"
+#include "../graph_core/edge_record.hpp"
+#include "../graph_core/graph_builder.hpp"
+#include "../graph_algorithms/parallel.hpp"
+#include "../exceptions.hpp"
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <atomic>
+#include <span>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace graph_library {
+
+	//Read-only memory mapping of a whole file, unmapped on destruction
+	class MappedFile {
+	private:
+		const char* mapping = nullptr;
+		size_t length = 0;
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE file_mapping = nullptr;
+#endif
+
+		void release() {
+#ifdef _WIN32
+			if (mapping != nullptr) {
+				UnmapViewOfFile(mapping);
+			}
+			if (file_mapping != nullptr) {
+				CloseHandle(file_mapping);
+			}
+			if (file != INVALID_HANDLE_VALUE) {
+				CloseHandle(file);
+			}
+			file = INVALID_HANDLE_VALUE;
+			file_mapping = nullptr;
+#else
+			if (mapping != nullptr) {
+				munmap(const_cast<char*>(mapping), length);
+			}
+#endif
+			mapping = nullptr;
+			length = 0;
+		}
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+			file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				throw FileReadException("Cannot open file: " + path);
+			}
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size)) {
+				release();
+				throw FileReadException("Cannot read file size: " + path);
+			}
+			length = static_cast<size_t>(size.QuadPart);
+			if (length != 0) {
+				file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				void* view = file_mapping == nullptr ? nullptr : MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+				if (view == nullptr) {
+					release();
+					throw FileReadException("Cannot map file: " + path);
+				}
+				mapping = static_cast<const char*>(view);
+			}
+#else
+			int descriptor = open(path.c_str(), O_RDONLY);
+			if (descriptor < 0) {
+				throw FileReadException("Cannot open file: " + path);
+			}
+			struct stat status;
+			if (fstat(descriptor, &status) != 0) {
+				close(descriptor);
+				throw FileReadException("Cannot read file size: " + path);
+			}
+			length = static_cast<size_t>(status.st_size);
+			if (length != 0) {
+				void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+				if (view == MAP_FAILED) {
+					close(descriptor);
+					length = 0;
+					throw FileReadException("Cannot map file: " + path);
+				}
+				mapping = static_cast<const char*>(view);
+			}
+			//The mapping stays valid after the descriptor is closed
+			close(descriptor);
+#endif
+		}
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept {
+			*this = std::move(other);
+		}
+		~MappedFile() {
+			release();
+		}
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept {
+			if (this != &other) {
+				release();
+				std::swap(mapping, other.mapping);
+				std::swap(length, other.length);
+#ifdef _WIN32
+				std::swap(file, other.file);
+				std::swap(file_mapping, other.file_mapping);
+#endif
+			}
+			return *this;
+		}
+
+		const char* data() const {
+			return mapping;
+		}
+		size_t size() const {
+			return length;
+		}
+		bool empty() const {
+			return length == 0;
+		}
+		//Tells the kernel the whole file will be read soon
+		void prefetch() const {
+#ifndef _WIN32
+			if (mapping != nullptr) {
+				madvise(const_cast<char*>(mapping), length, MADV_WILLNEED);
+			}
+#endif
+		}
+	};
+
+	/*
+	Graph stored in the binary format of binary_format.hpp and used directly from the memory mapping.
+	Opening reads the header and the offsets, the targets and weights are read from disk on first access.
+	The interface follows CompactGraph, so every algorithm over AdjacencyGraph runs on it
+	*/
+	template <typename T, typename WEIGHT_TYPE = int>
+	class MappedGraph {
+	public:
+		using vertex_id = std::uint32_t;
+	private:
+		std::shared_ptr<const MappedFile> file;
+		size_t amount_nodes = 0;
+		size_t amount_edges = 0;
+		const std::uint64_t* offsets = nullptr;
+		const vertex_id* targets = nullptr;
+		const WEIGHT_TYPE* edge_weights = nullptr;
+		const T* nodes_data = nullptr;
+
+		void check_index(size_t index) const {
+			if (index >= amount_nodes) {
+				throw InvalidIndexException();
+			}
+		}
+		template <typename VALUE>
+		const VALUE* section(std::uint64_t position) const {
+			return reinterpret_cast<const VALUE*>(file->data() + position);
+		}
+	public:
+		//Checks the header, the section bounds and every offset, O(V), so a neighbour range never leaves the mapping,
+		//and every edge target, O(E), so a corrupt file throws ParseException instead of being read out of bounds.
+		//verify = false skips the targets: an unchecked opt-out only for files written by writeBinaryGraph and not changed since
+		explicit MappedGraph(const std::string& path, bool verify = true)
+			: file(std::make_shared<const MappedFile>(path))
+		{
+			if (file->size() < sizeof(BinaryGraphHeader)) {
+				throw ParseException("Truncated graph file: " + path);
+			}
+			BinaryGraphHeader header;
+			std::memcpy(&header, file->data(), sizeof(header));
+			if (std::memcmp(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic)) != 0) {
+				throw ParseException("Not a binary graph file: " + path);
+			}
+			if (header.version != BINARY_GRAPH_VERSION) {
+				throw ParseException("Unsupported binary graph version " + std::to_string(header.version) + ": " + path);
+			}
+			if (header.byte_order != BINARY_GRAPH_BYTE_ORDER) {
+				throw ParseException("Binary graph file has a different byte order: " + path);
+			}
+			if (header.weight_size != sizeof(WEIGHT_TYPE) || header.weight_kind != binary_value_kind<WEIGHT_TYPE>()) {
+				throw ParseException("Edge weight type does not match the file: " + path);
+			}
+			if (header.node_data_size != 0 &&
+				(header.node_data_size != sizeof(T) || header.node_data_kind != binary_value_kind<T>())) {
+				throw ParseException("Node data type does not match the file: " + path);
+			}
+			if (header.amount_nodes > std::numeric_limits<vertex_id>::max()) {
+				throw ParseException("Too many nodes in graph file: " + path);
+			}
+			//Bounds the section sizes, so computing the layout below can not overflow
+			if (header.amount_nodes >= file->size() / sizeof(std::uint64_t) || header.amount_edges > file->size() / sizeof(vertex_id)) {
+				throw ParseException("Truncated graph file: " + path);
+			}
+
+			//Recomputing the layout checks every position and size of the header at once
+			BinaryGraphHeader expected = make_binary_graph_header<T, WEIGHT_TYPE>(header.amount_nodes, header.amount_edges);
+			if (header.node_data_size == 0) {
+				expected.node_data_size = 0;
+				expected.node_data_kind = BinaryValueKind::NONE;
+				expected.file_size = expected.node_data_position;
+			}
+			if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+				throw ParseException("Corrupt binary graph header: " + path);
+			}
+			if (file->size() < header.file_size) {
+				throw ParseException("Truncated graph file: " + path);
+			}
+
+			amount_nodes = static_cast<size_t>(header.amount_nodes);
+			amount_edges = static_cast<size_t>(header.amount_edges);
+			offsets = section<std::uint64_t>(header.offsets_position);
+			targets = section<vertex_id>(header.targets_position);
+			edge_weights = section<WEIGHT_TYPE>(header.weights_position);
+			if (header.node_data_size != 0) {
+				nodes_data = section<T>(header.node_data_position);
+			}
+
+			//Offsets that start at 0, never decrease and end at the amount of edges keep every neighbour range inside the targets
+			if (offsets[0] != 0 || offsets[amount_nodes] != amount_edges) {
+				throw ParseException("Corrupt offsets in graph file: " + path);
+			}
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				if (offsets[i] > offsets[i + 1]) {
+					throw ParseException("Corrupt offsets in graph file: " + path);
+				}
+			}
+			if (verify) {
+				for (size_t i = 0; i < amount_edges; ++i) {
+					if (targets[i] >= amount_nodes) {
+						throw ParseException("Edge target out of range in graph file: " + path);
+					}
+				}
+			}
+		}
+
+		size_t getAmountNodes() const {
+			return amount_nodes;
+		}
+		size_t getAmountEdge() const {
+			return amount_edges;
+		}
+		size_t degree(size_t index) const {
+			check_index(index);
+			return offsets[index + 1] - offsets[index];
+		}
+		bool empty() const {
+			return amount_nodes == 0;
+		}
+
+		//False when T was not trivially copyable at writing time
+		bool hasNodeData() const {
+			return nodes_data != nullptr;
+		}
+		const T& getNodeData(size_t index) const {
+			check_index(index);
+			if (nodes_data == nullptr) {
+				throw GraphException("The graph file has no node data");
+			}
+			return nodes_data[index];
+		}
+		//The ranges check the index through degree
+		std::span<const vertex_id> neighbors(size_t index) const {
+			size_t amount = degree(index);
+			return std::span<const vertex_id>(targets + offsets[index], amount);
+		}
+		std::span<const WEIGHT_TYPE> weights(size_t index) const {
+			size_t amount = degree(index);
+			return std::span<const WEIGHT_TYPE>(edge_weights + offsets[index], amount);
+		}
+		CompactEdgeRange<WEIGHT_TYPE> outEdges(size_t index) const {
+			size_t amount = degree(index);
+			return CompactEdgeRange<WEIGHT_TYPE>(targets + offsets[index], edge_weights + offsets[index], amount);
+		}
+
+		//Copies the graph into memory. Without node data in the file the nodes get T()
+		CompactGraph<T, WEIGHT_TYPE> toCompactGraph() const {
+			std::vector<T> data(amount_nodes);
+			if (nodes_data != nullptr) {
+				std::copy(nodes_data, nodes_data + amount_nodes, data.begin());
+			}
+			return CompactGraph<T, WEIGHT_TYPE>(std::move(data), std::vector<std::uint64_t>(offsets, offsets + amount_nodes + 1),
+				std::vector<vertex_id>(targets, targets + amount_edges), std::vector<WEIGHT_TYPE>(edge_weights, edge_weights + amount_edges));
+		}
+		//Compresses the graph node by node straight from the mapping, so only the compressed graph is held in memory.
+		//The weights are read once more beforehand for their range. Without node data in the file the nodes get T()
+		CompressedGraph<T, WEIGHT_TYPE> toCompressedGraph() const {
+			CompressedGraphBuilder<T, WEIGHT_TYPE> builder(amount_nodes);
+			if (amount_edges != 0) {
+				auto [lightest, heaviest] = std::minmax_element(edge_weights, edge_weights + amount_edges);
+				builder = CompressedGraphBuilder<T, WEIGHT_TYPE>(amount_nodes, *lightest, *heaviest);
+			}
+			if (nodes_data != nullptr) {
+				builder.setNodesData(std::vector<T>(nodes_data, nodes_data + amount_nodes));
+			}
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+					builder.addEdge(i, targets[k], edge_weights[k]);
+				}
+			}
+			return builder.build();
+		}
+		const MappedFile& getFile() const {
+			return *file;
+		}
+	};
+
+	//Opens a file written by writeBinaryGraph. Throws FileReadException if the file can not be mapped
+	//and ParseException if it is corrupt, truncated or was written with other types.
+	//verify = false skips the check of every edge target, see MappedGraph
+	template <typename T, typename WEIGHT_TYPE = int>
+	MappedGraph<T, WEIGHT_TYPE> readBinaryGraph(const std::string& path, bool verify = true) {
+		return MappedGraph<T, WEIGHT_TYPE>(path, verify);
+	}
+
+
+	enum class TextGraphFormat {
+		//Chosen by the first line: a MatrixMarket banner, a DIMACS "c" or "p" line, otherwise EDGE_LIST
+		AUTO,
+		//"from to [weight]" per line, ids from 0, comments start with # or %. A missing weight is 1
+		EDGE_LIST,
+		//DIMACS shortest path format (.gr): "p sp nodes arcs" and "a from to weight" lines, ids from 1, comments start with c
+		DIMACS,
+		//MatrixMarket coordinate format: banner, size line "rows columns entries" and "row column [value]" lines, ids from 1
+		MATRIX_MARKET
+	};
+
+	struct TextReadOptions {
+		TextGraphFormat format = TextGraphFormat::AUTO;
+		//1 - single thread, 0 - all hardware threads
+		size_t threads = 1;
+		//Add the opposite of every edge, as Graph::addEdge does. Symmetric MatrixMarket files are always mirrored
+		bool symmetric = false;
+	};
+
+	namespace detail {
+
+		inline bool is_blank(char symbol) {
+			return symbol == ' ' || symbol == '\t' || symbol == '\r';
+		}
+		inline void skip_blanks(const char*& position, const char* end) {
+			while (position < end && is_blank(*position)) {
+				++position;
+			}
+		}
+		//Reads one number that must end at a blank or at the end of the line
+		template <typename VALUE>
+		bool parse_value(const char*& position, const char* end, VALUE& value) {
+			skip_blanks(position, end);
+			if (position < end && *position == '+') {
+				++position;
+			}
+			auto [next, error] = std::from_chars(position, end, value);
+			if (error != std::errc() || (next < end && !is_blank(*next))) {
+				return false;
+			}
+			position = next;
+			return true;
+		}
+		inline bool at_line_end(const char*& position, const char* end) {
+			skip_blanks(position, end);
+			return position == end;
+		}
+		inline const char* line_end(const char* position, const char* end) {
+			const char* found = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+			return found == nullptr ? end : found;
+		}
+		inline bool equal_ignore_case(std::string_view first, std::string_view second) {
+			if (first.size() != second.size()) {
+				return false;
+			}
+			for (size_t i = 0; i < first.size(); ++i) {
+				char a = first[i] >= 'A' && first[i] <= 'Z' ? char(first[i] - 'A' + 'a') : first[i];
+				char b = second[i] >= 'A' && second[i] <= 'Z' ? char(second[i] - 'A' + 'a') : second[i];
+				if (a != b) {
+					return false;
+				}
+			}
+			return true;
+		}
+		inline std::string_view next_word(const char*& position, const char* end) {
+			skip_blanks(position, end);
+			const char* begin = position;
+			while (position < end && !is_blank(*position)) {
+				++position;
+			}
+			return std::string_view(begin, static_cast<size_t>(position - begin));
+		}
+
+		//What the header of the file says about the edge lines that follow it
+		struct TextGraphHeader {
+			TextGraphFormat format = TextGraphFormat::EDGE_LIST;
+			//Offset of the first edge line and the amount of lines before it
+			size_t data_begin = 0;
+			size_t lines = 0;
+			//0 when the amount of nodes comes from the largest id
+			std::uint64_t amount_nodes = 0;
+			//Expected amount of edge lines, only for MatrixMarket
+			std::uint64_t amount_entries = 0;
+			bool has_weights = true;
+			bool mirror = false;
+			//Ids in the file start from 1
+			bool one_based = false;
+		};
+
+		struct TextParseError {
+			size_t line = 0;
+			std::string message;
+		};
+
+		inline TextGraphHeader parse_text_header(std::string_view text, TextGraphFormat format) {
+			TextGraphHeader header;
+			const char* begin = text.data();
+			const char* end = text.data() + text.size();
+			const char* position = begin;
+			auto fail = [&header](const std::string& message) {
+				return ParseException("line " + std::to_string(header.lines) + ": " + message);
+			};
+
+			if (format == TextGraphFormat::AUTO) {
+				const char* first = position;
+				while (first < end && (is_blank(*first) || *first == '\n')) {
+					++first;
+				}
+				std::string_view rest(first, static_cast<size_t>(end - first));
+				if (rest.starts_with("%%MatrixMarket")) {
+					format = TextGraphFormat::MATRIX_MARKET;
+				}
+				else if (rest.size() >= 2 && (rest[0] == 'c' || rest[0] == 'p') && (is_blank(rest[1]) || rest[1] == '\n')) {
+					format = TextGraphFormat::DIMACS;
+				}
+				else {
+					format = TextGraphFormat::EDGE_LIST;
+				}
+			}
+			header.format = format;
+
+			if (format == TextGraphFormat::MATRIX_MARKET) {
+				header.one_based = true;
+				const char* finish = line_end(position, end);
+				++header.lines;
+				std::string_view banner = next_word(position, finish);
+				std::string_view object = next_word(position, finish);
+				std::string_view layout = next_word(position, finish);
+				std::string_view field = next_word(position, finish);
+				std::string_view symmetry = next_word(position, finish);
+				if (!equal_ignore_case(banner, "%%MatrixMarket") || !equal_ignore_case(object, "matrix") || !equal_ignore_case(layout, "coordinate")) {
+					throw fail("Expected a \"%%MatrixMarket matrix coordinate\" banner");
+				}
+				if (equal_ignore_case(field, "pattern")) {
+					header.has_weights = false;
+				}
+				else if (!equal_ignore_case(field, "real") && !equal_ignore_case(field, "integer") && !equal_ignore_case(field, "double")) {
+					throw fail("Unsupported MatrixMarket field \"" + std::string(field) + "\"");
+				}
+				if (equal_ignore_case(symmetry, "symmetric")) {
+					header.mirror = true;
+				}
+				else if (!equal_ignore_case(symmetry, "general")) {
+					throw fail("Unsupported MatrixMarket symmetry \"" + std::string(symmetry) + "\"");
+				}
+				position = finish == end ? end : finish + 1;
+
+				//Comments, then the size line
+				while (true) {
+					if (position == end) {
+						throw fail("Missing MatrixMarket size line");
+					}
+					finish = line_end(position, end);
+					++header.lines;
+					const char* word = position;
+					position = finish == end ? end : finish + 1;
+					if (at_line_end(word, finish) || *word == '%') {
+						continue;
+					}
+					std::uint64_t rows = 0;
+					std::uint64_t columns = 0;
+					if (!parse_value(word, finish, rows) || !parse_value(word, finish, columns) ||
+						!parse_value(word, finish, header.amount_entries) || !at_line_end(word, finish)) {
+						throw fail("Malformed MatrixMarket size line");
+					}
+					header.amount_nodes = std::max(rows, columns);
+					break;
+				}
+			}
+			else if (format == TextGraphFormat::DIMACS) {
+				header.one_based = true;
+				//Comments, then the problem line
+				while (true) {
+					if (position == end) {
+						throw fail("Missing DIMACS problem line");
+					}
+					const char* finish = line_end(position, end);
+					++header.lines;
+					const char* word = position;
+					position = finish == end ? end : finish + 1;
+					if (at_line_end(word, finish) || *word == 'c') {
+						continue;
+					}
+					std::uint64_t amount_arcs = 0;
+					if (next_word(word, finish) != "p" || next_word(word, finish).empty() ||
+						!parse_value(word, finish, header.amount_nodes) || !parse_value(word, finish, amount_arcs) || !at_line_end(word, finish)) {
+						throw fail("Expected a DIMACS problem line \"p sp nodes arcs\"");
+					}
+					break;
+				}
+			}
+			header.data_begin = static_cast<size_t>(position - begin);
+			if (header.amount_nodes > std::numeric_limits<std::uint32_t>::max()) {
+				throw fail("Too many nodes");
+			}
+			return header;
+		}
+
+		template <typename WEIGHT_TYPE>
+		struct TextChunk {
+			std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+			size_t lines = 0;
+			std::uint64_t max_id = 0;
+			bool failed = false;
+			TextParseError error;
+		};
+
+		//Parses the edge lines of [begin, end), which starts at a line start and ends after a line end.
+		//Stops at the first malformed line
+		template <typename WEIGHT_TYPE>
+		void parse_text_chunk(const char* begin, const char* end, const TextGraphHeader& header, TextChunk<WEIGHT_TYPE>& chunk) {
+			const std::uint64_t base = header.one_based ? 1 : 0;
+			const std::uint64_t limit = header.amount_nodes != 0 ? header.amount_nodes : std::numeric_limits<std::uint32_t>::max();
+			auto fail = [&chunk](const char* message) {
+				chunk.failed = true;
+				chunk.error.line = chunk.lines;
+				chunk.error.message = message;
+			};
+
+			for (const char* position = begin; position < end; ) {
+				const char* finish = line_end(position, end);
+				++chunk.lines;
+				const char* word = position;
+				position = finish == end ? end : finish + 1;
+				if (at_line_end(word, finish)) {
+					continue;
+				}
+				if (header.format == TextGraphFormat::DIMACS) {
+					if (*word == 'c') {
+						continue;
+					}
+					if (*word != 'a' || word + 1 == finish || !is_blank(word[1])) {
+						return fail("Expected an arc line \"a from to weight\"");
+					}
+					++word;
+				}
+				else if (*word == '%' || (*word == '#' && header.format == TextGraphFormat::EDGE_LIST)) {
+					continue;
+				}
+
+				std::uint64_t from = 0;
+				std::uint64_t to = 0;
+				WEIGHT_TYPE weight = WEIGHT_TYPE(1);
+				if (!parse_value(word, finish, from) || !parse_value(word, finish, to)) {
+					return fail("Expected two node ids");
+				}
+				if (header.has_weights && !(header.format == TextGraphFormat::EDGE_LIST && at_line_end(word, finish)) &&
+					!parse_value(word, finish, weight)) {
+					return fail("Malformed edge weight");
+				}
+				if (!at_line_end(word, finish)) {
+					return fail("Unexpected text after the edge");
+				}
+				if (from < base || to < base || from - base >= limit || to - base >= limit) {
+					return fail("Node id out of range");
+				}
+				from -= base;
+				to -= base;
+				chunk.max_id = std::max(chunk.max_id, std::max(from, to));
+				chunk.edges.push_back({ static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight });
+			}
+		}
+	}
+
+	//Parses a text graph held in memory. Lines are split into chunks at line boundaries and the chunks
+	//are parsed by separate threads with std::from_chars; edges go into the CSR arrays in one bulk pass.
+	//Node data is the node index when T is an integer type and T() otherwise.
+	//Throws ParseException with the line number of the first malformed line
+	template <typename T, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> parseTextGraph(std::string_view text, const TextReadOptions& options = TextReadOptions()) {
+		static_assert(std::is_arithmetic_v<WEIGHT_TYPE>, "Text graphs need an arithmetic weight type");
+		detail::TextGraphHeader header = detail::parse_text_header(text, options.format);
+		const char* data = text.data() + header.data_begin;
+		const size_t size = text.size() - header.data_begin;
+		const size_t threads = resolve_threads(options.threads);
+
+		//Several chunks per thread even out lines of different length
+		constexpr size_t MIN_CHUNK = 1 << 20;
+		size_t amount_chunks = threads == 1 ? 1 : std::max<size_t>(1, std::min(threads * 8, size / MIN_CHUNK));
+		std::vector<size_t> bounds(amount_chunks + 1, size);
+		bounds[0] = 0;
+		for (size_t c = 1; c < amount_chunks; ++c) {
+			size_t bound = std::max(bounds[c - 1], size * c / amount_chunks);
+			if (bound > 0 && bound < size && data[bound - 1] != '\n') {
+				bound = static_cast<size_t>(detail::line_end(data + bound, data + size) - data);
+				bound = std::min(size, bound + 1);
+			}
+			bounds[c] = bound;
+		}
+
+		std::vector<detail::TextChunk<WEIGHT_TYPE>> chunks(amount_chunks);
+		parallel_for(threads, amount_chunks, [&](size_t, size_t begin, size_t end) {
+			for (size_t c = begin; c < end; ++c) {
+				size_t expected = (bounds[c + 1] - bounds[c]) / 16;
+				chunks[c].edges.reserve(expected);
+				detail::parse_text_chunk(data + bounds[c], data + bounds[c + 1], header, chunks[c]);
+			}
+			});
+
+		size_t line = header.lines;
+		std::uint64_t amount_edges = 0;
+		std::uint64_t max_id = 0;
+		bool any_edge = false;
+		for (const auto& chunk : chunks) {
+			if (chunk.failed) {
+				throw ParseException("line " + std::to_string(line + chunk.error.line) + ": " + chunk.error.message);
+			}
+			line += chunk.lines;
+			amount_edges += chunk.edges.size();
+			max_id = std::max(max_id, chunk.max_id);
+			any_edge = any_edge || !chunk.edges.empty();
+		}
+		if (header.format == TextGraphFormat::MATRIX_MARKET && amount_edges != header.amount_entries) {
+			throw ParseException("Expected " + std::to_string(header.amount_entries) + " MatrixMarket entries, found " + std::to_string(amount_edges));
+		}
+
+		size_t amount_nodes = header.amount_nodes != 0 ? static_cast<size_t>(header.amount_nodes) : (any_edge ? static_cast<size_t>(max_id) + 1 : 0);
+		std::vector<std::vector<EdgeRecord<WEIGHT_TYPE>>> batches;
+		batches.reserve(chunks.size());
+		for (auto& chunk : chunks) {
+			batches.push_back(std::move(chunk.edges));
+		}
+		GraphBuilderOptions build_options;
+		build_options.threads = threads;
+		build_options.symmetric = header.mirror || options.symmetric;
+		return buildCompactGraph<T, WEIGHT_TYPE>(amount_nodes, batches, {}, build_options);
+	}
+
+	//Reads a text graph (edge list, DIMACS or MatrixMarket) through a memory mapping of the file, see parseTextGraph
+	template <typename T, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> readTextGraph(const std::string& path, const TextReadOptions& options = TextReadOptions()) {
+		MappedFile file(path);
+		file.prefetch();
+		try {
+			return parseTextGraph<T, WEIGHT_TYPE>(std::string_view(file.data(), file.size()), options);
+		}
+		catch (const ParseException& error) {
+			throw ParseException(path + ": " + error.what());
+		}
+	}
+}
@@ -1 +1,106 @@
+#pragma once
+#include "binary_format.hpp"
+#include "../graph_core/graph.hpp"
+#include "../graph_core/compact_graph.hpp"
+#include "../exceptions.hpp"
+#include <cstdio>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <filesystem>
+#include <system_error>
+#include <type_traits>
 
+namespace graph_library {
+
+	namespace detail {
+
+		//Sequential binary output through a FILE buffer, closes the file on destruction
+		class BinaryOutputFile {
+		private:
+			std::FILE* file = nullptr;
+			std::string path;
+			std::uint64_t position = 0;
+		public:
+			explicit BinaryOutputFile(const std::string& _path) : path(_path) {
+				file = std::fopen(path.c_str(), "wb");
+				if (file == nullptr) {
+					throw FileWriteException("Cannot open file for writing: " + path);
+				}
+				std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+			}
+			BinaryOutputFile(const BinaryOutputFile&) = delete;
+			BinaryOutputFile& operator=(const BinaryOutputFile&) = delete;
+			~BinaryOutputFile() {
+				if (file != nullptr) {
+					std::fclose(file);
+				}
+			}
+
+			void write(const void* data, size_t size) {
+				if (size != 0 && std::fwrite(data, 1, size, file) != size) {
+					throw FileWriteException("Cannot write to file: " + path);
+				}
+				position += size;
+			}
+			//Writes zero bytes up to the position
+			void padTo(std::uint64_t target) {
+				static const char zeros[BINARY_GRAPH_ALIGNMENT] = {};
+				while (position < target) {
+					write(zeros, static_cast<size_t>(std::min<std::uint64_t>(target - position, sizeof(zeros))));
+				}
+			}
+			void close() {
+				int flushed = std::fflush(file);
+				int closed = std::fclose(file);
+				file = nullptr;
+				if (flushed != 0 || closed != 0) {
+					throw FileWriteException("Cannot write to file: " + path);
+				}
+			}
+		};
+	}
+
+	//Writes the graph in the binary format of binary_format.hpp. Node data is stored only for trivially
+	//copyable T. The file is written next to path and renamed at the end, so readers never see a partial file
+	template <typename T, typename WEIGHT_TYPE>
+	void writeBinaryGraph(const std::string& path, const CompactGraph<T, WEIGHT_TYPE>& graph) {
+		static_assert(std::is_trivially_copyable_v<WEIGHT_TYPE>, "Edge weights must be trivially copyable");
+		BinaryGraphHeader header = make_binary_graph_header<T, WEIGHT_TYPE>(graph.getAmountNodes(), graph.getAmountEdge());
+
+		std::string temporary = path + ".tmp";
+		try {
+			detail::BinaryOutputFile file(temporary);
+			file.write(&header, sizeof(header));
+			file.padTo(header.offsets_position);
+			file.write(graph.getOffsets().data(), graph.getOffsets().size() * sizeof(std::uint64_t));
+			file.padTo(header.targets_position);
+			file.write(graph.getTargets().data(), graph.getTargets().size() * sizeof(std::uint32_t));
+			file.padTo(header.weights_position);
+			file.write(graph.getWeights().data(), graph.getWeights().size() * sizeof(WEIGHT_TYPE));
+			file.padTo(header.node_data_position);
+			if constexpr (std::is_trivially_copyable_v<T>) {
+				file.write(graph.getNodesData().data(), graph.getNodesData().size() * sizeof(T));
+			}
+			file.close();
+		}
+		catch (...) {
+			std::error_code ignored;
+			std::filesystem::remove(temporary, ignored);
+			throw;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, path, error);
+		if (error) {
+			std::filesystem::remove(temporary, error);
+			throw FileWriteException("Cannot replace file: " + path);
+		}
+	}
+
+	template <typename T, typename WEIGHT_TYPE, typename ALLOCATOR>
+	void writeBinaryGraph(const std::string& path, const Graph<T, WEIGHT_TYPE, ALLOCATOR>& graph) {
+		writeBinaryGraph(path, graph.freeze());
+	}
+}
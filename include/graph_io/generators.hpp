@@ -0,0 +1,242 @@
+#pragma once
+#include "../graph_core/compact_graph.hpp"
+#include "../graph_core/edge_record.hpp"
+#include "../graph_core/graph_builder.hpp"
+#include "../exceptions.hpp"
+#include <vector>
+#include <span>
+#include <limits>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph_library {
+
+	//Random numbers from a seed that are the same with every compiler and standard library,
+	//unlike the std distributions. SplitMix64 with integer-only bounded draws
+	class GeneratorRandom {
+	private:
+		std::uint64_t state;
+
+		//High 64 bits of a 64 x 64 bit product
+		static std::uint64_t multiply_high(std::uint64_t a, std::uint64_t b) {
+			std::uint64_t a_low = a & 0xFFFFFFFFu;
+			std::uint64_t a_high = a >> 32;
+			std::uint64_t b_low = b & 0xFFFFFFFFu;
+			std::uint64_t b_high = b >> 32;
+			std::uint64_t low_low = a_low * b_low;
+			std::uint64_t high_low = a_high * b_low;
+			std::uint64_t low_high = a_low * b_high;
+			std::uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + (low_high & 0xFFFFFFFFu);
+			return a_high * b_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+		}
+	public:
+		explicit GeneratorRandom(std::uint64_t seed) : state(seed) {}
+
+		std::uint64_t next() {
+			std::uint64_t result = (state += 0x9E3779B97F4A7C15ull);
+			result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+			result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+			return result ^ (result >> 31);
+		}
+		//Uniform in [0, bound), the bias is below bound / 2^64
+		std::uint64_t below(std::uint64_t bound) {
+			return multiply_high(next(), bound);
+		}
+		//Uniform in [0, 1) with 53 random bits, exact in every floating point implementation
+		double uniform() {
+			return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+		}
+	};
+
+	struct GeneratorOptions {
+		std::uint64_t seed = 1;
+		//Weights are uniform in [min_weight, max_weight], integers for an integer WEIGHT_TYPE
+		double min_weight = 1;
+		double max_weight = 1;
+		//Store every edge in both directions, as Graph::addEdge does
+		bool symmetric = true;
+		//Keep one edge of every pair of nodes (the lightest), the random models may draw a pair twice
+		bool remove_duplicates = true;
+		//Threads for building the graph; the edges are drawn serially, so they do not depend on it
+		size_t threads = 1;
+	};
+
+	//Parameters of the recursive matrix (R-MAT) model, the probabilities of the four quadrants.
+	//The defaults are the Graph500 ones, d = 1 - a - b - c
+	struct RmatParameters {
+		double a = 0.57;
+		double b = 0.19;
+		double c = 0.19;
+	};
+
+	namespace detail {
+
+		template <typename WEIGHT_TYPE>
+		WEIGHT_TYPE random_weight(GeneratorRandom& random, const GeneratorOptions& options) {
+			if (options.min_weight >= options.max_weight) {
+				return static_cast<WEIGHT_TYPE>(options.min_weight);
+			}
+			if constexpr (std::is_integral_v<WEIGHT_TYPE>) {
+				auto low = static_cast<std::int64_t>(options.min_weight);
+				auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(options.max_weight) - low) + 1;
+				return static_cast<WEIGHT_TYPE>(low + static_cast<std::int64_t>(random.below(range)));
+			}
+			else {
+				return static_cast<WEIGHT_TYPE>(options.min_weight + random.uniform() * (options.max_weight - options.min_weight));
+			}
+		}
+
+		template <typename WEIGHT_TYPE>
+		EdgeRecord<WEIGHT_TYPE> make_generated_edge(size_t from, size_t to, GeneratorRandom& random, const GeneratorOptions& options) {
+			return EdgeRecord<WEIGHT_TYPE>{ static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to),
+				random_weight<WEIGHT_TYPE>(random, options) };
+		}
+
+		inline void check_generated_size(size_t amount_nodes) {
+			if (amount_nodes >= std::numeric_limits<std::uint32_t>::max()) {
+				throw GraphException("Too many nodes for a generated graph");
+			}
+		}
+	}
+
+	//Erdős–Rényi G(n, m): amount_edges edges between uniformly random pairs of distinct nodes
+	template <typename WEIGHT_TYPE = int>
+	std::vector<EdgeRecord<WEIGHT_TYPE>> erdosRenyiEdges(size_t amount_nodes, size_t amount_edges, const GeneratorOptions& options = GeneratorOptions()) {
+		detail::check_generated_size(amount_nodes);
+		std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+		if (amount_nodes < 2) {
+			return edges;
+		}
+		GeneratorRandom random(options.seed);
+		edges.reserve(amount_edges);
+		while (edges.size() < amount_edges) {
+			size_t from = random.below(amount_nodes);
+			size_t to = random.below(amount_nodes);
+			if (from != to) {
+				edges.push_back(detail::make_generated_edge<WEIGHT_TYPE>(from, to, random, options));
+			}
+		}
+		return edges;
+	}
+
+	//R-MAT / stochastic Kronecker graph with 2^scale nodes and edge_factor * 2^scale edges: every edge
+	//descends scale times into one of the four quadrants of the adjacency matrix. Degrees follow a power law.
+	//Self-loops are skipped
+	template <typename WEIGHT_TYPE = int>
+	std::vector<EdgeRecord<WEIGHT_TYPE>> rmatEdges(size_t scale, size_t edge_factor, const GeneratorOptions& options = GeneratorOptions(),
+		const RmatParameters& parameters = RmatParameters())
+	{
+		if (scale >= 32) {
+			throw GraphException("R-MAT scale must be below 32");
+		}
+		size_t amount_nodes = size_t(1) << scale;
+		detail::check_generated_size(amount_nodes);
+		GeneratorRandom random(options.seed);
+		std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+		edges.reserve(edge_factor * amount_nodes);
+		const double ab = parameters.a + parameters.b;
+		const double abc = ab + parameters.c;
+		for (size_t i = 0; i < edge_factor * amount_nodes; ++i) {
+			size_t from = 0;
+			size_t to = 0;
+			for (size_t bit = 0; bit < scale; ++bit) {
+				double p = random.uniform();
+				from <<= 1;
+				to <<= 1;
+				if (p < parameters.a) {
+				}
+				else if (p < ab) {
+					to |= 1;
+				}
+				else if (p < abc) {
+					from |= 1;
+				}
+				else {
+					from |= 1;
+					to |= 1;
+				}
+			}
+			if (from != to) {
+				edges.push_back(detail::make_generated_edge<WEIGHT_TYPE>(from, to, random, options));
+			}
+		}
+		return edges;
+	}
+
+	//rows x columns grid, every node is joined to its right and lower neighbour. Node r * columns + c is at row r, column c
+	template <typename WEIGHT_TYPE = int>
+	std::vector<EdgeRecord<WEIGHT_TYPE>> gridEdges(size_t rows, size_t columns, const GeneratorOptions& options = GeneratorOptions()) {
+		detail::check_generated_size(rows * columns);
+		GeneratorRandom random(options.seed);
+		std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+		edges.reserve(2 * rows * columns);
+		for (size_t r = 0; r < rows; ++r) {
+			for (size_t c = 0; c < columns; ++c) {
+				size_t node = r * columns + c;
+				if (c + 1 < columns) {
+					edges.push_back(detail::make_generated_edge<WEIGHT_TYPE>(node, node + 1, random, options));
+				}
+				if (r + 1 < rows) {
+					edges.push_back(detail::make_generated_edge<WEIGHT_TYPE>(node, node + columns, random, options));
+				}
+			}
+		}
+		return edges;
+	}
+
+	//Barabási–Albert preferential attachment: every new node joins edges_per_node earlier nodes chosen with
+	//probability proportional to their degree. Linear time by drawing from the list of edge ends
+	//(Batagelj and Brandes); the rare self-loops are skipped
+	template <typename WEIGHT_TYPE = int>
+	std::vector<EdgeRecord<WEIGHT_TYPE>> barabasiAlbertEdges(size_t amount_nodes, size_t edges_per_node, const GeneratorOptions& options = GeneratorOptions()) {
+		detail::check_generated_size(amount_nodes);
+		GeneratorRandom random(options.seed);
+		std::vector<std::uint32_t> ends(2 * amount_nodes * edges_per_node);
+		std::vector<EdgeRecord<WEIGHT_TYPE>> edges;
+		edges.reserve(amount_nodes * edges_per_node);
+		for (size_t node = 0; node < amount_nodes; ++node) {
+			for (size_t k = 0; k < edges_per_node; ++k) {
+				size_t position = 2 * (node * edges_per_node + k);
+				ends[position] = static_cast<std::uint32_t>(node);
+				ends[position + 1] = ends[random.below(position + 1)];
+				if (ends[position + 1] != node) {
+					edges.push_back(detail::make_generated_edge<WEIGHT_TYPE>(node, ends[position + 1], random, options));
+				}
+			}
+		}
+		return edges;
+	}
+
+	//CompactGraph from generated edges with the options of the generator. Integral T gets the node index as data
+	template <typename T = std::uint32_t, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> buildGeneratedGraph(size_t amount_nodes, const std::vector<EdgeRecord<WEIGHT_TYPE>>& edges,
+		const GeneratorOptions& options = GeneratorOptions())
+	{
+		GraphBuilderOptions build_options;
+		build_options.threads = options.threads;
+		build_options.symmetric = options.symmetric;
+		build_options.remove_self_loops = true;
+		build_options.remove_duplicates = options.remove_duplicates;
+		return buildCompactGraph<T, WEIGHT_TYPE>(amount_nodes, std::span<const std::vector<EdgeRecord<WEIGHT_TYPE>>>(&edges, 1), {}, build_options);
+	}
+
+	template <typename T = std::uint32_t, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> generateErdosRenyi(size_t amount_nodes, size_t amount_edges, const GeneratorOptions& options = GeneratorOptions()) {
+		return buildGeneratedGraph<T, WEIGHT_TYPE>(amount_nodes, erdosRenyiEdges<WEIGHT_TYPE>(amount_nodes, amount_edges, options), options);
+	}
+	template <typename T = std::uint32_t, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> generateRmat(size_t scale, size_t edge_factor, const GeneratorOptions& options = GeneratorOptions(),
+		const RmatParameters& parameters = RmatParameters())
+	{
+		return buildGeneratedGraph<T, WEIGHT_TYPE>(size_t(1) << scale, rmatEdges<WEIGHT_TYPE>(scale, edge_factor, options, parameters), options);
+	}
+	template <typename T = std::uint32_t, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> generateGrid(size_t rows, size_t columns, const GeneratorOptions& options = GeneratorOptions()) {
+		return buildGeneratedGraph<T, WEIGHT_TYPE>(rows * columns, gridEdges<WEIGHT_TYPE>(rows, columns, options), options);
+	}
+	template <typename T = std::uint32_t, typename WEIGHT_TYPE = int>
+	CompactGraph<T, WEIGHT_TYPE> generateBarabasiAlbert(size_t amount_nodes, size_t edges_per_node, const GeneratorOptions& options = GeneratorOptions()) {
+		return buildGeneratedGraph<T, WEIGHT_TYPE>(amount_nodes, barabasiAlbertEdges<WEIGHT_TYPE>(amount_nodes, edges_per_node, options), options);
+	}
+}
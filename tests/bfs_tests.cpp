@@ -0,0 +1,105 @@
+//Parallel direction-optimizing bfs against the serial search: symmetric graphs with bottom-up steps forced
+//and by the default heuristic, directed graphs (top-down only) and the early exit at a target
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "test_support.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+	using graph_library::BFS_UNREACHED;
+
+	//Every reached node other than the source has a parent one step closer with an edge to it
+	template <typename GRAPH>
+	bool parents_valid(const GRAPH& graph, size_t source, const graph_library::BfsResult& result) {
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			if (result.distance[i] == BFS_UNREACHED) {
+				if (result.parent[i] != BFS_UNREACHED) {
+					return false;
+				}
+				continue;
+			}
+			if (i == source) {
+				if (result.parent[i] != source || result.distance[i] != 0) {
+					return false;
+				}
+				continue;
+			}
+			size_t parent = result.parent[i];
+			if (parent == BFS_UNREACHED || result.distance[parent] + 1 != result.distance[i]) {
+				return false;
+			}
+			bool edge = false;
+			for (const auto& out : graph.outEdges(parent)) {
+				edge |= out.get_to_index() == i;
+			}
+			if (!edge) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename GRAPH>
+	void check_searches(const GRAPH& graph, size_t source, bool symmetric, std::mt19937_64& rng) {
+		auto expected = graph_library::bfs(graph, source);
+		for (size_t threads : { size_t(2), size_t(4) }) {
+			//Default switching, and switching to bottom-up at once and staying there
+			for (bool eager : { false, true }) {
+				graph_library::BfsOptions options;
+				options.threads = threads;
+				options.symmetric = symmetric;
+				if (eager) {
+					options.alpha = 1 << 30;
+					options.beta = 1 << 30;
+				}
+				auto result = graph_library::bfs(graph, source, options);
+				CHECK(result.distance == expected.distance);
+				CHECK(parents_valid(graph, source, result));
+
+				//With a target the target and every node found on the way have their true distance
+				options.target = rng() % graph.getAmountNodes();
+				auto early = graph_library::bfs(graph, source, options);
+				CHECK(early.distance[options.target] == expected.distance[options.target]);
+				bool reached_correctly = true;
+				for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+					reached_correctly &= early.distance[i] == BFS_UNREACHED || early.distance[i] == expected.distance[i];
+				}
+				CHECK(reached_correctly);
+				CHECK(parents_valid(graph, source, early));
+			}
+		}
+		//The serial search stops at the target too
+		graph_library::BfsOptions serial;
+		serial.target = rng() % graph.getAmountNodes();
+		CHECK(graph_library::bfs(graph, source, serial).distance[serial.target] == expected.distance[serial.target]);
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 40; ++trial) {
+			//Sparse graphs with several components and dense ones where bottom-up pays off
+			size_t amount_nodes = 1 + rng() % 3000;
+			size_t amount_edges = amount_nodes * (trial % 2 == 0 ? 1 : 12);
+			Graph<int> undirected(amount_nodes);
+			DirectedGraph<int> directed(amount_nodes);
+			for (size_t i = 0; i < amount_edges; ++i) {
+				size_t from = rng() % amount_nodes;
+				size_t to = rng() % amount_nodes;
+				undirected.addEdge(from, to, 1);
+				directed.addEdge(from, to, 1);
+			}
+			size_t source = rng() % amount_nodes;
+			check_searches(undirected, source, true, rng);
+			check_searches(undirected.freeze(), source, true, rng);
+			check_searches(directed, source, false, rng);
+			check_searches(directed.freeze(), source, false, rng);
+		}
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(4);
+	test_random(rng);
+	return graph_library::test::result();
+}
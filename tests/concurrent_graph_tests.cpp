@@ -0,0 +1,136 @@
+//ConcurrentGraph under concurrent readers and writers: every version a reader sees is complete, snapshots stay
+//valid after the view is gone, a failed update publishes nothing and replaced versions are freed
+#include "graph_core/graph.hpp"
+#include "graph_core/concurrent_graph.hpp"
+#include "test_support.hpp"
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	constexpr size_t AMOUNT_NODES = 1000;
+	constexpr size_t WRITERS = 2;
+	constexpr size_t BATCHES_PER_WRITER = 500;
+	constexpr size_t READERS = 3;
+	//Undirected edges added by every batch besides the edge 1 -> 2
+	constexpr size_t ADDED = 4;
+
+	//After v batches node 1 has v edges and node 0 none, a reader seeing anything else saw part of a batch
+	GraphUpdateBatch<int> make_batch(std::mt19937_64& rng) {
+		std::uniform_int_distribution<size_t> node(2, AMOUNT_NODES - 1);
+		GraphUpdateBatch<int> batch;
+		for (size_t i = 0; i < ADDED; ++i) {
+			//A self-loop is stored once and would break the edge count
+			size_t first = node(rng);
+			size_t second = node(rng);
+			while (second == first) {
+				second = node(rng);
+			}
+			batch.addEdge(first, second, 1);
+			batch.setEdgeWeight(first, second, static_cast<int>(rng() % 100));
+		}
+		batch.addEdgeOriented(1, 2, 1);
+		batch.addEdge(0, 1, 1);
+		batch.removeEdge(0, 1);
+		return batch;
+	}
+
+	bool consistent(const CowGraph<int>& graph, std::uint64_t version) {
+		return graph.degree(0) == 0 && graph.degree(1) == version && graph.getAmountEdge() == (2 * ADDED + 1) * version;
+	}
+
+	void test_readers_and_writers() {
+		CowGraph<int> initial;
+		for (size_t i = 0; i < AMOUNT_NODES; ++i) {
+			initial.addNode(static_cast<int>(i));
+		}
+		ConcurrentGraph<int> graph(initial);
+		std::atomic<size_t> writers_done{ 0 };
+		std::atomic<size_t> reads{ 0 };
+		std::atomic<size_t> errors{ 0 };
+
+		std::vector<std::thread> threads;
+		for (size_t r = 0; r < READERS; ++r) {
+			threads.emplace_back([&, r] {
+				std::vector<std::pair<CowGraph<int>, std::uint64_t>> snapshots;
+				//At least a few reads even if the writers finish first
+				for (size_t i = 0; writers_done.load() != WRITERS || i < 100; ++i) {
+					auto view = graph.read();
+					if (!consistent(view.graph(), view.versionNumber())) {
+						++errors;
+					}
+					if (i % 64 == r) {
+						snapshots.emplace_back(view.snapshot(), view.versionNumber());
+					}
+					++reads;
+				}
+				for (const auto& [snapshot, version] : snapshots) {
+					if (!consistent(snapshot, version)) {
+						++errors;
+					}
+				}
+				});
+		}
+		for (size_t w = 0; w < WRITERS; ++w) {
+			threads.emplace_back([&, w] {
+				std::mt19937_64 rng(100 + w);
+				for (size_t b = 0; b < BATCHES_PER_WRITER; ++b) {
+					graph.apply(make_batch(rng));
+				}
+				++writers_done;
+				});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		CHECK(errors.load() == 0);
+		CHECK(reads.load() >= READERS * 100);
+		CHECK(graph.versionNumber() == WRITERS * BATCHES_PER_WRITER);
+		CHECK(consistent(graph.read().graph(), WRITERS * BATCHES_PER_WRITER));
+		//Without readers every replaced version can be freed
+		graph.reclaim();
+		CHECK(graph.retiredVersions() == 0);
+	}
+
+	void test_failed_update() {
+		CowGraph<int> initial;
+		initial.addNode(0);
+		initial.addNode(1);
+		ConcurrentGraph<int> graph(initial);
+		bool thrown = false;
+		try {
+			graph.update([](CowGraph<int>& copy) {
+				copy.addEdge(0, 1, 1);
+				throw std::runtime_error("change failed");
+				});
+		}
+		catch (const std::runtime_error&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+		CHECK(graph.versionNumber() == 0);
+		CHECK(graph.read()->getAmountEdge() == 0);
+		CHECK(!initial.hasEdgeOriented(0, 1));
+
+		//A view keeps its version while newer ones are published and replaced
+		auto view = graph.read();
+		GraphUpdateBatch<int> batch;
+		batch.addEdge(0, 1, 1);
+		graph.apply(batch);
+		graph.apply(batch);
+		graph.reclaim();
+		CHECK(view.versionNumber() == 0);
+		CHECK(view->getAmountEdge() == 0);
+		CHECK(graph.read()->getAmountEdge() == 4);
+	}
+}
+
+int main() {
+	test_readers_and_writers();
+	test_failed_update();
+	return graph_library::test::result();
+}
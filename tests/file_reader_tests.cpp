@@ -0,0 +1,274 @@
+//Binary graph files: a written graph reads back the same, corrupt files (truncated, bad magic or version,
+//bad offsets, bad targets) throw ParseException and indices out of range throw InvalidIndexException.
+//Text graphs: edge lists, DIMACS and symmetric MatrixMarket with CRLF line ends and without a final newline,
+//the line numbers of parse errors and the same graph from one thread and from several chunks
+#include "graph_core/compact_graph.hpp"
+#include "graph_io/file_reader.hpp"
+#include "graph_io/file_writer.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+	using graph_library::BinaryGraphHeader;
+
+	std::string temp_path(const std::string& name) {
+		return (std::filesystem::temp_directory_path() / ("file_reader_tests_" + name)).string();
+	}
+
+	std::vector<char> read_bytes(const std::string& path) {
+		std::ifstream input(path, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+	void write_bytes(const std::string& path, const std::vector<char>& bytes) {
+		std::ofstream output(path, std::ios::binary | std::ios::trunc);
+		output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	//Writes the bytes to a file of its own and tells whether opening it throws ParseException
+	bool rejected(const std::vector<char>& bytes, bool verify = true) {
+		std::string path = temp_path("corrupt.bin");
+		write_bytes(path, bytes);
+		bool thrown = false;
+		try {
+			auto graph = graph_library::readBinaryGraph<int, int>(path, verify);
+		}
+		catch (const graph_library::ParseException&) {
+			thrown = true;
+		}
+		std::filesystem::remove(path);
+		return thrown;
+	}
+
+	template <typename VALUE>
+	void patch(std::vector<char>& bytes, std::uint64_t position, VALUE value) {
+		std::memcpy(bytes.data() + position, &value, sizeof(value));
+	}
+
+	void test_binary_files() {
+		//0 -> 1, 0 -> 2, 1 -> 3, 3 -> 0
+		CompactGraph<int, int> graph({ 10, 11, 12, 13 }, { 0, 2, 3, 3, 4 }, { 1, 2, 3, 0 }, { 5, 6, 7, 8 });
+		std::string path = temp_path("graph.bin");
+		graph_library::writeBinaryGraph(path, graph);
+		std::vector<char> bytes = read_bytes(path);
+		{
+			auto mapped = graph_library::readBinaryGraph<int, int>(path);
+			CHECK(mapped.getAmountNodes() == 4 && mapped.getAmountEdge() == 4);
+			CHECK(mapped.degree(0) == 2 && mapped.degree(2) == 0);
+			CHECK(mapped.neighbors(1).size() == 1 && mapped.neighbors(1)[0] == 3 && mapped.weights(1)[0] == 7);
+			CHECK(mapped.getNodeData(3) == 13);
+			for (auto call : { 0, 1, 2, 3 }) {
+				bool thrown = false;
+				try {
+					switch (call) {
+					case 0:
+						mapped.degree(100);
+						break;
+					case 1:
+						mapped.neighbors(4);
+						break;
+					case 2:
+						mapped.weights(4);
+						break;
+					default:
+						mapped.outEdges(100);
+					}
+				}
+				catch (const graph_library::InvalidIndexException&) {
+					thrown = true;
+				}
+				CHECK(thrown);
+			}
+		}
+		std::filesystem::remove(path);
+
+		BinaryGraphHeader header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		CHECK(!rejected(bytes));
+
+		//Truncated in the header and in the sections
+		CHECK(rejected(std::vector<char>(bytes.begin(), bytes.begin() + 40)));
+		CHECK(rejected(std::vector<char>(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(header.targets_position) + 4)));
+		CHECK(rejected({}));
+
+		auto corrupt = bytes;
+		corrupt[0] = 'X';
+		CHECK(rejected(corrupt));
+		corrupt = bytes;
+		patch(corrupt, offsetof(BinaryGraphHeader, version), std::uint32_t(99));
+		CHECK(rejected(corrupt));
+		corrupt = bytes;
+		patch(corrupt, offsetof(BinaryGraphHeader, amount_edges), std::uint64_t(1) << 40);
+		CHECK(rejected(corrupt));
+
+		//Offsets that decrease, do not start at 0 or do not end at the amount of edges
+		corrupt = bytes;
+		patch(corrupt, header.offsets_position + 2 * sizeof(std::uint64_t), std::uint64_t(1));
+		CHECK(rejected(corrupt));
+		corrupt = bytes;
+		patch(corrupt, header.offsets_position, std::uint64_t(1));
+		CHECK(rejected(corrupt));
+		corrupt = bytes;
+		patch(corrupt, header.offsets_position + 4 * sizeof(std::uint64_t), std::uint64_t(3));
+		CHECK(rejected(corrupt));
+
+		//A target out of range is found by default and only read as it is with the explicit opt-out
+		corrupt = bytes;
+		patch(corrupt, header.targets_position + sizeof(std::uint32_t), std::uint32_t(1000000));
+		CHECK(rejected(corrupt));
+		CHECK(!rejected(corrupt, false));
+
+		//A file of another weight type
+		path = temp_path("graph.bin");
+		write_bytes(path, bytes);
+		bool thrown = false;
+		try {
+			auto mapped = graph_library::readBinaryGraph<int, double>(path);
+		}
+		catch (const graph_library::ParseException&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+		std::filesystem::remove(path);
+	}
+
+	using EdgeList = std::vector<std::tuple<size_t, size_t, int>>;
+
+	//Edges of every node in their stored order, or sorted
+	EdgeList edges_of(const CompactGraph<int, int>& graph, bool sorted = false) {
+		EdgeList result;
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			for (const auto& edge : graph.outEdges(i)) {
+				result.emplace_back(i, edge.get_to_index(), edge.get_weight());
+			}
+		}
+		if (sorted) {
+			std::sort(result.begin(), result.end());
+		}
+		return result;
+	}
+
+	//The line number of the ParseException, 0 if the text parses
+	size_t error_line(std::string_view text, const graph_library::TextReadOptions& options = graph_library::TextReadOptions()) {
+		try {
+			graph_library::parseTextGraph<int, int>(text, options);
+		}
+		catch (const graph_library::ParseException& error) {
+			std::string message = error.what();
+			size_t start = message.find("line ");
+			return start == std::string::npos ? 0 : std::stoul(message.substr(start + 5));
+		}
+		return 0;
+	}
+
+	void test_text_formats() {
+		const EdgeList triangle = { { 0, 1, 5 }, { 1, 2, 1 }, { 2, 0, 7 } };
+		auto edge_list = graph_library::parseTextGraph<int, int>("# comment\n0 1 5\n1 2\n\n% comment\n2 0 7\n");
+		CHECK(edge_list.getAmountNodes() == 3);
+		CHECK(edges_of(edge_list) == triangle);
+		auto crlf = graph_library::parseTextGraph<int, int>("0 1 5\r\n1 2\r\n\r\n2 0 7");
+		CHECK(edges_of(crlf) == triangle);
+
+		//Ids from 1, the amount of nodes from the problem line
+		auto dimacs = graph_library::parseTextGraph<int, int>("c road graph\r\np sp 4 3\r\na 1 2 5\r\nc between\r\na 2 3 1\r\na 3 1 7");
+		CHECK(dimacs.getAmountNodes() == 4);
+		CHECK(edges_of(dimacs) == triangle);
+
+		//The lower triangle is mirrored, the diagonal entry is stored once
+		auto matrix = graph_library::parseTextGraph<int, int>(
+			"%%MatrixMarket matrix coordinate integer symmetric\r\n% comment\r\n3 3 3\r\n1 1 4\r\n2 1 5\r\n3 2 6");
+		CHECK(matrix.getAmountNodes() == 3);
+		const EdgeList mirrored = { { 0, 0, 4 }, { 0, 1, 5 }, { 1, 0, 5 }, { 1, 2, 6 }, { 2, 1, 6 } };
+		CHECK(edges_of(matrix, true) == mirrored);
+
+		graph_library::TextReadOptions symmetric;
+		symmetric.symmetric = true;
+		auto mirrored_list = graph_library::parseTextGraph<int, int>("0 1 5\n1 1 2\n", symmetric);
+		CHECK(mirrored_list.getAmountEdge() == 3);
+
+		//Lines are counted from 1 through comments, blank lines and headers
+		CHECK(error_line("0 1\n1 2\nx y\n") == 3);
+		CHECK(error_line("0 1\r\n\r\n# comment\r\n1 2 3 4") == 4);
+		CHECK(error_line("c comment\np sp 3 2\na 1 2 1\na 1 9 1\n") == 4);
+		CHECK(error_line("%%MatrixMarket matrix coordinate integer general\n3 3 2\n1 2 1\n2 1 z\n") == 4);
+		CHECK(error_line("p sp 3\n") == 1);
+		//Fewer MatrixMarket entries than the size line says
+		bool thrown = false;
+		try {
+			graph_library::parseTextGraph<int, int>("%%MatrixMarket matrix coordinate integer general\n3 3 2\n1 2 1\n");
+		}
+		catch (const graph_library::ParseException&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+
+	//Input of several MiB is split into chunks with more than one thread
+	void test_text_chunks(std::mt19937_64& rng) {
+		std::string text = "# generated\n";
+		const size_t amount_lines = 300000;
+		for (size_t i = 0; i < amount_lines; ++i) {
+			if (i % 1000 == 0) {
+				text += "# comment\r\n\n";
+			}
+			text += std::to_string(rng() % 50000) + " " + std::to_string(rng() % 50000) + (i % 7 == 0 ? "" : " " + std::to_string(rng() % 100));
+			text += i % 3 == 0 ? "\r\n" : "\n";
+		}
+		CHECK(text.size() > (4u << 20));
+
+		graph_library::TextReadOptions serial;
+		graph_library::TextReadOptions parallel;
+		parallel.threads = 4;
+		auto expected = graph_library::parseTextGraph<int, int>(text, serial);
+		auto chunked = graph_library::parseTextGraph<int, int>(text, parallel);
+		CHECK(expected.getAmountEdge() == amount_lines);
+		CHECK(chunked.getOffsets() == expected.getOffsets());
+		CHECK(chunked.getTargets() == expected.getTargets());
+		CHECK(chunked.getWeights() == expected.getWeights());
+
+		//The same file through readTextGraph
+		std::string path = temp_path("graph.txt");
+		write_bytes(path, std::vector<char>(text.begin(), text.end()));
+		auto from_file = graph_library::readTextGraph<int, int>(path, parallel);
+		CHECK(from_file.getTargets() == expected.getTargets() && from_file.getWeights() == expected.getWeights());
+
+		//An error in a late chunk is reported with its line in the whole text
+		size_t line = 1;
+		size_t position = 0;
+		while (position < text.size() * 9 / 10) {
+			position = text.find('\n', position) + 1;
+			++line;
+		}
+		text.insert(position, "1 2 bad\n");
+		CHECK(error_line(text, serial) == line);
+		CHECK(error_line(text, parallel) == line);
+		write_bytes(path, std::vector<char>(text.begin(), text.end()));
+		bool named = false;
+		try {
+			graph_library::readTextGraph<int, int>(path, parallel);
+		}
+		catch (const graph_library::ParseException& error) {
+			named = std::string(error.what()).find(path + ": line " + std::to_string(line) + ":") == 0;
+		}
+		CHECK(named);
+		std::filesystem::remove(path);
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(10);
+	test_binary_files();
+	test_text_formats();
+	test_text_chunks(rng);
+	return graph_library::test::result();
+}
@@ -0,0 +1,144 @@
+//buildCompactGraph and GraphBuilder against a plain list per node: symmetric, remove_self_loops, sort_edges and
+//remove_duplicates on random batches with self-loops and parallel edges, the same arrays for every amount of threads
+#include "graph_core/graph_builder.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using Lists = std::vector<std::vector<std::pair<std::uint32_t, int>>>;
+
+	//Edges of every node in the order buildCompactGraph promises: the order of the batches
+	Lists reference_lists(size_t amount_nodes, const std::vector<EdgeRecord<int>>& records, const GraphBuilderOptions& options) {
+		Lists lists(amount_nodes);
+		for (const auto& record : records) {
+			if (record.from == record.to && options.remove_self_loops) {
+				continue;
+			}
+			lists[record.from].emplace_back(record.to, record.weight);
+			if (options.symmetric && record.from != record.to) {
+				lists[record.to].emplace_back(record.from, record.weight);
+			}
+		}
+		for (auto& list : lists) {
+			if (options.sort_edges || options.remove_duplicates) {
+				std::sort(list.begin(), list.end());
+			}
+			if (options.remove_duplicates) {
+				//The lightest edge of every target sorts first
+				list.erase(std::unique(list.begin(), list.end(), [](const auto& first, const auto& second) {
+					return first.first == second.first;
+					}), list.end());
+			}
+		}
+		return lists;
+	}
+
+	Lists lists_of(const CompactGraph<int, int>& graph) {
+		Lists lists(graph.getAmountNodes());
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			for (const auto& edge : graph.outEdges(i)) {
+				lists[i].emplace_back(static_cast<std::uint32_t>(edge.get_to_index()), edge.get_weight());
+			}
+		}
+		return lists;
+	}
+
+	void test_options(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 400; ++trial) {
+			size_t amount_nodes = 1 + rng() % 50;
+			//Fewer edges than nodes and many edges per node, so counting runs on one and on several threads
+			size_t amount_records = trial % 2 == 0 ? rng() % amount_nodes : rng() % (amount_nodes * 12);
+			std::vector<EdgeRecord<int>> records(amount_records);
+			for (auto& record : records) {
+				//Few distinct targets and weights give self-loops and parallel edges of different weights
+				record = { static_cast<std::uint32_t>(rng() % amount_nodes), static_cast<std::uint32_t>(rng() % amount_nodes),
+					static_cast<int>(rng() % 5) - 2 };
+			}
+			//Batches of random sizes, some of them empty
+			std::vector<std::vector<EdgeRecord<int>>> batches;
+			for (size_t begin = 0; begin < records.size() || batches.empty();) {
+				size_t length = std::min<size_t>(records.size() - begin, rng() % 30);
+				batches.emplace_back(records.begin() + static_cast<std::ptrdiff_t>(begin), records.begin() + static_cast<std::ptrdiff_t>(begin + length));
+				begin += length;
+			}
+
+			GraphBuilderOptions options;
+			options.symmetric = rng() % 2 == 0;
+			options.remove_self_loops = rng() % 2 == 0;
+			options.sort_edges = rng() % 2 == 0;
+			options.remove_duplicates = rng() % 3 == 0;
+			Lists expected = reference_lists(amount_nodes, records, options);
+			size_t expected_edges = 0;
+			for (const auto& list : expected) {
+				expected_edges += list.size();
+			}
+
+			for (size_t threads : { size_t(1), size_t(2), size_t(5) }) {
+				options.threads = threads;
+				auto graph = buildCompactGraph<int, int>(amount_nodes, batches, {}, options);
+				CHECK(graph.getAmountNodes() == amount_nodes && graph.getAmountEdge() == expected_edges);
+				CHECK(lists_of(graph) == expected);
+				CHECK(graph.getNodeData(amount_nodes - 1) == static_cast<int>(amount_nodes - 1));
+
+				//The same edges through the builder, single edges, spans and moved batches mixed
+				GraphBuilder<int, int> builder(amount_nodes, options);
+				for (size_t b = 0; b < batches.size(); ++b) {
+					if (b % 3 == 0) {
+						for (const auto& record : batches[b]) {
+							builder.addEdge(record.from, record.to, record.weight);
+						}
+					}
+					else if (b % 3 == 1) {
+						builder.addEdges(std::span<const EdgeRecord<int>>(batches[b]));
+					}
+					else {
+						builder.addEdges(std::vector<EdgeRecord<int>>(batches[b]));
+					}
+				}
+				CHECK(builder.getAmountEdge() == records.size());
+				CHECK(lists_of(builder.buildCompact()) == expected);
+				CHECK(builder.getAmountEdge() == 0);
+			}
+		}
+	}
+
+	void test_builder() {
+		//The amount of nodes grows to the largest index, node data is kept
+		GraphBuilder<int, int> builder;
+		builder.setNodesData({ 7, 8 });
+		builder.addEdge(0, 4, 3);
+		auto graph = builder.buildCompact();
+		CHECK(graph.getAmountNodes() == 5 && graph.getNodeData(1) == 8 && graph.getNodeData(4) == 0);
+
+		GraphBuilderOptions options;
+		options.symmetric = true;
+		GraphBuilder<int, int> symmetric(3, options);
+		symmetric.addEdge(0, 1, 2);
+		symmetric.addEdge(2, 2, 1);
+		auto built = symmetric.build();
+		CHECK(built.getAmountNodes() == 3 && built.getAmountEdge() == 3);
+
+		bool thrown = false;
+		try {
+			std::vector<std::vector<EdgeRecord<int>>> batches{ { { 0, 3, 1 } } };
+			buildCompactGraph<int, int>(3, batches);
+		}
+		catch (const graph_library::InvalidIndexException&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(11);
+	test_options(rng);
+	test_builder();
+	return graph_library::test::result();
+}
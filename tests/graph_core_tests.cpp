@@ -1 +1,468 @@
+//Node removal in Graph against a plain list of edges: random additions and removals, compact and permute,
+//the component index under the same changes, the algorithms that skip the empty slots of removed nodes
+//and CompressedGraph built from sorted edge batches and from a binary file against one built from a CompactGraph
+#include "graph_core/graph.hpp"
+#include "graph_core/compressed_graph.hpp"
+#include "graph_io/file_reader.hpp"
+#include "graph_io/file_writer.hpp"
+#include "graph_algorithms/pagerank.hpp"
+#include "graph_algorithms/katz.hpp"
+#include "graph_algorithms/label_propagation.hpp"
+#include "graph_algorithms/prim.hpp"
+#include "graph_algorithms/kruskal.hpp"
+#include "graph_algorithms/dfs.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <utility>
+#include <vector>
 
+namespace {
+
+	//Directed edges from -> to, a removed node is a false entry of alive
+	struct ReferenceGraph {
+		std::vector<bool> alive;
+		std::vector<std::pair<size_t, size_t>> edges;
+
+		void remove_node(size_t index) {
+			alive[index] = false;
+			std::erase_if(edges, [index](const auto& edge) { return edge.first == index || edge.second == index; });
+		}
+		void remove_edges(size_t from, size_t to) {
+			std::erase_if(edges, [from, to](const auto& edge) { return edge.first == from && edge.second == to; });
+		}
+		void renumber(const std::vector<size_t>& new_index, size_t amount) {
+			for (auto& [from, to] : edges) {
+				from = new_index[from];
+				to = new_index[to];
+			}
+			alive.assign(amount, true);
+		}
+	};
+
+	template <typename GRAPH>
+	bool matches(const GRAPH& graph, const ReferenceGraph& reference) {
+		if (graph.getAmountNodes() != reference.alive.size() || graph.getAmountEdge() != reference.edges.size()) {
+			return false;
+		}
+		for (size_t index = 0; index < graph.getAmountNodes(); ++index) {
+			if (graph.isNodeRemoved(index) == reference.alive[index]) {
+				return false;
+			}
+			std::vector<size_t> actual;
+			for (const auto& edge : graph.outEdges(index)) {
+				actual.push_back(edge.get_to_index());
+			}
+			std::vector<size_t> expected;
+			for (const auto& [from, to] : reference.edges) {
+				if (from == index) {
+					expected.push_back(to);
+				}
+			}
+			std::sort(actual.begin(), actual.end());
+			std::sort(expected.begin(), expected.end());
+			if (actual != expected) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Random live node, the graph must have one
+	size_t live_node(const ReferenceGraph& reference, std::mt19937_64& rng) {
+		size_t index;
+		do {
+			index = rng() % reference.alive.size();
+		} while (!reference.alive[index]);
+		return index;
+	}
+
+	//Random changes of a graph with both addEdge and addEdgeOriented; every removal of a node has to
+	//find the edges leading to it, paired or not, self-loops and edges that lost their pair included
+	template <typename GRAPH>
+	void test_removal(std::mt19937_64& rng) {
+		constexpr bool oriented = requires (GRAPH graph) { graph.addEdgeOriented(0, 1, 1); };
+		for (size_t trial = 0; trial < 300; ++trial) {
+			const size_t amount_nodes = 2 + rng() % 12;
+			GRAPH graph;
+			ReferenceGraph reference;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				graph.addNode(static_cast<int>(i));
+			}
+			reference.alive.assign(amount_nodes, true);
+
+			bool consistent = true;
+			for (size_t step = 0; step < 60 && consistent; ++step) {
+				const size_t live = std::count(reference.alive.begin(), reference.alive.end(), true);
+				if (live == 0) {
+					break;
+				}
+				size_t first = live_node(reference, rng);
+				size_t second = live_node(reference, rng);
+				size_t operation = rng() % 10;
+				if (operation < 4) {
+					graph.addEdge(first, second, 1);
+					reference.edges.emplace_back(first, second);
+					if (!GRAPH::directed && first != second) {
+						reference.edges.emplace_back(second, first);
+					}
+				}
+				else if (operation < 6) {
+					if constexpr (oriented) {
+						graph.addEdgeOriented(first, second, 1);
+						reference.edges.emplace_back(first, second);
+					}
+				}
+				else if (operation < 7) {
+					if constexpr (oriented) {
+						graph.removeEdgeOriented(graph.getNode(first), graph.getNode(second));
+						reference.remove_edges(first, second);
+					}
+				}
+				else if (operation < 8 && graph.getAmountRemovedNodes() == 0) {
+					//Snapshots lose the pairs, the graph rebuilt from one finds them again
+					graph = GRAPH(graph.freeze());
+				}
+				else if (operation < 9 || live < 3) {
+					graph.removeNode(graph.getNode(first));
+					reference.remove_node(first);
+				}
+				else if (graph.getAmountRemovedNodes() != 0) {
+					reference.renumber(graph.compact(), live);
+					//Renumbering keeps the sources of unpaired edges correct as well
+					std::vector<std::uint32_t> order(live);
+					for (size_t i = 0; i < live; ++i) {
+						order[i] = static_cast<std::uint32_t>(i);
+					}
+					std::shuffle(order.begin(), order.end(), rng);
+					Permutation permutation(order);
+					graph.permute(permutation);
+					std::vector<size_t> new_index(live);
+					for (size_t i = 0; i < live; ++i) {
+						new_index[i] = permutation.newIndex(i);
+					}
+					reference.renumber(new_index, live);
+				}
+				consistent = matches(graph, reference);
+			}
+			CHECK(consistent);
+
+			//A copy keeps them too
+			GRAPH copy(graph);
+			for (size_t index = 0; index < reference.alive.size(); ++index) {
+				if (reference.alive[index]) {
+					copy.removeNode(copy.getNode(index));
+					reference.remove_node(index);
+					break;
+				}
+			}
+			CHECK(matches(copy, reference));
+		}
+	}
+
+	//Components of the live nodes by a search over the edges in both directions, named by their smallest node
+	template <typename GRAPH>
+	std::vector<size_t> reference_components(const GRAPH& graph) {
+		const size_t amount_nodes = graph.getAmountNodes();
+		std::vector<std::vector<size_t>> neighbours(amount_nodes);
+		for (size_t index = 0; index < amount_nodes; ++index) {
+			for (const auto& edge : graph.outEdges(index)) {
+				neighbours[index].push_back(edge.get_to_index());
+				neighbours[edge.get_to_index()].push_back(index);
+			}
+		}
+		std::vector<size_t> component(amount_nodes, amount_nodes);
+		for (size_t start = 0; start < amount_nodes; ++start) {
+			if (component[start] != amount_nodes) {
+				continue;
+			}
+			std::vector<size_t> stack{ start };
+			component[start] = start;
+			while (!stack.empty()) {
+				size_t index = stack.back();
+				stack.pop_back();
+				for (size_t to : neighbours[index]) {
+					if (component[to] == amount_nodes) {
+						component[to] = start;
+						stack.push_back(to);
+					}
+				}
+			}
+		}
+		return component;
+	}
+
+	template <typename GRAPH>
+	bool components_match(const GRAPH& graph) {
+		auto component = reference_components(graph);
+		size_t amount = 0;
+		for (size_t index = 0; index < graph.getAmountNodes(); ++index) {
+			amount += component[index] == index && !graph.isNodeRemoved(index);
+			for (size_t other = 0; other < graph.getAmountNodes(); ++other) {
+				if (graph.connected(index, other) != (component[index] == component[other]) ||
+					(graph.componentOf(index) == graph.componentOf(other)) != (component[index] == component[other])) {
+					return false;
+				}
+			}
+		}
+		return graph.componentCount() == amount;
+	}
+
+	//The component index is updated by every addition and removal of edges and nodes
+	template <typename GRAPH>
+	void test_component_index(std::mt19937_64& rng) {
+		constexpr bool oriented = requires (GRAPH graph) { graph.addEdgeOriented(0, 1, 1); };
+		for (size_t trial = 0; trial < 40; ++trial) {
+			GRAPH graph(2 + rng() % 30, 0);
+			graph.enableComponentIndex();
+			bool consistent = components_match(graph);
+			for (size_t step = 0; step < 200 && consistent; ++step) {
+				if (graph.getAmountNodes() == 0) {
+					graph.addNode(0);
+				}
+				const size_t amount_nodes = graph.getAmountNodes();
+				size_t first = rng() % amount_nodes;
+				size_t second = rng() % amount_nodes;
+				if (graph.isNodeRemoved(first) || graph.isNodeRemoved(second)) {
+					if (rng() % 4 == 0) {
+						graph.compact();
+					}
+					continue;
+				}
+				switch (rng() % 9) {
+				case 0:
+				case 1:
+				case 2:
+					graph.addEdge(first, second, 1);
+					break;
+				case 3:
+					if constexpr (oriented) {
+						graph.addEdgeOriented(first, second, 1);
+					}
+					break;
+				case 4:
+					graph.removeEdge(graph.getNode(first), graph.getNode(second));
+					break;
+				case 5:
+					if (!graph.outEdges(first).empty()) {
+						graph.removeEdge(graph.getNode(first), graph.getNode(graph.outEdges(first)[0].get_to_index()));
+					}
+					break;
+				case 6:
+					if constexpr (oriented) {
+						graph.removeEdgeOriented(graph.getNode(first), graph.getNode(second));
+					}
+					break;
+				case 7:
+					graph.removeAllEdgesOfNode(graph.getNode(first));
+					break;
+				default:
+					if (rng() % 2 == 0) {
+						graph.removeNode(graph.getNode(first));
+					}
+					else {
+						graph.addNode(0);
+					}
+				}
+				consistent = components_match(graph);
+			}
+			CHECK(consistent);
+			GRAPH copy(graph);
+			CHECK(components_match(copy));
+			graph.removeAllEdge();
+			CHECK(components_match(graph));
+		}
+	}
+
+	//An undirected graph takes only snapshots with every edge in both directions
+	void test_undirected_snapshot() {
+		CompactGraph<int, int> symmetric({ 0, 1, 2 }, { 0, 2, 3, 4 }, { 1, 2, 0, 0 }, { 5, 6, 5, 6 });
+		UndirectedGraph<int> graph(symmetric);
+		graph.removeNode(graph.getNode(1));
+		CHECK(graph.getAmountEdge() == 2);
+		CHECK(graph.outEdges(0).size() == 1 && graph.outEdges(0)[0].get_to_index() == 2);
+		//A non-zero weight has to match, zero finds an edge of any weight
+		CHECK(graph.hasEdge(graph.getNode(0), graph.getNode(2)) && graph.hasEdge(graph.getNode(2), graph.getNode(0), 6));
+		CHECK(!graph.hasEdge(graph.getNode(0), graph.getNode(2), 5));
+
+		//The edge 2 -> 0 has another weight than 0 -> 2
+		CompactGraph<int, int> asymmetric({ 0, 1, 2 }, { 0, 2, 3, 4 }, { 1, 2, 0, 0 }, { 5, 6, 5, 7 });
+		bool thrown = false;
+		try {
+			UndirectedGraph<int> rejected(asymmetric);
+		}
+		catch (const graph_library::GraphException&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+		//A mixed graph keeps both edges unpaired and still removes them with the node
+		Graph<int> mixed(asymmetric);
+		mixed.removeNode(mixed.getNode(2));
+		CHECK(mixed.getAmountEdge() == 2);
+		CHECK(mixed.hasEdge(mixed.getNode(0), mixed.getNode(1), 5) && !mixed.hasEdge(mixed.getNode(0), mixed.getNode(1), 6));
+	}
+
+	//Edges of every node sorted by target and weight, parallel edges may come in any order
+	template <typename GRAPH>
+	std::vector<std::vector<std::pair<size_t, int>>> sorted_edges(const GRAPH& graph) {
+		std::vector<std::vector<std::pair<size_t, int>>> result(graph.getAmountNodes());
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			for (const auto& edge : graph.outEdges(i)) {
+				result[i].emplace_back(edge.get_to_index(), edge.get_weight());
+			}
+			std::sort(result[i].begin(), result[i].end());
+		}
+		return result;
+	}
+
+	void test_compressed_builder(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 50; ++trial) {
+			size_t amount_nodes = 1 + rng() % 200;
+			std::vector<EdgeRecord<int>> records(rng() % (amount_nodes * 8));
+			for (auto& record : records) {
+				record = { static_cast<std::uint32_t>(rng() % amount_nodes), static_cast<std::uint32_t>(rng() % amount_nodes),
+					static_cast<int>(rng() % 2000) - 1000 };
+			}
+			std::sort(records.begin(), records.end(), [](const auto& first, const auto& second) {
+				return first.from < second.from;
+				});
+			std::vector<std::uint64_t> offsets(amount_nodes + 1, 0);
+			std::vector<std::uint32_t> targets;
+			std::vector<int> weights;
+			for (const auto& record : records) {
+				++offsets[record.from + 1];
+				targets.push_back(record.to);
+				weights.push_back(record.weight);
+			}
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				offsets[i + 1] += offsets[i];
+			}
+			std::vector<int> data(amount_nodes);
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				data[i] = static_cast<int>(i);
+			}
+			CompactGraph<int, int> compact(data, offsets, targets, weights);
+			CompressedGraph<int, int> expected(compact);
+
+			//Batches cut at random points, some in the middle of the edges of a node
+			CompressedGraphBuilder<int, int> builder(amount_nodes, -1000, 999);
+			builder.setNodesData(data);
+			for (size_t begin = 0; begin < records.size();) {
+				size_t length = std::min<size_t>(records.size() - begin, rng() % 40);
+				builder.addEdges(std::span<const EdgeRecord<int>>(records.data() + begin, length));
+				begin += length;
+			}
+			auto built = builder.build();
+			CHECK(built.getAmountNodes() == amount_nodes && built.getAmountEdge() == records.size());
+			CHECK(built.getNodeData(amount_nodes - 1) == static_cast<int>(amount_nodes - 1));
+			CHECK(built.weightBits() == 11);
+			CHECK(sorted_edges(built) == sorted_edges(expected));
+
+			auto path = std::filesystem::temp_directory_path() / "graph_core_tests_compressed.bin";
+			graph_library::writeBinaryGraph(path.string(), compact);
+			auto from_file = graph_library::readBinaryGraph<int, int>(path.string()).toCompressedGraph();
+			std::filesystem::remove(path);
+			CHECK(from_file.getAmountNodes() == amount_nodes && from_file.getNodeData(0) == 0);
+			CHECK(sorted_edges(from_file) == sorted_edges(expected));
+		}
+
+		//Nodes after the last source get no edges, sources must not go back and weights must stay in the range
+		CompressedGraphBuilder<int, int> builder(2, 0, 10);
+		builder.addEdge(1, 4, 3);
+		CHECK(builder.build().getAmountNodes() == 5);
+		builder.addEdge(1, 0, 3);
+		bool unsorted = false;
+		try {
+			builder.addEdge(0, 1, 3);
+		}
+		catch (const graph_library::GraphException&) {
+			unsorted = true;
+		}
+		CHECK(unsorted);
+		bool outside = false;
+		try {
+			builder.addEdge(2, 1, 11);
+		}
+		catch (const graph_library::GraphException&) {
+			outside = true;
+		}
+		CHECK(outside);
+	}
+
+	//Path 0 - 1 - 2 - 3 - 4 and the edge 5 - 6, node 2 and node 5 are removed
+	template <typename GRAPH>
+	GRAPH removed_nodes_graph() {
+		GRAPH graph;
+		for (int i = 0; i < 7; ++i) {
+			graph.addNode(i);
+		}
+		for (size_t i = 0; i + 1 < 5; ++i) {
+			graph.addEdge(i, i + 1, static_cast<int>(i + 1));
+		}
+		graph.addEdge(5, 6, 7);
+		graph.removeNode(graph.getNode(2));
+		graph.removeNode(graph.getNode(5));
+		return graph;
+	}
+
+	void test_algorithms() {
+		auto graph = removed_nodes_graph<Graph<int>>();
+
+		auto ranks = graph_library::pageRank(graph);
+		double sum = 0;
+		for (double rank : ranks.values) {
+			sum += rank;
+		}
+		CHECK(std::abs(sum - 1) < 1e-6);
+		CHECK(ranks.values[2] == 0 && ranks.values[5] == 0);
+		CHECK(ranks.values[6] > 0);
+
+		auto katz = graph_library::katzCentrality(graph);
+		CHECK(katz.values[2] == 0 && katz.values[5] == 0);
+		CHECK(katz.values[6] > 0);
+
+		auto labels = graph_library::labelPropagation(graph);
+		CHECK(labels.values[2] == graph_library::NO_LABEL && labels.values[5] == graph_library::NO_LABEL);
+		CHECK(labels.values[0] == 0 && labels.values[1] == 0 && labels.values[3] == 3 && labels.values[4] == 3 && labels.values[6] == 6);
+
+		//Trees {0, 1}, {3, 4} and {6}
+		for (auto mode : { graph_library::PrimMode::HEAP, graph_library::PrimMode::DENSE }) {
+			graph_library::PrimOptions options;
+			options.mode = mode;
+			auto forest = graph_library::prim(graph, options);
+			CHECK(forest.amount_trees == 3);
+			CHECK(forest.edges.size() == 2 && forest.total_weight == 5);
+		}
+		auto forest = graph_library::kruskal(graph);
+		CHECK(forest.amount_trees == 3);
+		CHECK(forest.edges.size() == 2 && forest.total_weight == 5);
+
+		auto unweighted = removed_nodes_graph<Graph<int, void>>();
+		CHECK(graph_library::prim(unweighted).amount_trees == 3);
+
+		//Every live node is a component of its own in a directed path
+		auto directed = removed_nodes_graph<DirectedGraph<int>>();
+		auto components = graph_library::stronglyConnectedComponents(directed);
+		CHECK(components.amount == 5);
+		CHECK(components.component[2] == graph_library::detail::TarjanVisitor::NONE);
+		auto order = graph_library::topologicalSort(directed);
+		CHECK(order.size() == 5);
+		CHECK(std::find(order.begin(), order.end(), size_t(2)) == order.end());
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(15);
+	test_removal<Graph<int>>(rng);
+	test_removal<DirectedGraph<int>>(rng);
+	test_removal<UndirectedGraph<int>>(rng);
+	test_component_index<Graph<int>>(rng);
+	test_component_index<DirectedGraph<int>>(rng);
+	test_component_index<UndirectedGraph<int>>(rng);
+	test_undirected_snapshot();
+	test_compressed_builder(rng);
+	test_algorithms();
+	return graph_library::test::result();
+}
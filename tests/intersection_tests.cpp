@@ -0,0 +1,145 @@
+//Intersection kernels, triangle counts, clustering coefficients and common neighbours against std::set
+//on random inputs, with every kernel and with several threads
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/intersection.hpp"
+#include "graph_algorithms/triangles.hpp"
+#include "graph_algorithms/common_neighbors.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using graph_library::IntersectionKernel;
+
+	constexpr IntersectionKernel KERNELS[] = { IntersectionKernel::AUTO, IntersectionKernel::SCALAR, IntersectionKernel::SSE, IntersectionKernel::AVX2 };
+
+	//Sorted values without duplicates drawn from [low, low + range)
+	std::set<std::uint32_t> random_set(std::mt19937_64& rng, size_t amount, std::uint64_t low, std::uint64_t range) {
+		std::set<std::uint32_t> result;
+		amount = std::min<std::uint64_t>(amount, range);
+		while (result.size() < amount) {
+			result.insert(static_cast<std::uint32_t>(low + rng() % range));
+		}
+		return result;
+	}
+
+	void test_kernels(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 3000; ++trial) {
+			//Lengths around the 4 and 8 wide blocks, sometimes far apart so that galloping takes over,
+			//values near the top of the range to catch signed comparisons
+			size_t amount_first = rng() % 40;
+			size_t amount_second = trial % 5 == 0 ? rng() % 2000 : rng() % 40;
+			std::uint64_t range = 1 + (rng() % 3) * 100 + amount_first + amount_second;
+			std::uint64_t low = trial % 3 == 0 ? std::numeric_limits<std::uint32_t>::max() - range + 1 : rng() % 1000;
+			auto first = random_set(rng, amount_first, low, range);
+			auto second = random_set(rng, amount_second, low, range);
+
+			std::vector<std::uint32_t> common;
+			std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(common));
+			std::vector<std::uint32_t> first_array(first.begin(), first.end());
+			std::vector<std::uint32_t> second_array(second.begin(), second.end());
+			for (IntersectionKernel kernel : KERNELS) {
+				CHECK(graph_library::intersectionSize(first_array, second_array, kernel) == common.size());
+				CHECK(graph_library::intersectionSize(second_array, first_array, kernel) == common.size());
+			}
+		}
+	}
+
+	//Undirected graph with duplicate edges and self-loops, and its neighbour sets without them
+	Graph<int> random_graph(std::mt19937_64& rng, std::vector<std::set<size_t>>& reference) {
+		size_t amount_nodes = 1 + rng() % 60;
+		size_t amount_edges = rng() % (amount_nodes * 6);
+		Graph<int> graph;
+		reference.assign(amount_nodes, {});
+		for (size_t i = 0; i < amount_nodes; ++i) {
+			graph.addNode(static_cast<int>(i));
+		}
+		for (size_t i = 0; i < amount_edges; ++i) {
+			size_t first = rng() % amount_nodes;
+			size_t second = rng() % amount_nodes;
+			graph.addEdge(first, second, 1);
+			if (first != second) {
+				reference[first].insert(second);
+				reference[second].insert(first);
+			}
+		}
+		return graph;
+	}
+
+	size_t common_count(const std::set<size_t>& first, const std::set<size_t>& second) {
+		std::vector<size_t> common;
+		std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(common));
+		return common.size();
+	}
+
+	void test_graph_analytics(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 200; ++trial) {
+			std::vector<std::set<size_t>> reference;
+			Graph<int> graph = random_graph(rng, reference);
+			const size_t amount_nodes = reference.size();
+
+			std::uint64_t triangles = 0;
+			std::vector<std::uint64_t> per_node(amount_nodes, 0);
+			for (size_t a = 0; a < amount_nodes; ++a) {
+				for (size_t b : reference[a]) {
+					for (size_t c : reference[b]) {
+						if (a < b && b < c && reference[a].count(c)) {
+							++triangles;
+							++per_node[a];
+							++per_node[b];
+							++per_node[c];
+						}
+					}
+				}
+			}
+			std::vector<std::pair<size_t, size_t>> pairs;
+			for (size_t i = 0; i < 50; ++i) {
+				pairs.emplace_back(rng() % amount_nodes, rng() % amount_nodes);
+			}
+
+			for (IntersectionKernel kernel : KERNELS) {
+				for (size_t threads : { size_t(1), size_t(4) }) {
+					graph_library::IntersectionOptions options;
+					options.kernel = kernel;
+					options.threads = threads;
+					graph_library::NeighbourSets sets(graph, threads);
+
+					CHECK(graph_library::countTriangles(sets, options) == triangles);
+					CHECK(graph_library::countTrianglesPerNode(sets, options) == per_node);
+					auto coefficients = graph_library::localClusteringCoefficient(sets, options);
+					for (size_t i = 0; i < amount_nodes; ++i) {
+						double degree = static_cast<double>(reference[i].size());
+						double expected = degree < 2 ? 0.0 : 2.0 * static_cast<double>(per_node[i]) / (degree * (degree - 1));
+						CHECK(std::abs(coefficients[i] - expected) < 1e-12);
+					}
+
+					auto common = graph_library::commonNeighbors(sets, pairs, options);
+					auto jaccard = graph_library::jaccardSimilarity(sets, pairs, options);
+					for (size_t i = 0; i < pairs.size(); ++i) {
+						const auto& first = reference[pairs[i].first];
+						const auto& second = reference[pairs[i].second];
+						size_t expected = common_count(first, second);
+						CHECK(common[i] == expected);
+						size_t united = first.size() + second.size() - expected;
+						CHECK(std::abs(jaccard[i] - (united == 0 ? 0.0 : static_cast<double>(expected) / static_cast<double>(united))) < 1e-12);
+					}
+				}
+			}
+		}
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(19);
+	test_kernels(rng);
+	test_graph_analytics(rng);
+	return graph_library::test::result();
+}
@@ -0,0 +1,129 @@
+//Prim (heap and dense) and Kruskal against a brute-force minimum spanning forest on small random graphs
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/prim.hpp"
+#include "graph_algorithms/kruskal.hpp"
+#include "graph_algorithms/union_find.hpp"
+#include "test_support.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+	//Tries every subset of edges: the forest has the most edges among acyclic subsets and then the least weight
+	long long brute_force_forest(size_t amount_nodes, const std::vector<EdgeRecord<int>>& edges) {
+		size_t best_size = 0;
+		long long best_weight = 0;
+		for (size_t mask = 0; mask < (size_t(1) << edges.size()); ++mask) {
+			graph_library::UnionFind sets(amount_nodes);
+			size_t size = 0;
+			long long weight = 0;
+			bool acyclic = true;
+			for (size_t i = 0; i < edges.size() && acyclic; ++i) {
+				if (mask & (size_t(1) << i)) {
+					acyclic = sets.unite(edges[i].from, edges[i].to);
+					++size;
+					weight += edges[i].weight;
+				}
+			}
+			if (acyclic && (size > best_size || (size == best_size && weight < best_weight))) {
+				best_size = size;
+				best_weight = weight;
+			}
+		}
+		return best_weight;
+	}
+
+	//Edges of the forest connect the nodes without a cycle and sum up to total_weight
+	template <typename WEIGHT_TYPE>
+	bool is_forest(size_t amount_nodes, const graph_library::MstResult<WEIGHT_TYPE>& result) {
+		graph_library::UnionFind sets(amount_nodes);
+		long long weight = 0;
+		for (const auto& edge : result.edges) {
+			if (!sets.unite(edge.from, edge.to)) {
+				return false;
+			}
+			weight += edge.weight;
+		}
+		return weight == result.total_weight && result.edges.size() + result.amount_trees == amount_nodes;
+	}
+
+	void test_undirected(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 300; ++trial) {
+			size_t amount_nodes = 1 + rng() % 7;
+			size_t amount_edges = rng() % 13;
+			Graph<size_t> graph;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				graph.addNode(i);
+			}
+			for (size_t i = 0; i < amount_edges; ++i) {
+				graph.addEdge(rng() % amount_nodes, rng() % amount_nodes, static_cast<int>(1 + rng() % 20));
+			}
+			long long expected = brute_force_forest(amount_nodes, collectEdges(graph, true));
+
+			for (auto mode : { graph_library::PrimMode::HEAP, graph_library::PrimMode::DENSE }) {
+				graph_library::PrimOptions options;
+				options.mode = mode;
+				auto result = graph_library::prim(graph, options);
+				CHECK(result.total_weight == expected);
+				CHECK(is_forest(amount_nodes, result));
+				auto compact = graph_library::prim(graph.freeze(), options);
+				CHECK(compact.total_weight == expected);
+			}
+			for (size_t threads : { 1, 3 }) {
+				graph_library::KruskalOptions options;
+				options.threads = threads;
+				options.base_case = 4;
+				auto result = graph_library::kruskal(graph, options);
+				CHECK(result.total_weight == expected);
+				CHECK(is_forest(amount_nodes, result));
+				options.symmetric = true;
+				CHECK(graph_library::kruskal(graph, options).total_weight == expected);
+			}
+		}
+	}
+
+	//Kruskal takes the edges of a directed graph as undirected, of two opposite edges the lighter one
+	void test_directed(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 300; ++trial) {
+			size_t amount_nodes = 1 + rng() % 7;
+			size_t amount_edges = rng() % 13;
+			DirectedGraph<size_t> graph;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				graph.addNode(i);
+			}
+			for (size_t i = 0; i < amount_edges; ++i) {
+				graph.addEdge(rng() % amount_nodes, rng() % amount_nodes, static_cast<int>(1 + rng() % 20));
+			}
+			auto edges = collectEdges(graph);
+			std::erase_if(edges, [](const EdgeRecord<int>& edge) { return edge.from == edge.to; });
+			long long expected = brute_force_forest(amount_nodes, edges);
+
+			auto result = graph_library::kruskal(graph);
+			CHECK(result.total_weight == expected);
+			CHECK(is_forest(amount_nodes, result));
+		}
+	}
+
+	void test_unweighted() {
+		Graph<int, void> graph(5);
+		graph.addEdge(0, 1);
+		graph.addEdge(1, 2);
+		graph.addEdge(0, 2);
+		graph.addEdge(3, 4);
+		for (auto mode : { graph_library::PrimMode::HEAP, graph_library::PrimMode::DENSE }) {
+			graph_library::PrimOptions options;
+			options.mode = mode;
+			auto result = graph_library::prim(graph, options);
+			CHECK(result.total_weight == 3);
+			CHECK(result.amount_trees == 2);
+		}
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(7);
+	test_undirected(rng);
+	test_directed(rng);
+	test_unweighted();
+	return graph_library::test::result();
+}
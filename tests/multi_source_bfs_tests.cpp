@@ -0,0 +1,89 @@
+//multiSourceBfs and hopStatistics against one bfs per source: every batch size, with and without AVX2,
+//with several threads, on directed graphs with repeated sources and on a graph with unreachable nodes
+#include "graph_core/graph.hpp"
+#include "graph_io/generators.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/multi_source_bfs.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+	using graph_library::BFS_UNREACHED;
+
+	template <typename GRAPH>
+	void check_batches(const GRAPH& graph, const std::vector<size_t>& sources) {
+		std::vector<std::vector<size_t>> expected;
+		for (size_t source : sources) {
+			expected.push_back(graph_library::bfs(graph, source).distance);
+		}
+		for (size_t batch : { size_t(64), size_t(128), size_t(256) }) {
+			for (bool vectorized : { false, true }) {
+				for (size_t threads : { size_t(1), size_t(3) }) {
+					graph_library::MultiSourceBfsOptions options;
+					options.batch_size = batch;
+					options.vectorized = vectorized;
+					options.threads = threads;
+					CHECK(graph_library::multiSourceBfs(graph, sources, options) == expected);
+
+					auto statistics = graph_library::hopStatistics(graph, sources, options);
+					CHECK(statistics.size() == sources.size());
+					for (size_t i = 0; i < sources.size(); ++i) {
+						size_t reached = 0;
+						size_t distance_sum = 0;
+						size_t eccentricity = 0;
+						for (size_t distance : expected[i]) {
+							if (distance != BFS_UNREACHED) {
+								++reached;
+								distance_sum += distance;
+								eccentricity = std::max(eccentricity, distance);
+							}
+						}
+						CHECK(statistics[i].reached == reached);
+						CHECK(statistics[i].distance_sum == distance_sum);
+						CHECK(statistics[i].eccentricity == eccentricity);
+					}
+				}
+			}
+		}
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 6; ++trial) {
+			graph_library::GeneratorOptions options;
+			options.seed = trial;
+			options.symmetric = trial % 2 == 0;
+			auto graph = graph_library::generateRmat<int, int>(9 + trial % 3, 4, options);
+			//Amounts that fill no batch, exactly one and a part of the last one, with repeated sources
+			std::vector<size_t> sources(trial * 120 + 1);
+			for (auto& source : sources) {
+				source = rng() % graph.getAmountNodes();
+			}
+			if (sources.size() > 2) {
+				sources[1] = sources[2];
+			}
+			check_batches(graph, sources);
+		}
+	}
+
+	//A path and isolated nodes, sources before and after the end of the path
+	void test_unreachable() {
+		Graph<int, void> graph(10, 0);
+		graph.addEdge(0, 1);
+		graph.addEdge(1, 2);
+		check_batches(graph, { 0, 2, 5 });
+		auto distances = graph_library::multiSourceBfs(graph, { 0, 2, 5 });
+		CHECK(distances[0][2] == 2 && distances[1][0] == 2);
+		CHECK(distances[2][5] == 0 && distances[2][0] == BFS_UNREACHED);
+		CHECK(graph_library::multiSourceBfs(graph, {}).empty());
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(25);
+	test_random(rng);
+	test_unreachable();
+	return graph_library::test::result();
+}
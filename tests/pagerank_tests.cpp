@@ -0,0 +1,157 @@
+//PageRank against a plain power iteration on random directed graphs with dangling nodes, self-loops and parallel
+//edges: one and several threads, personalized runs with repeated sources, float ranks and reruns of one engine
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/pagerank.hpp"
+#include "test_support.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+	//Power iteration over the out-edges, dangling rank goes where the teleports go
+	template <typename GRAPH>
+	std::vector<double> reference_ranks(const GRAPH& graph, const std::vector<double>& teleport, double damping) {
+		const size_t amount_nodes = graph.getAmountNodes();
+		std::vector<double> rank = teleport;
+		for (size_t iteration = 0; iteration < 1000; ++iteration) {
+			std::vector<double> next(amount_nodes, 0.0);
+			double dangling = 0;
+			for (size_t from = 0; from < amount_nodes; ++from) {
+				size_t degree = 0;
+				for (const auto& edge : graph.outEdges(from)) {
+					static_cast<void>(edge);
+					++degree;
+				}
+				if (degree == 0) {
+					dangling += rank[from];
+					continue;
+				}
+				for (const auto& edge : graph.outEdges(from)) {
+					next[edge.get_to_index()] += rank[from] / static_cast<double>(degree);
+				}
+			}
+			double change = 0;
+			for (size_t i = 0; i < amount_nodes; ++i) {
+				next[i] = (1 - damping) * teleport[i] + damping * (next[i] + dangling * teleport[i]);
+				change += std::abs(next[i] - rank[i]);
+			}
+			rank.swap(next);
+			if (change < 1e-14) {
+				break;
+			}
+		}
+		return rank;
+	}
+
+	//Total distance to the reference (L1 norm, as the tolerance of PageRankOptions), ranks summing to 1
+	template <typename VALUE>
+	bool close(const std::vector<VALUE>& values, const std::vector<double>& expected, double tolerance) {
+		if (values.size() != expected.size()) {
+			return false;
+		}
+		double distance = 0;
+		double sum = 0;
+		for (size_t i = 0; i < values.size(); ++i) {
+			distance += std::abs(static_cast<double>(values[i]) - expected[i]);
+			sum += static_cast<double>(values[i]);
+		}
+		return distance < tolerance && std::abs(sum - 1) < tolerance;
+	}
+
+	DirectedGraph<int> random_graph(std::mt19937_64& rng) {
+		size_t amount_nodes = 1 + rng() % 400;
+		size_t amount_edges = rng() % (amount_nodes * 5);
+		DirectedGraph<int> graph(amount_nodes);
+		for (size_t i = 0; i < amount_edges; ++i) {
+			size_t from = rng() % amount_nodes;
+			//About a third of the nodes keep no out-edges
+			if (from % 3 == 2) {
+				continue;
+			}
+			graph.addEdge(from, rng() % amount_nodes, 1);
+		}
+		return graph;
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 60; ++trial) {
+			auto graph = random_graph(rng);
+			const size_t amount_nodes = graph.getAmountNodes();
+			graph_library::PageRankOptions options;
+			options.damping = trial % 4 == 0 ? 0.5 : 0.85;
+			options.tolerance = 1e-13;
+			options.max_iterations = 1000;
+			auto expected = reference_ranks(graph, std::vector<double>(amount_nodes, 1.0 / static_cast<double>(amount_nodes)), options.damping);
+
+			for (size_t threads : { size_t(1), size_t(4) }) {
+				options.threads = threads;
+				auto result = graph_library::pageRank(graph, options);
+				CHECK(result.converged);
+				CHECK(close(result.values, expected, 1e-10));
+				CHECK(close(graph_library::pageRank(graph.freeze(), options).values, expected, 1e-10));
+
+				//Sources given twice get twice the teleports
+				std::vector<size_t> sources = { rng() % amount_nodes, rng() % amount_nodes };
+				sources.push_back(sources[0]);
+				std::vector<double> teleport(amount_nodes, 0.0);
+				for (size_t source : sources) {
+					teleport[source] += 1.0 / static_cast<double>(sources.size());
+				}
+				auto personalized_expected = reference_ranks(graph, teleport, options.damping);
+				graph_library::PageRank<double> engine(graph);
+				auto personalized = engine.runPersonalized(sources, options);
+				CHECK(personalized.converged);
+				CHECK(close(personalized.values, personalized_expected, 1e-10));
+				//The engine is reused, a plain run after a personalized one teleports uniformly again
+				CHECK(close(engine.run(options).values, expected, 1e-10));
+				CHECK(close(engine.runPersonalized(sources, options).values, personalized_expected, 1e-10));
+
+				//Float ranks stop at a coarser tolerance, float rounding leaves them within about 1e-5 in total
+				graph_library::PageRankOptions loose = options;
+				loose.tolerance = 1e-6;
+				loose.max_iterations = 200;
+				CHECK(close(graph_library::pageRank<float>(graph, loose).values, expected, 1e-4));
+				graph_library::PageRank<float> float_engine(graph);
+				CHECK(close(float_engine.runPersonalized(sources, loose).values, personalized_expected, 1e-4));
+			}
+		}
+	}
+
+	void test_invalid() {
+		DirectedGraph<int> graph(3);
+		graph.addEdge(0, 1, 1);
+		graph_library::PageRank<double> engine(graph);
+		for (auto call : { 0, 1, 2 }) {
+			bool thrown = false;
+			try {
+				graph_library::PageRankOptions options;
+				std::vector<size_t> sources = { 0, 3 };
+				switch (call) {
+				case 0:
+					engine.runPersonalized({}, options);
+					break;
+				case 1:
+					engine.runPersonalized(sources, options);
+					break;
+				default:
+					options.damping = 1;
+					engine.run(options);
+				}
+			}
+			catch (const graph_library::GraphException&) {
+				thrown = true;
+			}
+			CHECK(thrown);
+		}
+		//Empty graph
+		CHECK(graph_library::pageRank(DirectedGraph<int>()).values.empty());
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(21);
+	test_random(rng);
+	test_invalid();
+	return graph_library::test::result();
+}
@@ -0,0 +1,75 @@
+//Every ordering returns a permutation of all nodes on random directed and undirected graphs,
+//graphs with isolated nodes and a directed graph whose pseudo-peripheral node does not reach its start
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/reordering.hpp"
+#include "test_support.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+	using graph_library::Ordering;
+
+	constexpr Ordering ORDERINGS[] = { Ordering::DEGREE, Ordering::BFS, Ordering::REVERSE_CUTHILL_MCKEE, Ordering::GORDER };
+
+	template <typename GRAPH>
+	void check_orderings(const GRAPH& graph) {
+		const size_t amount_nodes = graph.getAmountNodes();
+		for (Ordering ordering : ORDERINGS) {
+			graph_library::ReorderingOptions options;
+			options.ordering = ordering;
+			options.source = amount_nodes / 2;
+			bool valid = true;
+			try {
+				Permutation permutation = graph_library::computeOrder(graph, options);
+				valid = permutation.size() == amount_nodes;
+				for (size_t i = 0; valid && i < amount_nodes; ++i) {
+					valid = permutation.originalIndex(permutation.newIndex(i)) == i;
+				}
+			}
+			catch (const graph_library::GraphException&) {
+				valid = false;
+			}
+			CHECK(valid);
+		}
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 300; ++trial) {
+			size_t amount_nodes = 1 + rng() % 40;
+			//Sparse graphs leave isolated nodes and many small components
+			size_t amount_edges = rng() % (amount_nodes * (1 + trial % 4));
+			DirectedGraph<int> directed(amount_nodes);
+			UndirectedGraph<int> undirected(amount_nodes);
+			for (size_t i = 0; i < amount_edges; ++i) {
+				size_t from = rng() % amount_nodes;
+				size_t to = rng() % amount_nodes;
+				directed.addEdge(from, to, 1);
+				undirected.addEdge(from, to, 1);
+			}
+			check_orderings(directed);
+			check_orderings(undirected);
+			check_orderings(directed.freeze());
+		}
+	}
+
+	//The search for a peripheral node moves from 4 to 5, which does not reach 4
+	void test_unreachable_start() {
+		Graph<int> graph(6);
+		graph.addEdgeOriented(1, 3, 1);
+		graph.addEdgeOriented(5, 1, 1);
+		graph.addEdgeOriented(3, 0, 1);
+		graph.addEdgeOriented(4, 5, 1);
+		graph.addEdgeOriented(2, 1, 1);
+		graph.addEdgeOriented(0, 3, 1);
+		check_orderings(graph);
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(20);
+	test_random(rng);
+	test_unreachable_start();
+	check_orderings(Graph<int>());
+	return graph_library::test::result();
+}
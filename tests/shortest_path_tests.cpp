@@ -0,0 +1,141 @@
+//Every shortest path method and bestFirstRange against Bellman-Ford on small random graphs, bucket widths below 1,
+//weights near the limit of the weight type and negative weights
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/dijkstra.hpp"
+#include "graph_algorithms/traversal_ranges.hpp"
+#include "test_support.hpp"
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+	using graph_library::ShortestPathMethod;
+
+	template <typename WEIGHT_TYPE>
+	std::vector<WEIGHT_TYPE> bellman_ford(const DirectedGraph<int, WEIGHT_TYPE>& graph, size_t source) {
+		constexpr WEIGHT_TYPE INF = graph_library::unreachable_distance<WEIGHT_TYPE>();
+		std::vector<WEIGHT_TYPE> distance(graph.getAmountNodes(), INF);
+		distance[source] = 0;
+		for (size_t round = 0; round < graph.getAmountNodes(); ++round) {
+			for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+				if (distance[i] == INF) {
+					continue;
+				}
+				for (const auto& edge : graph.outEdges(i)) {
+					//Paths longer than the weight type can hold stay unreachable
+					if (edge.get_weight() <= INF - distance[i] && distance[i] + edge.get_weight() < distance[edge.get_to_index()]) {
+						distance[edge.get_to_index()] = distance[i] + edge.get_weight();
+					}
+				}
+			}
+		}
+		return distance;
+	}
+
+	template <typename WEIGHT_TYPE>
+	void check_methods(const DirectedGraph<int, WEIGHT_TYPE>& graph, double delta) {
+		auto expected = bellman_ford(graph, 0);
+		for (auto method : { ShortestPathMethod::BINARY_HEAP, ShortestPathMethod::RADIX_HEAP, ShortestPathMethod::DELTA_STEPPING }) {
+			for (size_t threads : { 1, 3 }) {
+				graph_library::ShortestPathOptions options;
+				options.method = method;
+				options.threads = threads;
+				options.delta = delta;
+				auto result = graph_library::dijkstra(graph, 0, options);
+				CHECK(result.distance == expected);
+				//Parents lead back to the source along edges on shortest paths
+				for (size_t i = 1; i < graph.getAmountNodes(); ++i) {
+					size_t parent = result.parent[i];
+					CHECK((parent == graph_library::NO_NODE) == (expected[i] == graph_library::unreachable_distance<WEIGHT_TYPE>()));
+					if (parent != graph_library::NO_NODE) {
+						bool on_path = false;
+						for (const auto& edge : graph.outEdges(parent)) {
+							on_path |= edge.get_to_index() == i && (long long)expected[parent] + edge.get_weight() == (long long)expected[i];
+						}
+						CHECK(on_path);
+					}
+				}
+			}
+		}
+		//The lazy range yields the reached nodes once each, by ascending distance
+		std::vector<WEIGHT_TYPE> ranged(graph.getAmountNodes(), graph_library::unreachable_distance<WEIGHT_TYPE>());
+		WEIGHT_TYPE previous = 0;
+		for (auto step : graph_library::bestFirstRange(graph, 0)) {
+			CHECK(ranged[step.node] == graph_library::unreachable_distance<WEIGHT_TYPE>());
+			CHECK(step.distance >= previous);
+			ranged[step.node] = step.distance;
+			previous = step.distance;
+		}
+		CHECK(ranged == expected);
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 200; ++trial) {
+			size_t amount_nodes = 1 + rng() % 30;
+			DirectedGraph<int> graph(amount_nodes);
+			size_t amount_edges = rng() % (4 * amount_nodes);
+			for (size_t i = 0; i < amount_edges; ++i) {
+				graph.addEdge(rng() % amount_nodes, rng() % amount_nodes, static_cast<int>(rng() % 5));
+			}
+			//Bucket widths below 1 are rounded up for integer weights
+			check_methods(graph, trial % 2 == 0 ? 0.25 : 0.0);
+		}
+	}
+
+	//Sums over the largest weight saturate instead of overflowing
+	void test_large_weights() {
+		constexpr int MAX = std::numeric_limits<int>::max();
+		DirectedGraph<int> graph(4);
+		graph.addEdge(0, 1, MAX - 10);
+		graph.addEdge(1, 2, 20);
+		graph.addEdge(0, 3, MAX - 1);
+		graph.addEdge(3, 2, 1);
+		check_methods(graph, 0.0);
+		auto result = graph_library::dijkstra(graph, 0);
+		CHECK(result.distance[2] == graph_library::unreachable_distance<int>());
+		CHECK(result.parent[2] == graph_library::NO_NODE);
+
+		graph_library::BidirectionalWorkspace<int> workspace;
+		CHECK(graph_library::bidirectionalDijkstra(graph, graph.freeze().transposed(), 0, 2, workspace) == graph_library::unreachable_distance<int>());
+		CHECK(graph_library::bidirectionalDijkstra(graph, graph.freeze().transposed(), 0, 3, workspace) == MAX - 1);
+	}
+
+	//A negative weight throws before the search, or when it is reached without check_weights, and the workspace holds no results
+	void test_negative_weights() {
+		DirectedGraph<int> graph(3);
+		graph.addEdge(0, 1, 2);
+		graph.addEdge(1, 2, -1);
+		for (bool check_weights : { true, false }) {
+			for (auto method : { ShortestPathMethod::BINARY_HEAP, ShortestPathMethod::RADIX_HEAP, ShortestPathMethod::DELTA_STEPPING }) {
+				//The workspace holds the results of an earlier query
+				DirectedGraph<int> valid(3);
+				valid.addEdge(0, 1, 2);
+				graph_library::ShortestPathWorkspace<int> workspace;
+				graph_library::dijkstra(valid, 0, workspace);
+				graph_library::ShortestPathOptions options;
+				options.method = method;
+				options.check_weights = check_weights;
+				bool thrown = false;
+				try {
+					graph_library::dijkstra(graph, 0, workspace, options);
+				}
+				catch (const graph_library::GraphException&) {
+					thrown = true;
+				}
+				CHECK(thrown);
+				CHECK(workspace.reachedNodes().empty());
+				CHECK(workspace.getSource() == graph_library::NO_NODE);
+				CHECK(!workspace.reached(0) && !workspace.reached(1) && !workspace.reached(2));
+			}
+		}
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(7);
+	test_random(rng);
+	test_large_weights();
+	test_negative_weights();
+	return graph_library::test::result();
+}
@@ -0,0 +1,32 @@
+#pragma once
+//Minimal test support: CHECK reports a failed condition with its location and the test goes on,
+//main returns graph_library::test::result() so that ctest sees the failures
+#include <cstdio>
+#include <cstddef>
+
+namespace graph_library::test {
+
+	inline size_t& failures() {
+		static size_t amount = 0;
+		return amount;
+	}
+
+	inline bool check(bool condition, const char* expression, const char* file, int line) {
+		if (!condition) {
+			++failures();
+			std::printf("%s:%d: check failed: %s\n", file, line, expression);
+		}
+		return condition;
+	}
+
+	inline int result() {
+		if (failures() != 0) {
+			std::printf("%zu checks failed\n", failures());
+			return 1;
+		}
+		std::printf("all checks passed\n");
+		return 0;
+	}
+}
+
+#define CHECK(condition) graph_library::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,152 @@
+//bfsRange and dfsRange against bfs on random directed and undirected graphs: depths, every node once,
+//max_depth, and loops left early or several ranges iterated in turns
+#include "graph_core/graph.hpp"
+#include "graph_algorithms/bfs.hpp"
+#include "graph_algorithms/traversal_ranges.hpp"
+#include "test_support.hpp"
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+	using graph_library::BFS_UNREACHED;
+
+	template <typename GRAPH>
+	bool has_edge(const GRAPH& graph, size_t from, size_t to) {
+		for (const auto& edge : graph.outEdges(from)) {
+			if (edge.get_to_index() == to) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename GRAPH>
+	void check_bfs_range(const GRAPH& graph, size_t source, size_t max_depth) {
+		auto expected = graph_library::bfs(graph, source).distance;
+		graph_library::TraversalOptions options;
+		options.max_depth = max_depth;
+		std::vector<size_t> depth(graph.getAmountNodes(), BFS_UNREACHED);
+		size_t produced = 0;
+		size_t previous = 0;
+		bool once = true;
+		bool ascending = true;
+		for (auto [node, node_depth] : graph_library::bfsRange(graph, source, options)) {
+			once &= depth[node] == BFS_UNREACHED;
+			ascending &= node_depth >= previous;
+			depth[node] = node_depth;
+			previous = node_depth;
+			++produced;
+		}
+		CHECK(once);
+		CHECK(ascending);
+		size_t within = 0;
+		bool depths_match = true;
+		for (size_t i = 0; i < graph.getAmountNodes(); ++i) {
+			bool in_range = expected[i] != BFS_UNREACHED && expected[i] <= max_depth;
+			within += in_range ? 1 : 0;
+			depths_match &= depth[i] == (in_range ? expected[i] : BFS_UNREACHED);
+		}
+		CHECK(depths_match);
+		CHECK(produced == within);
+	}
+
+	template <typename GRAPH>
+	void check_dfs_range(const GRAPH& graph, size_t source, size_t max_depth) {
+		auto expected = graph_library::bfs(graph, source).distance;
+		graph_library::TraversalOptions options;
+		options.max_depth = max_depth;
+		std::vector<size_t> depth(graph.getAmountNodes(), BFS_UNREACHED);
+		//Nodes on the path from the source to the last produced node, by depth
+		std::vector<size_t> path;
+		size_t produced = 0;
+		bool once = true;
+		bool on_path = true;
+		for (auto [node, node_depth] : graph_library::dfsRange(graph, source, options)) {
+			once &= depth[node] == BFS_UNREACHED;
+			depth[node] = node_depth;
+			++produced;
+			//Pre-order: the parent is the node at the previous depth of the current path
+			if (node_depth > path.size() || node_depth > max_depth || node_depth < expected[node]) {
+				on_path = false;
+				continue;
+			}
+			path.resize(node_depth);
+			on_path &= node_depth == 0 ? node == source : has_edge(graph, path.back(), node);
+			path.push_back(node);
+		}
+		CHECK(once);
+		CHECK(on_path);
+		//Without a limit every reachable node is produced
+		if (max_depth == std::numeric_limits<size_t>::max()) {
+			size_t reachable = 0;
+			for (size_t distance : expected) {
+				reachable += distance != BFS_UNREACHED ? 1 : 0;
+			}
+			CHECK(produced == reachable);
+		}
+	}
+
+	void test_random(std::mt19937_64& rng) {
+		for (size_t trial = 0; trial < 200; ++trial) {
+			size_t amount_nodes = 1 + rng() % 300;
+			size_t amount_edges = rng() % (amount_nodes * 3);
+			Graph<int> undirected(amount_nodes);
+			DirectedGraph<int> directed(amount_nodes);
+			for (size_t i = 0; i < amount_edges; ++i) {
+				size_t from = rng() % amount_nodes;
+				size_t to = rng() % amount_nodes;
+				undirected.addEdge(from, to, 1);
+				directed.addEdge(from, to, 1);
+			}
+			size_t source = rng() % amount_nodes;
+			for (size_t max_depth : { std::numeric_limits<size_t>::max(), size_t(0), size_t(1), size_t(rng() % 6) }) {
+				check_bfs_range(undirected, source, max_depth);
+				check_bfs_range(directed.freeze(), source, max_depth);
+				check_dfs_range(undirected, source, max_depth);
+				check_dfs_range(directed, source, max_depth);
+			}
+		}
+	}
+
+	//Leaving a loop destroys the suspended search with its state, ranges in turns do not share state
+	void test_early_exit() {
+		Graph<int> graph(1000);
+		for (size_t i = 0; i + 1 < 1000; ++i) {
+			graph.addEdge(i, i + 1, 1);
+		}
+		size_t found = BFS_UNREACHED;
+		for (auto [node, depth] : graph_library::bfsRange(graph, 0)) {
+			if (node == 20) {
+				found = depth;
+				break;
+			}
+		}
+		CHECK(found == 20);
+		for (auto step : graph_library::dfsRange(graph, 500)) {
+			if (step.depth == 3) {
+				found = step.node;
+				break;
+			}
+		}
+		CHECK(found == 503 || found == 497);
+
+		auto forward = graph_library::bfsRange(graph, 0);
+		auto backward = graph_library::dfsRange(graph, 999);
+		auto first = forward.begin();
+		auto second = backward.begin();
+		bool in_turns = true;
+		for (size_t k = 0; k < 100; ++k, ++first, ++second) {
+			in_turns &= (*first).node == k && (*second).node == 999 - k;
+		}
+		CHECK(in_turns);
+	}
+}
+
+int main() {
+	std::mt19937_64 rng(24);
+	test_random(rng);
+	test_early_exit();
+	return graph_library::test::result();
+}